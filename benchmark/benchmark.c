@@ -1,4 +1,5 @@
 #include "ublink.h"
+#include "gen_benchmark.h"
 
 #include <stdlib.h>
 #include <sys/time.h>
@@ -6,6 +7,7 @@
 
 #include <malloc.h>
 #include <string.h>
+#include <stdio.h>
 
 double get_time()
 {
@@ -21,6 +23,502 @@ struct blink_allocator alloc = {
     .calloc = calloc
 };
 
+/* create a schema with `numberOfGroups` groups, each with a unique ID */
+static blink_schema_t newWideSchema(unsigned numberOfGroups)
+{
+    struct blink_stream stream;
+    size_t max = (numberOfGroups * 40U) + 1U;
+    char *syntax = malloc(max);
+    size_t pos = 0U;
+    unsigned i;
+    blink_schema_t retval;
+
+    for(i=0U; i < numberOfGroups; i++){
+
+        pos += (size_t)snprintf(&syntax[pos], max - pos, "Group%05u/%u -> u32 Field\n", i, i + 1U);
+    }
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, syntax, (uint32_t)pos);
+    retval = BLINK_Schema_new(&alloc, &stream);
+
+    free(syntax);
+
+    return retval;
+}
+
+static void benchmarkGetGroupByID(void)
+{
+    static const unsigned sizes[] = {10U, 100U, 1000U, 10000U};
+    size_t s;
+    int i;
+
+    for(s=0U; s < (sizeof(sizes)/sizeof(*sizes)); s++){
+
+        blink_schema_t schema = newWideSchema(sizes[s]);
+
+        if(schema != NULL){
+
+            double start = get_time();
+
+            for(i=0; i < REPEATS; i++){
+
+                (void)BLINK_Schema_getGroupByID(schema, ((uint64_t)i * 7919U) % sizes[s] + 1U);
+            }
+
+            double end = get_time();
+
+            printf("get group by ID (%u groups): %g seconds\n", sizes[s], end-start);
+        }
+    }
+}
+
+/* measure VLC encode/decode cost for each encoded size */
+static void benchmarkVLC(void)
+{
+    static const uint64_t values[] = {
+        0x7fU,
+        0x3fffU,
+        0xffffU,
+        0xffffffU,
+        0xffffffffU,
+        0xffffffffffU,
+        0xffffffffffffU,
+        0xffffffffffffffU,
+        0xffffffffffffffffU
+    };
+    uint8_t buf[9U * 64U];
+    struct blink_stream stream;
+    size_t v;
+    int i;
+    int j;
+
+    for(v=0U; v < (sizeof(values)/sizeof(*values)); v++){
+
+        uint64_t out;
+        bool isNull;
+        volatile uint64_t sink = 0U;
+
+        double start = get_time();
+
+        for(i=0; i < (REPEATS/64); i++){
+
+            (void)BLINK_Stream_initBuffer(&stream, buf, sizeof(buf));
+
+            for(j=0; j < 64; j++){
+
+                (void)BLINK_Compact_encodeU64(values[v], &stream);
+            }
+        }
+
+        double encoded = get_time();
+
+        for(i=0; i < (REPEATS/64); i++){
+
+            (void)BLINK_Stream_initBufferReadOnly(&stream, buf, sizeof(buf));
+
+            for(j=0; j < 64; j++){
+
+                (void)BLINK_Compact_decodeU64(&stream, &out, &isNull);
+                sink += out;
+            }
+        }
+
+        double decoded = get_time();
+
+        printf("VLC (%u bytes): encode %g ns/value, decode %g ns/value\n",
+            (unsigned)BLINK_Compact_sizeofUnsigned(values[v]),
+            (encoded - start) * 1e9 / (double)((REPEATS/64)*64),
+            (decoded - encoded) * 1e9 / (double)((REPEATS/64)*64)
+        );
+    }
+}
+
+/* decode a sequence of `n` small integers element by element and in a batch */
+static void benchmarkDecodeSequence(uint32_t n)
+{
+    const char syntax[] = "Book/1 -> u32 [] Levels\n";
+    uint8_t *buf = malloc((size_t)n + 16U);
+    uint64_t *values = malloc((size_t)n * sizeof(uint64_t));
+    struct blink_stream stream;
+    blink_schema_t schema;
+    blink_object_t obj;
+    bool isNull;
+    uint32_t i;
+    uint32_t j;
+    int repeats = (int)(REPEATS / n) + 1;
+    int k;
+
+    /* message preamble, ID, sequence length, then n single byte values */
+    (void)BLINK_Stream_initBuffer(&stream, buf, n + 16U);
+    (void)BLINK_Compact_encodeU32(1U + BLINK_Compact_sizeofUnsigned(n) + n, &stream);
+    (void)BLINK_Compact_encodeU32(1U, &stream);
+    (void)BLINK_Compact_encodeU32(n, &stream);
+    uint64_t header = BLINK_Stream_tell(&stream);
+
+    for(i=0U; i < n; i++){
+
+        (void)BLINK_Compact_encodeU32(i % 100U, &stream);
+    }
+
+    uint64_t size = BLINK_Stream_tell(&stream);
+
+    double start = get_time();
+
+    for(k=0; k < repeats; k++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, &buf[header], size - header);
+
+        for(j=0U; j < n; j++){
+
+            (void)BLINK_Compact_decodeU64(&stream, &values[j], &isNull);
+        }
+    }
+
+    double end = get_time();
+
+    printf("decode %u integers (one at a time): %g seconds\n", n, end-start);
+
+    start = get_time();
+
+    for(k=0; k < repeats; k++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, &buf[header], size - header);
+        (void)BLINK_Compact_decodeU64Array(&stream, values, n);
+    }
+
+    end = get_time();
+
+    printf("decode %u integers (batch): %g seconds\n", n, end-start);
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, syntax, sizeof(syntax));
+    schema = BLINK_Schema_new(&alloc, &stream);
+    obj = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName(schema, "Book"));
+
+    start = get_time();
+
+    for(k=0; k < repeats; k++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, buf, size);
+        (void)BLINK_Object_decodeCompactInto(&stream, schema, obj, NULL);
+    }
+
+    end = get_time();
+
+    printf("decode group with %u element sequence (into existing): %g seconds\n", n, end-start);
+
+    free(buf);
+    free(values);
+}
+
+/* encode a message made of `depth` nested dynamic groups */
+/* build and encode a message with an `n` element sequence */
+static void benchmarkEncodeSequence(uint32_t n)
+{
+    const char syntax[] = "Snapshot/1 -> u32 [] Prices\n";
+    size_t max = ((size_t)n * 5U) + 16U;
+    uint8_t *outbuf = malloc(max);
+    uint64_t *values = malloc((size_t)n * sizeof(uint64_t));
+    struct blink_stream stream;
+    blink_schema_t schema;
+    blink_object_t obj;
+    int repeats = (int)(REPEATS / n) + 1;
+    uint32_t j;
+    int k;
+
+    for(j=0U; j < n; j++){
+
+        values[j] = (j * 7919U) % 100000U;
+    }
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, syntax, sizeof(syntax));
+    schema = BLINK_Schema_new(&alloc, &stream);
+
+    blink_schema_t group = BLINK_Schema_getGroupByName(schema, "Snapshot");
+    blink_schema_t prices = BLINK_Group_getFieldByName(group, "Prices");
+
+    obj = BLINK_Object_newGroup(&alloc, group);
+
+    double start = get_time();
+
+    for(k=0; k < repeats; k++){
+
+        BLINK_Object_clearSequenceByField(obj, prices);
+
+        for(j=0U; j < n; j++){
+
+            BLINK_Object_appendUintByField(obj, prices, values[j]);
+        }
+
+        (void)BLINK_Stream_initBuffer(&stream, outbuf, max);
+        BLINK_Object_encodeCompact(obj, &stream);
+    }
+
+    double end = get_time();
+
+    printf("append and encode (%u element sequence): %g ns/element\n", n, (end-start) * 1e9 / ((double)repeats * n));
+
+    start = get_time();
+
+    for(k=0; k < repeats; k++){
+
+        BLINK_Object_clearSequenceByField(obj, prices);
+        BLINK_Object_appendUintsByField(obj, prices, values, n);
+
+        (void)BLINK_Stream_initBuffer(&stream, outbuf, max);
+        BLINK_Object_encodeCompact(obj, &stream);
+    }
+
+    end = get_time();
+
+    printf("bulk append and encode (%u element sequence): %g ns/element\n", n, (end-start) * 1e9 / ((double)repeats * n));
+
+    start = get_time();
+
+    for(k=0; k < repeats; k++){
+
+        (void)BLINK_Stream_initBuffer(&stream, outbuf, max);
+        BLINK_Object_encodeCompact(obj, &stream);
+    }
+
+    end = get_time();
+
+    printf("encode (%u element sequence): %g ns/element\n", n, (end-start) * 1e9 / ((double)repeats * n));
+
+    free(outbuf);
+    free(values);
+}
+
+/* user stream over a buffer: cannot be reserved so forces the two-pass encoder */
+struct sink {
+    uint8_t *buf;
+    size_t size;
+    size_t pos;
+};
+
+static bool sinkWrite(void *state, const void *in, size_t bytesToWrite)
+{
+    struct sink *self = (struct sink *)state;
+    bool retval = false;
+
+    if((self->size - self->pos) >= bytesToWrite){
+
+        (void)memcpy(&self->buf[self->pos], in, bytesToWrite);
+        self->pos += bytesToWrite;
+        retval = true;
+    }
+
+    return retval;
+}
+
+static uint64_t sinkTell(void *state)
+{
+    return ((const struct sink *)state)->pos;
+}
+
+/* innermost group carries a `noteLen` byte string so that groups larger
+ * than 127 bytes take the back-patch path that shifts the body */
+static void benchmarkEncodeNested(unsigned depth, unsigned noteLen)
+{
+    uint8_t outbuf[1000U];
+    char note[200U];
+    struct blink_stream stream;
+    struct sink sink;
+    const struct blink_stream_user fn = {
+        .write = sinkWrite,
+        .tell = sinkTell
+    };
+    const char syntax[] =
+    "Fill/2 ->\n"
+            "string Venue,   # set to 'XLON'\n"
+            "u32 Qty,        # set to 1000\n"
+            "string Note?,   # set on innermost group only\n"
+            "Fill* Next?\n";
+    blink_schema_t schema;
+    blink_object_t top = NULL;
+    unsigned d;
+    int i;
+
+    (void)memset(note, 'x', sizeof(note));
+    noteLen = (noteLen < sizeof(note)) ? noteLen : (unsigned)sizeof(note);
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, syntax, sizeof(syntax));
+    schema = BLINK_Schema_new(&alloc, &stream);
+
+    blink_schema_t group = BLINK_Schema_getGroupByName(schema, "Fill");
+    blink_schema_t venue = BLINK_Group_getFieldByName(group, "Venue");
+    blink_schema_t qty = BLINK_Group_getFieldByName(group, "Qty");
+    blink_schema_t text = BLINK_Group_getFieldByName(group, "Note");
+    blink_schema_t next = BLINK_Group_getFieldByName(group, "Next");
+
+    for(d=0U; d < depth; d++){
+
+        blink_object_t obj = BLINK_Object_newGroup(&alloc, group);
+
+        BLINK_Object_setStringByField(obj, venue, "XLON", 4U);
+        BLINK_Object_setUintByField(obj, qty, 1000U);
+
+        if(top != NULL){
+
+            BLINK_Object_setGroupByField(obj, next, top);
+        }
+        else if(noteLen > 0U){
+
+            BLINK_Object_setStringByField(obj, text, note, noteLen);
+        }
+
+        top = obj;
+    }
+
+    (void)BLINK_Stream_initBuffer(&stream, outbuf, sizeof(outbuf));
+    (void)BLINK_Object_encodeCompact(top, &stream);
+
+    uint64_t size = BLINK_Stream_tell(&stream);
+
+    double start = get_time();
+
+    for(i=0; i < REPEATS; i++){
+
+        (void)BLINK_Stream_initBuffer(&stream, outbuf, sizeof(outbuf));
+        BLINK_Object_encodeCompact(top, &stream);
+    }
+
+    double end = get_time();
+
+    printf("encode (nesting depth %u, %u bytes): %g seconds\n", depth, (unsigned)size, end-start);
+
+    /* baseline: sizes every group with cacheSize() before encoding (includes the cost of calling through the user stream) */
+    start = get_time();
+
+    for(i=0; i < REPEATS; i++){
+
+        sink.buf = outbuf;
+        sink.size = sizeof(outbuf);
+        sink.pos = 0U;
+
+        (void)BLINK_Stream_initUser(&stream, &sink, fn);
+        BLINK_Object_encodeCompact(top, &stream);
+    }
+
+    end = get_time();
+
+    printf("encode two-pass (nesting depth %u, %u bytes): %g seconds\n", depth, (unsigned)size, end-start);
+}
+
+/* read one field of a wide message by full decode and by view */
+static void benchmarkView(unsigned numberOfFields)
+{
+    size_t max = (numberOfFields * 24U) + 64U;
+    char *syntax = malloc(max);
+    uint8_t buf[2048U];
+    struct blink_stream stream;
+    struct blink_view view;
+    blink_schema_t schema;
+    blink_schema_t group;
+    blink_schema_t symbol;
+    blink_schema_t last;
+    blink_object_t obj;
+    const struct blink_field_desc *desc;
+    const char *str;
+    const uint8_t *data;
+    uint32_t len;
+    uint64_t value;
+    bool isNull;
+    size_t pos;
+    unsigned i;
+    int k;
+
+    /* every fourth field is a string */
+    pos = (size_t)snprintf(syntax, max, "Wide/1 -> string Symbol, i8 Side");
+
+    for(i=2U; i < numberOfFields; i++){
+
+        pos += (size_t)snprintf(&syntax[pos], max - pos, ((i % 4U) == 0U) ? ", string Text%u" : ", u64 Value%u", i);
+    }
+
+    schema = BLINK_Schema_new(&alloc, BLINK_Stream_initBufferReadOnly(&stream, syntax, (uint32_t)pos));
+    group = BLINK_Schema_getGroupByName(schema, "Wide");
+    desc = BLINK_Group_getFieldDescs(group);
+    symbol = BLINK_Group_getFieldByName(group, "Symbol");
+    last = desc[numberOfFields - 1U].field;
+
+    obj = BLINK_Object_newGroup(&alloc, group);
+
+    (void)BLINK_Object_setString2(obj, "Symbol", "IBM");
+    (void)BLINK_Object_setInt(obj, "Side", 1);
+
+    for(i=2U; i < numberOfFields; i++){
+
+        if(desc[i].type == BLINK_TYPE_STRING){
+
+            (void)BLINK_Object_setStringByField(obj, desc[i].field, "some text", 9U);
+        }
+        else{
+
+            (void)BLINK_Object_setUintByField(obj, desc[i].field, (uint64_t)i << 40);
+        }
+    }
+
+    (void)BLINK_Object_encodeCompact(obj, BLINK_Stream_initBuffer(&stream, buf, sizeof(buf)));
+
+    uint32_t size = (uint32_t)BLINK_Stream_tell(&stream);
+
+    double start = get_time();
+
+    for(k=0; k < REPEATS; k++){
+
+        (void)BLINK_Object_decodeCompactInto(BLINK_Stream_initBufferReadOnly(&stream, buf, size), schema, obj, NULL);
+        BLINK_Object_getStringByField(obj, symbol, &str, &len);
+    }
+
+    double end = get_time();
+
+    printf("decode %u field group (into existing) and read first field: %g seconds\n", numberOfFields, end-start);
+
+    struct blink_field_mask mask;
+    struct blink_decode_options options = {.mask = &mask};
+
+    (void)BLINK_Object_initMask(&mask, group);
+    (void)BLINK_Object_maskSelectByField(&mask, symbol);
+
+    start = get_time();
+
+    for(k=0; k < REPEATS; k++){
+
+        (void)BLINK_Object_decodeCompactInto(BLINK_Stream_initBufferReadOnly(&stream, buf, size), schema, obj, &options);
+        BLINK_Object_getStringByField(obj, symbol, &str, &len);
+    }
+
+    end = get_time();
+
+    printf("decode %u field group (into existing, first field selected) and read first field: %g seconds\n", numberOfFields, end-start);
+
+    start = get_time();
+
+    for(k=0; k < REPEATS; k++){
+
+        (void)BLINK_View_init(&view, schema, buf, size);
+        (void)BLINK_View_getStringByField(&view, symbol, &data, &len, &isNull);
+    }
+
+    end = get_time();
+
+    printf("view %u field group and read first field: %g seconds\n", numberOfFields, end-start);
+
+    start = get_time();
+
+    for(k=0; k < REPEATS; k++){
+
+        (void)BLINK_View_init(&view, schema, buf, size);
+        (void)BLINK_View_getUintByField(&view, last, &value, &isNull);
+    }
+
+    end = get_time();
+
+    printf("view %u field group and read last field: %g seconds\n", numberOfFields, end-start);
+
+    free(syntax);
+}
+
 int main(int argc, const char **argv)
 {
     uint8_t outbuf[100U];
@@ -68,7 +566,7 @@ int main(int argc, const char **argv)
 
     
 
-    /* init and encode */
+    /* init (by name) and encode */
     for(i=0; i < REPEATS; i++){
 
         (void)BLINK_Stream_initBuffer(&stream, outbuf, sizeof(outbuf));
@@ -83,7 +581,54 @@ int main(int argc, const char **argv)
 
     end = get_time();
 
-    printf("init and encode: %g seconds\n", end-start);
+    printf("init (by name) and encode: %g seconds\n", end-start);
+
+    blink_schema_t group = BLINK_Schema_getGroupByName(schema, "InsertOrder");
+    blink_schema_t symbol = BLINK_Group_getFieldByName(group, "Symbol");
+    blink_schema_t orderId = BLINK_Group_getFieldByName(group, "OrderId");
+    blink_schema_t price = BLINK_Group_getFieldByName(group, "Price");
+    blink_schema_t quantity = BLINK_Group_getFieldByName(group, "Quantity");
+
+    start = get_time();
+
+    /* init (by field) and encode */
+    for(i=0; i < REPEATS; i++){
+
+        (void)BLINK_Stream_initBuffer(&stream, outbuf, sizeof(outbuf));
+
+        BLINK_Object_setStringByField(obj, symbol, "IBM", 3U);
+        BLINK_Object_setStringByField(obj, orderId, "ABC123", 6U);
+        BLINK_Object_setUintByField(obj, price, 125U);
+        BLINK_Object_setUintByField(obj, quantity, 1000U);
+
+        BLINK_Object_encodeCompact(obj, &stream);
+    }
+
+    end = get_time();
+
+    printf("init (by field) and encode: %g seconds\n", end-start);
+
+    start = get_time();
+
+    /* encode */
+    for(i=0; i < REPEATS; i++){
+
+        (void)BLINK_Stream_initBuffer(&stream, outbuf, sizeof(outbuf));
+
+        BLINK_Object_encodeCompact(obj, &stream);
+    }
+
+    end = get_time();
+
+    printf("encode: %g seconds\n", end-start);
+
+    benchmarkEncodeNested(1U, 0U);
+    benchmarkEncodeNested(8U, 0U);
+    benchmarkEncodeNested(1U, 150U);
+    benchmarkEncodeNested(8U, 150U);
+    benchmarkEncodeSequence(10U);
+    benchmarkEncodeSequence(1000U);
+    benchmarkEncodeSequence(100000U);
 
 
     start = get_time();
@@ -99,6 +644,144 @@ int main(int argc, const char **argv)
 
     printf("decode: %g seconds \n", end-start);
 
+    const struct blink_decode_options zeroCopy = {.zeroCopy = true};
+
+    start = get_time();
+
+    for(i=0; i < REPEATS; i++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, compact_form, sizeof(compact_form));
+
+        obj = BLINK_Object_decodeCompactWithOptions(&stream, schema, &alloc, &zeroCopy);
+    }
+
+    end = get_time();
+
+    printf("decode (zero copy): %g seconds \n", end-start);
+
+    struct blink_arena arena;
+    struct blink_allocator arenaAlloc = BLINK_Arena_getAllocator(BLINK_Arena_init(&arena, NULL, 0U, &alloc));
+
+    start = get_time();
+
+    for(i=0; i < REPEATS; i++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, compact_form, sizeof(compact_form));
+
+        obj = BLINK_Object_decodeCompact(&stream, schema, &arenaAlloc);
+        BLINK_Arena_reset(&arena);
+    }
+
+    end = get_time();
+
+    printf("decode (arena): %g seconds \n", end-start);
+
+    static uint64_t scratch[512U];
+    size_t scratchSize;
+
+    if(!BLINK_Object_sizeofDecodeCompact(compact_form, sizeof(compact_form), schema, NULL, &scratchSize) || (scratchSize > sizeof(scratch))){
+
+        fprintf(stderr, "scratch buffer is too small\n");
+        exit(EXIT_FAILURE);
+    }
+
+    start = get_time();
+
+    for(i=0; i < REPEATS; i++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, compact_form, sizeof(compact_form));
+
+        obj = BLINK_Object_decodeCompactInBuffer(&stream, schema, scratch, scratchSize, NULL);
+    }
+
+    end = get_time();
+
+    printf("decode (caller buffer, %u bytes): %g seconds \n", (unsigned)scratchSize, end-start);
+
+    struct blink_allocator heap = {.calloc = calloc, .free = free};
+
+    start = get_time();
+
+    for(i=0; i < REPEATS; i++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, compact_form, sizeof(compact_form));
+
+        obj = BLINK_Object_decodeCompact(&stream, schema, &heap);
+        BLINK_Object_destroyGroup(&obj);
+    }
+
+    end = get_time();
+
+    printf("decode and destroy (calloc/free): %g seconds \n", end-start);
+
+    struct blink_slab slab;
+    struct blink_allocator slabAlloc = BLINK_Slab_getAllocator(BLINK_Slab_init(&slab, &heap));
+
+    start = get_time();
+
+    for(i=0; i < REPEATS; i++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, compact_form, sizeof(compact_form));
+
+        obj = BLINK_Object_decodeCompact(&stream, schema, &slabAlloc);
+        BLINK_Object_destroyGroup(&obj);
+    }
+
+    end = get_time();
+
+    printf("decode and destroy (slab): %g seconds \n", end-start);
+
+    BLINK_Slab_destroy(&slab);
+
+    obj = BLINK_Object_newGroup(&alloc, group);
+
+    start = get_time();
+
+    for(i=0; i < REPEATS; i++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, compact_form, sizeof(compact_form));
+
+        (void)BLINK_Object_decodeCompactInto(&stream, schema, obj, NULL);
+    }
+
+    end = get_time();
+
+    printf("decode (into existing): %g seconds \n", end-start);
+
+    struct InsertOrder order;
+
+    start = get_time();
+
+    for(i=0; i < REPEATS; i++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, compact_form, sizeof(compact_form));
+
+        (void)InsertOrder_decodeCompact(&stream, &order, NULL);
+    }
+
+    end = get_time();
+
+    printf("decode (generated): %g seconds \n", end-start);
+
+    start = get_time();
+
+    for(i=0; i < REPEATS; i++){
+
+        (void)BLINK_Stream_initBuffer(&stream, outbuf, sizeof(outbuf));
+
+        (void)InsertOrder_encodeCompact(&order, &stream);
+    }
+
+    end = get_time();
+
+    printf("encode (generated): %g seconds \n", end-start);
+
+    benchmarkGetGroupByID();
+
+    benchmarkVLC();
+    benchmarkDecodeSequence(1000U);
+    benchmarkView(40U);
+
 
     exit(EXIT_SUCCESS);    
 }
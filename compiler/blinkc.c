@@ -0,0 +1,1590 @@
+/* Copyright (c) 2016 Cameron Harper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * */
+
+/**
+ * @file blinkc.c
+ *
+ * Schema compiler
+ *
+ * Reads a schema with BLINK_Schema_new() and writes a C header and source
+ * file containing a struct for every group plus straight-line compact
+ * form encode/decode functions for every group that has an ID.
+ *
+ * Usage:
+ *
+ * @code
+ * blinkc [-p prefix] -o <output> <schema>
+ * @endcode
+ *
+ * Writes `<output>.h` and `<output>.c`. Generated types are named
+ * `<prefix><namespace>_<group>` (the namespace part is omitted for the
+ * default namespace). The functions that decode and encode any group by
+ * ID are named after the last path component of `<output>`.
+ *
+ * Generated code depends on blink_stream and blink_compact but not on
+ * blink_schema or blink_object.
+ *
+ * */
+
+/* includes ***********************************************************/
+
+#include "blink_schema.h"
+#include "blink_schema_internal.h"
+#include "blink_stream.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/* defines ************************************************************/
+
+#define NAME_MAX_SIZE 256U
+#define TYPE_MAX_SIZE (NAME_MAX_SIZE + 8U)
+
+/* types **************************************************************/
+
+struct group_info {
+    blink_schema_t group;
+    char name[NAME_MAX_SIZE];       /**< generated type name */
+    bool needed;                    /**< codec functions are generated for this group */
+    bool kindOf;                    /**< isKindOf function is generated for this group */
+    uint8_t mark;                   /**< visit state while ordering struct definitions */
+};
+
+struct generator {
+    FILE *h;
+    FILE *c;
+    const char *prefix;
+    char base[NAME_MAX_SIZE];       /**< name of the dispatch functions */
+    char guard[NAME_MAX_SIZE];      /**< header include guard */
+    char header[NAME_MAX_SIZE];     /**< header file name (as included from the source file) */
+    blink_schema_t schema;
+    struct group_info *groups;
+    size_t numberOfGroups;
+    bool useBytes;                  /**< readBytes() is required */
+    bool useSequence;               /**< allocElems() is required */
+    bool useF64;                    /**< sizeofF64() is required */
+    bool useDynamic;                /**< sizeofDynamicField() is required */
+};
+
+/* static function prototypes *****************************************/
+
+static char *readFile(const char *fileName, size_t *size);
+static bool initGroups(struct generator *self);
+static struct group_info *lookupGroup(struct generator *self, blink_schema_t group);
+static void markNeeded(struct generator *self, struct group_info *info);
+static void makeName(char *out, const char *prefix, const char *ns, const char *name);
+static void makeIdentifier(char *out, const char *path, bool upper);
+
+static bool writeHeader(struct generator *self, const char *schemaFile);
+static void writeEnums(struct generator *self);
+static bool writeStruct(struct generator *self, struct group_info *info);
+static void writeMember(struct generator *self, const struct blink_field_desc *desc);
+static void elementType(struct generator *self, const struct blink_field_desc *desc, char *ctype, char *suffix);
+
+static void writeSource(struct generator *self, const char *schemaFile);
+static void writeHelpers(struct generator *self);
+static void writeDynamic(struct generator *self);
+static void writeKindOf(struct generator *self, struct group_info *info);
+static void writeDecode(struct generator *self, struct group_info *info);
+static void writeDecodeValue(struct generator *self, const struct blink_field_desc *desc, const char *lv, const char *indent);
+static void writeEncode(struct generator *self, struct group_info *info);
+static void writeEncodeValue(struct generator *self, const struct blink_field_desc *desc, const char *lv, const char *indent);
+static void writeSizeof(struct generator *self, struct group_info *info);
+static void writeSizeofValue(struct generator *self, const struct blink_field_desc *desc, const char *lv, const char *indent);
+
+static bool isNullable(enum blink_type_tag type);
+static const char *primitiveName(enum blink_type_tag type);
+static const char *primitiveType(enum blink_type_tag type);
+static bool isSigned(enum blink_type_tag type);
+
+/* functions **********************************************************/
+
+int main(int argc, char **argv)
+{
+    struct blink_allocator alloc = {.calloc = calloc, .free = free};
+    struct generator self;
+    struct blink_stream stream;
+    const char *output = NULL;
+    const char *schemaFile = NULL;
+    char path[NAME_MAX_SIZE];
+    size_t size;
+    char *syntax;
+    int retval = EXIT_FAILURE;
+    int i;
+
+    (void)memset(&self, 0, sizeof(self));
+
+    self.prefix = "";
+
+    for(i=1; i < argc; i++){
+
+        if((strcmp(argv[i], "-o") == 0) && ((i + 1) < argc)){
+
+            output = argv[++i];
+        }
+        else if((strcmp(argv[i], "-p") == 0) && ((i + 1) < argc)){
+
+            self.prefix = argv[++i];
+        }
+        else{
+
+            schemaFile = argv[i];
+        }
+    }
+
+    if((output == NULL) || (schemaFile == NULL) || ((strlen(output) + 3U) > sizeof(path))){
+
+        fprintf(stderr, "usage: blinkc [-p prefix] -o <output> <schema>\n");
+        return retval;
+    }
+
+    syntax = readFile(schemaFile, &size);
+
+    if(syntax == NULL){
+
+        fprintf(stderr, "cannot read %s\n", schemaFile);
+        return retval;
+    }
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, syntax, (uint32_t)size);
+    self.schema = BLINK_Schema_new(&alloc, &stream);
+
+    if(self.schema == NULL){
+
+        fprintf(stderr, "%s is not a valid schema\n", schemaFile);
+    }
+    else if(initGroups(&self)){
+
+        const char *file = strrchr(output, '/');
+
+        file = (file == NULL) ? output : &file[1];
+
+        (void)snprintf(self.header, sizeof(self.header), "%s.h", file);
+        makeIdentifier(self.base, file, false);
+        makeIdentifier(self.guard, file, true);
+
+        (void)snprintf(path, sizeof(path), "%s.h", output);
+        self.h = fopen(path, "w");
+
+        (void)snprintf(path, sizeof(path), "%s.c", output);
+        self.c = fopen(path, "w");
+
+        if((self.h == NULL) || (self.c == NULL)){
+
+            fprintf(stderr, "cannot open %s for writing\n", output);
+        }
+        else if(writeHeader(&self, schemaFile)){
+
+            writeSource(&self, schemaFile);
+            retval = EXIT_SUCCESS;
+        }
+        else{
+
+            /* writeHeader() reports the error */
+        }
+
+        if(self.h != NULL){
+
+            (void)fclose(self.h);
+        }
+
+        if(self.c != NULL){
+
+            (void)fclose(self.c);
+        }
+    }
+    else{
+
+        /* initGroups() reports the error */
+    }
+
+    free(syntax);
+
+    return retval;
+}
+
+/* static functions ***************************************************/
+
+static char *readFile(const char *fileName, size_t *size)
+{
+    char *retval = NULL;
+    FILE *f = fopen(fileName, "rb");
+
+    if(f != NULL){
+
+        if(fseek(f, 0, SEEK_END) == 0){
+
+            long len = ftell(f);
+
+            if((len >= 0) && (len <= (long)INT32_MAX) && (fseek(f, 0, SEEK_SET) == 0)){
+
+                retval = malloc((size_t)len + 1U);
+
+                if(retval != NULL){
+
+                    if(fread(retval, 1U, (size_t)len, f) == (size_t)len){
+
+                        *size = (size_t)len;
+                    }
+                    else{
+
+                        free(retval);
+                        retval = NULL;
+                    }
+                }
+            }
+        }
+
+        (void)fclose(f);
+    }
+
+    return retval;
+}
+
+static bool initGroups(struct generator *self)
+{
+    struct blink_group_iterator iter = BLINK_GroupIterator_init(self->schema);
+    blink_schema_t group;
+    size_t i;
+    size_t j;
+
+    while(BLINK_GroupIterator_next(&iter) != NULL){
+
+        self->numberOfGroups++;
+    }
+
+    self->groups = calloc(self->numberOfGroups + 1U, sizeof(*self->groups));
+
+    if(self->groups == NULL){
+
+        fprintf(stderr, "calloc()\n");
+        return false;
+    }
+
+    iter = BLINK_GroupIterator_init(self->schema);
+
+    for(i=0U; (group = BLINK_GroupIterator_next(&iter)) != NULL; i++){
+
+        self->groups[i].group = group;
+        makeName(self->groups[i].name, self->prefix, BLINK_Namespace_getName(BLINK_Group_getNamespace(group)), BLINK_Group_getName(group));
+    }
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        if(BLINK_Group_hasID(self->groups[i].group)){
+
+            markNeeded(self, &self->groups[i]);
+        }
+    }
+
+    /* work out which helpers the generated functions will call */
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        if(self->groups[i].needed){
+
+            const struct blink_field_desc *desc = BLINK_Group_getFieldDescs(self->groups[i].group);
+
+            for(j=0U; j < BLINK_Group_numberOfFields(self->groups[i].group); j++){
+
+                switch(desc[j].type){
+                case BLINK_TYPE_STRING:
+                case BLINK_TYPE_BINARY:
+                    self->useBytes = true;
+                    break;
+                case BLINK_TYPE_F64:
+                    self->useF64 = true;
+                    break;
+                case BLINK_TYPE_DYNAMIC_GROUP:
+                    lookupGroup(self, desc[j].ref)->kindOf = true;
+                    self->useDynamic = true;
+                    break;
+                case BLINK_TYPE_OBJECT:
+                    self->useDynamic = true;
+                    break;
+                default:
+                    break;
+                }
+
+                if(desc[j].isSequence){
+
+                    self->useSequence = true;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+static struct group_info *lookupGroup(struct generator *self, blink_schema_t group)
+{
+    size_t i;
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        if(self->groups[i].group == group){
+
+            return &self->groups[i];
+        }
+    }
+
+    /* impossible: every group is in the list */
+    return &self->groups[self->numberOfGroups];
+}
+
+/* groups with an ID and any group they include statically */
+static void markNeeded(struct generator *self, struct group_info *info)
+{
+    if(!info->needed){
+
+        const struct blink_field_desc *desc = BLINK_Group_getFieldDescs(info->group);
+        size_t i;
+
+        info->needed = true;
+
+        for(i=0U; i < BLINK_Group_numberOfFields(info->group); i++){
+
+            if(desc[i].type == BLINK_TYPE_STATIC_GROUP){
+
+                markNeeded(self, lookupGroup(self, desc[i].ref));
+            }
+        }
+    }
+}
+
+static void makeName(char *out, const char *prefix, const char *ns, const char *name)
+{
+    if((ns == NULL) || (ns[0] == '\0')){
+
+        (void)snprintf(out, NAME_MAX_SIZE, "%s%s", prefix, name);
+    }
+    else{
+
+        (void)snprintf(out, NAME_MAX_SIZE, "%s%s_%s", prefix, ns, name);
+    }
+}
+
+static void makeIdentifier(char *out, const char *path, bool upper)
+{
+    size_t i;
+
+    for(i=0U; (path[i] != '\0') && (i < (NAME_MAX_SIZE - 3U)); i++){
+
+        char c = isalnum((unsigned char)path[i]) ? path[i] : '_';
+
+        out[i] = upper ? (char)toupper((unsigned char)c) : c;
+    }
+
+    if(upper){
+
+        (void)strcpy(&out[i], "_H");
+    }
+    else{
+
+        out[i] = '\0';
+    }
+}
+
+static bool writeHeader(struct generator *self, const char *schemaFile)
+{
+    size_t i;
+
+    fprintf(self->h,
+        "/* generated by blinkc from %s (do not edit) */\n"
+        "\n"
+        "#ifndef %s\n"
+        "#define %s\n"
+        "\n"
+        "#ifdef __cplusplus\n"
+        "extern \"C\" {\n"
+        "#endif\n"
+        "\n"
+        "/* includes ***********************************************************/\n"
+        "\n"
+        "#include <stdint.h>\n"
+        "#include <stdbool.h>\n"
+        "\n"
+        "#include \"blink_alloc.h\"\n"
+        "#include \"blink_stream.h\"\n"
+        "\n"
+        "/* types **************************************************************/\n"
+        "\n"
+        "#ifndef BLINK_GEN_TYPES\n"
+        "#define BLINK_GEN_TYPES\n"
+        "\n"
+        "/** string or binary value */\n"
+        "struct blink_gen_bytes {\n"
+        "    const uint8_t *data;\n"
+        "    uint32_t len;\n"
+        "};\n"
+        "\n"
+        "/** decimal value */\n"
+        "struct blink_gen_decimal {\n"
+        "    int64_t mantissa;\n"
+        "    int8_t exponent;\n"
+        "};\n"
+        "\n"
+        "/** dynamic group value */\n"
+        "struct blink_gen_dynamic {\n"
+        "    uint64_t id;        /**< group ID */\n"
+        "    void *group;        /**< generated struct of the group identified by `id` */\n"
+        "};\n"
+        "\n"
+        "#endif\n"
+        "\n",
+        schemaFile, self->guard, self->guard
+    );
+
+    writeEnums(self);
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        if(!writeStruct(self, &self->groups[i])){
+
+            return false;
+        }
+    }
+
+    fprintf(self->h, "/* defines ************************************************************/\n\n");
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        if(BLINK_Group_hasID(self->groups[i].group)){
+
+            fprintf(self->h, "#define %s_ID UINT64_C(%llu)\n", self->groups[i].name, (unsigned long long)BLINK_Group_getID(self->groups[i].group));
+        }
+    }
+
+    fprintf(self->h,
+        "\n"
+        "/* function prototypes ************************************************/\n"
+        "\n"
+        "/** Decode any group that has an ID\n"
+        " *\n"
+        " * `out->group` is allocated from `alloc` and `out->id` identifies its type.\n"
+        " *\n"
+        " * @param[in] in input stream\n"
+        " * @param[out] out decoded group\n"
+        " * @param[in] alloc allocator\n"
+        " *\n"
+        " * @return true if successful\n"
+        " *\n"
+        " * */\n"
+        "bool %s_decodeCompact(blink_stream_t in, struct blink_gen_dynamic *out, const struct blink_allocator *alloc);\n"
+        "\n"
+        "/** Encode any group that has an ID\n"
+        " *\n"
+        " * @param[in] in group to encode\n"
+        " * @param[in] out output stream\n"
+        " *\n"
+        " * @return true if successful\n"
+        " *\n"
+        " * */\n"
+        "bool %s_encodeCompact(const struct blink_gen_dynamic *in, blink_stream_t out);\n"
+        "\n",
+        self->base, self->base
+    );
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        const char *name = self->groups[i].name;
+
+        if(BLINK_Group_hasID(self->groups[i].group)){
+
+            fprintf(self->h,
+                "bool %s_decodeCompact(blink_stream_t in, struct %s *out, const struct blink_allocator *alloc);\n"
+                "bool %s_encodeCompact(const struct %s *in, blink_stream_t out);\n",
+                name, name, name, name
+            );
+        }
+    }
+
+    fprintf(self->h,
+        "\n"
+        "#ifdef __cplusplus\n"
+        "}\n"
+        "#endif\n"
+        "\n"
+        "#endif\n"
+    );
+
+    return true;
+}
+
+/* enums are not reachable through the public schema API */
+static void writeEnums(struct generator *self)
+{
+    const struct blink_schema_base *base = (const struct blink_schema_base *)self->schema;
+    const struct blink_schema *ns;
+    const struct blink_schema *def;
+    const struct blink_schema *sym;
+    char name[NAME_MAX_SIZE];
+
+    for(ns = base->ns; ns != NULL; ns = ns->next){
+
+        for(def = ((const struct blink_schema_namespace *)ns)->defs; def != NULL; def = def->next){
+
+            if(def->type == BLINK_SCHEMA_ENUM){
+
+                makeName(name, self->prefix, ns->name, def->name);
+
+                fprintf(self->h, "enum %s {\n", name);
+
+                for(sym = ((const struct blink_schema_enum *)def)->s; sym != NULL; sym = sym->next){
+
+                    fprintf(self->h, "    %s_%s = %ld%s\n", name, sym->name, (long)((const struct blink_schema_symbol *)sym)->value, (sym->next != NULL) ? "," : "");
+                }
+
+                fprintf(self->h, "};\n\n");
+            }
+        }
+    }
+}
+
+/* struct definitions are written depth first so that a static group is
+ * always complete before it is embedded */
+static bool writeStruct(struct generator *self, struct group_info *info)
+{
+    const struct blink_field_desc *desc = BLINK_Group_getFieldDescs(info->group);
+    size_t n = BLINK_Group_numberOfFields(info->group);
+    size_t i;
+
+    if(info->mark == 2U){
+
+        return true;
+    }
+
+    if(info->mark == 1U){
+
+        fprintf(stderr, "group %s includes itself statically\n", BLINK_Group_getName(info->group));
+        return false;
+    }
+
+    info->mark = 1U;
+
+    for(i=0U; i < n; i++){
+
+        if(desc[i].type == BLINK_TYPE_STATIC_GROUP){
+
+            if(!writeStruct(self, lookupGroup(self, desc[i].ref))){
+
+                return false;
+            }
+        }
+    }
+
+    if(BLINK_Group_hasID(info->group)){
+
+        fprintf(self->h, "/** %s/%llu */\n", BLINK_Group_getName(info->group), (unsigned long long)BLINK_Group_getID(info->group));
+    }
+    else{
+
+        fprintf(self->h, "/** %s */\n", BLINK_Group_getName(info->group));
+    }
+
+    fprintf(self->h, "struct %s {\n", info->name);
+
+    for(i=0U; i < n; i++){
+
+        writeMember(self, &desc[i]);
+    }
+
+    if(n == 0U){
+
+        fprintf(self->h, "    uint8_t empty;      /**< group has no fields */\n");
+    }
+
+    fprintf(self->h, "};\n\n");
+
+    info->mark = 2U;
+
+    return true;
+}
+
+static void writeMember(struct generator *self, const struct blink_field_desc *desc)
+{
+    const char *name = BLINK_Field_getName(desc->field);
+    char ctype[TYPE_MAX_SIZE];
+    char suffix[TYPE_MAX_SIZE];
+
+    elementType(self, desc, ctype, suffix);
+
+    if(desc->isSequence){
+
+        fprintf(self->h,
+            "    struct {\n"
+            "        %s %s%s;\n"
+            "        uint32_t size;\n"
+            "    } %s;\n",
+            ctype, (suffix[0] == '\0') ? "*data" : "(*data)", suffix, name
+        );
+    }
+    else{
+
+        fprintf(self->h, "    %s %s%s;\n", ctype, name, suffix);
+    }
+
+    if(desc->isOptional){
+
+        fprintf(self->h, "    bool has%s;\n", name);
+    }
+}
+
+static void elementType(struct generator *self, const struct blink_field_desc *desc, char *ctype, char *suffix)
+{
+    const char *name;
+
+    suffix[0] = '\0';
+
+    switch(desc->type){
+    case BLINK_TYPE_STRING:
+    case BLINK_TYPE_BINARY:
+        name = "struct blink_gen_bytes";
+        break;
+    case BLINK_TYPE_FIXED:
+        name = "uint8_t";
+        (void)snprintf(suffix, TYPE_MAX_SIZE, "[%lu]", (unsigned long)desc->size);
+        break;
+    case BLINK_TYPE_DECIMAL:
+        name = "struct blink_gen_decimal";
+        break;
+    case BLINK_TYPE_DYNAMIC_GROUP:
+    case BLINK_TYPE_OBJECT:
+        name = "struct blink_gen_dynamic";
+        break;
+    case BLINK_TYPE_STATIC_GROUP:
+        name = lookupGroup(self, desc->ref)->name;
+        break;
+    default:
+        name = primitiveType(desc->type);
+        break;
+    }
+
+    (void)snprintf(ctype, TYPE_MAX_SIZE, (desc->type == BLINK_TYPE_STATIC_GROUP) ? "struct %s" : "%s", name);
+}
+
+static void writeSource(struct generator *self, const char *schemaFile)
+{
+    size_t i;
+
+    fprintf(self->c,
+        "/* generated by blinkc from %s (do not edit) */\n"
+        "\n"
+        "/* includes ***********************************************************/\n"
+        "\n"
+        "#include \"%s\"\n"
+        "#include \"blink_compact.h\"\n"
+        "\n"
+        "#include <string.h>\n"
+        "\n"
+        "/* defines ************************************************************/\n"
+        "\n"
+        "#ifndef BLINK_GEN_NEST_DEPTH\n"
+        "#define BLINK_GEN_NEST_DEPTH 10U\n"
+        "#endif\n"
+        "\n"
+        "/* static function prototypes *****************************************/\n"
+        "\n"
+        "static void *allocate(const struct blink_allocator *alloc, size_t nelem, size_t elsize);\n"
+        "static bool openGroup(blink_stream_t in, struct blink_stream *bounded, uint64_t *id, bool *isNull);\n"
+        "static bool closeGroup(blink_stream_t bounded);\n"
+        "static bool decodeDynamic(blink_stream_t in, struct blink_gen_dynamic *out, bool *isNull, const struct blink_allocator *alloc, uint8_t depth);\n"
+        "static bool encodeDynamic(const struct blink_gen_dynamic *in, blink_stream_t out);\n"
+        "static uint32_t sizeofDynamic(const struct blink_gen_dynamic *in);\n",
+        schemaFile, self->header
+    );
+
+    if(self->useBytes){
+
+        fprintf(self->c, "static bool readBytes(blink_stream_t in, struct blink_gen_bytes *out, bool *isNull, const struct blink_allocator *alloc);\n");
+    }
+
+    if(self->useSequence){
+
+        fprintf(self->c, "static void *allocElems(blink_stream_t in, uint32_t n, size_t elsize, const struct blink_allocator *alloc);\n");
+    }
+
+    if(self->useF64){
+
+        fprintf(self->c, "static uint32_t sizeofF64(double value);\n");
+    }
+
+    if(self->useDynamic){
+
+        fprintf(self->c, "static uint32_t sizeofDynamicField(const struct blink_gen_dynamic *in);\n");
+    }
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        const char *name = self->groups[i].name;
+
+        if(self->groups[i].kindOf){
+
+            fprintf(self->c, "static bool isKindOf_%s(uint64_t id);\n", name);
+        }
+
+        if(self->groups[i].needed){
+
+            fprintf(self->c,
+                "static bool decode_%s(blink_stream_t in, struct %s *out, const struct blink_allocator *alloc, uint8_t depth);\n"
+                "static bool encode_%s(const struct %s *in, blink_stream_t out);\n"
+                "static uint32_t sizeof_%s(const struct %s *in);\n",
+                name, name, name, name, name, name
+            );
+        }
+    }
+
+    fprintf(self->c,
+        "\n"
+        "/* functions **********************************************************/\n"
+        "\n"
+        "bool %s_decodeCompact(blink_stream_t in, struct blink_gen_dynamic *out, const struct blink_allocator *alloc)\n"
+        "{\n"
+        "    bool isNull;\n"
+        "\n"
+        "    return decodeDynamic(in, out, &isNull, alloc, 0U) && !isNull;\n"
+        "}\n"
+        "\n"
+        "bool %s_encodeCompact(const struct blink_gen_dynamic *in, blink_stream_t out)\n"
+        "{\n"
+        "    return encodeDynamic(in, out);\n"
+        "}\n"
+        "\n",
+        self->base, self->base
+    );
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        const char *name = self->groups[i].name;
+
+        if(BLINK_Group_hasID(self->groups[i].group)){
+
+            fprintf(self->c,
+                "bool %s_decodeCompact(blink_stream_t in, struct %s *out, const struct blink_allocator *alloc)\n"
+                "{\n"
+                "    struct blink_stream bounded;\n"
+                "    uint64_t id;\n"
+                "    bool isNull;\n"
+                "\n"
+                "    (void)memset(out, 0, sizeof(*out));\n"
+                "\n"
+                "    return openGroup(in, &bounded, &id, &isNull) && !isNull && (id == %s_ID) && decode_%s(&bounded, out, alloc, 0U) && closeGroup(&bounded);\n"
+                "}\n"
+                "\n"
+                "bool %s_encodeCompact(const struct %s *in, blink_stream_t out)\n"
+                "{\n"
+                "    uint32_t size = BLINK_Compact_sizeofUnsigned(%s_ID) + sizeof_%s(in);\n"
+                "\n"
+                "    return BLINK_Compact_encodeU32(size, out) && BLINK_Compact_encodeU64(%s_ID, out) && encode_%s(in, out);\n"
+                "}\n"
+                "\n",
+                name, name, name, name,
+                name, name, name, name, name, name
+            );
+        }
+    }
+
+    fprintf(self->c, "/* static functions ***************************************************/\n\n");
+
+    writeHelpers(self);
+    writeDynamic(self);
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        if(self->groups[i].kindOf){
+
+            writeKindOf(self, &self->groups[i]);
+        }
+
+        if(self->groups[i].needed){
+
+            writeDecode(self, &self->groups[i]);
+            writeEncode(self, &self->groups[i]);
+            writeSizeof(self, &self->groups[i]);
+        }
+    }
+}
+
+static void writeHelpers(struct generator *self)
+{
+    fprintf(self->c,
+        "static void *allocate(const struct blink_allocator *alloc, size_t nelem, size_t elsize)\n"
+        "{\n"
+        "    return (alloc != NULL) ? BLINK_Allocator_calloc(alloc, nelem, elsize) : NULL;\n"
+        "}\n"
+        "\n"
+        "/* read size preamble and ID and bound `in` to the group */\n"
+        "static bool openGroup(blink_stream_t in, struct blink_stream *bounded, uint64_t *id, bool *isNull)\n"
+        "{\n"
+        "    uint32_t size;\n"
+        "\n"
+        "    if(!BLINK_Compact_decodeU32(in, &size, isNull)){\n"
+        "\n"
+        "        return false;\n"
+        "    }\n"
+        "\n"
+        "    if(*isNull){\n"
+        "\n"
+        "        return true;\n"
+        "    }\n"
+        "\n"
+        "    if(size == 0U){\n"
+        "\n"
+        "        return false;\n"
+        "    }\n"
+        "\n"
+        "    (void)BLINK_Stream_initBounded(bounded, in, size);\n"
+        "\n"
+        "    return BLINK_Compact_decodeU64(bounded, id, isNull) && !*isNull;\n"
+        "}\n"
+        "\n"
+        "/* extensions are not supported */\n"
+        "static bool closeGroup(blink_stream_t bounded)\n"
+        "{\n"
+        "    return (BLINK_Stream_tell(bounded) == BLINK_Stream_max(bounded));\n"
+        "}\n"
+        "\n"
+    );
+
+    if(self->useBytes){
+
+        fprintf(self->c,
+            "/* string data is borrowed from the input where possible */\n"
+            "static bool readBytes(blink_stream_t in, struct blink_gen_bytes *out, bool *isNull, const struct blink_allocator *alloc)\n"
+            "{\n"
+            "    uint32_t size;\n"
+            "\n"
+            "    if(!BLINK_Compact_decodeU32(in, &size, isNull)){\n"
+            "\n"
+            "        return false;\n"
+            "    }\n"
+            "\n"
+            "    if(*isNull){\n"
+            "\n"
+            "        return true;\n"
+            "    }\n"
+            "\n"
+            "    out->len = size;\n"
+            "\n"
+            "    if(BLINK_Stream_canBorrow(in)){\n"
+            "\n"
+            "        out->data = BLINK_Stream_borrow(in, size);\n"
+            "\n"
+            "        return (out->data != NULL);\n"
+            "    }\n"
+            "    else{\n"
+            "\n"
+            "        uint8_t *data = (size > 0U) ? allocate(alloc, size, 1U) : NULL;\n"
+            "\n"
+            "        out->data = data;\n"
+            "\n"
+            "        return ((size == 0U) || (data != NULL)) && BLINK_Stream_read(in, data, size);\n"
+            "    }\n"
+            "}\n"
+            "\n"
+        );
+    }
+
+    if(self->useSequence){
+
+        fprintf(self->c,
+            "/* every element occupies at least one byte which limits `n` */\n"
+            "static void *allocElems(blink_stream_t in, uint32_t n, size_t elsize, const struct blink_allocator *alloc)\n"
+            "{\n"
+            "    return (n <= (BLINK_Stream_max(in) - BLINK_Stream_tell(in))) ? allocate(alloc, n, elsize) : NULL;\n"
+            "}\n"
+            "\n"
+        );
+    }
+
+    if(self->useF64){
+
+        fprintf(self->c,
+            "static uint32_t sizeofF64(double value)\n"
+            "{\n"
+            "    uint64_t bits;\n"
+            "\n"
+            "    (void)memcpy(&bits, &value, sizeof(bits));\n"
+            "\n"
+            "    return BLINK_Compact_sizeofUnsigned(bits);\n"
+            "}\n"
+            "\n"
+        );
+    }
+}
+
+static void writeDynamic(struct generator *self)
+{
+    size_t i;
+
+    fprintf(self->c,
+        "static bool decodeDynamic(blink_stream_t in, struct blink_gen_dynamic *out, bool *isNull, const struct blink_allocator *alloc, uint8_t depth)\n"
+        "{\n"
+        "    struct blink_stream bounded;\n"
+        "\n"
+        "    if(!openGroup(in, &bounded, &out->id, isNull) || (depth >= BLINK_GEN_NEST_DEPTH)){\n"
+        "\n"
+        "        return false;\n"
+        "    }\n"
+        "\n"
+        "    if(*isNull){\n"
+        "\n"
+        "        out->group = NULL;\n"
+        "        return true;\n"
+        "    }\n"
+        "\n"
+        "    switch(out->id){\n"
+    );
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        const char *name = self->groups[i].name;
+
+        if(BLINK_Group_hasID(self->groups[i].group)){
+
+            fprintf(self->c,
+                "    case %s_ID:\n"
+                "        out->group = allocate(alloc, 1U, sizeof(struct %s));\n"
+                "        return (out->group != NULL) && decode_%s(&bounded, out->group, alloc, depth + 1U) && closeGroup(&bounded);\n",
+                name, name, name
+            );
+        }
+    }
+
+    fprintf(self->c,
+        "    default:\n"
+        "        return false;\n"
+        "    }\n"
+        "}\n"
+        "\n"
+        "static bool encodeDynamic(const struct blink_gen_dynamic *in, blink_stream_t out)\n"
+        "{\n"
+        "    uint32_t size = sizeofDynamic(in);\n"
+        "\n"
+        "    if((size == 0U) || !BLINK_Compact_encodeU32(size, out) || !BLINK_Compact_encodeU64(in->id, out)){\n"
+        "\n"
+        "        return false;\n"
+        "    }\n"
+        "\n"
+        "    switch(in->id){\n"
+    );
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        const char *name = self->groups[i].name;
+
+        if(BLINK_Group_hasID(self->groups[i].group)){
+
+            fprintf(self->c,
+                "    case %s_ID:\n"
+                "        return encode_%s(in->group, out);\n",
+                name, name
+            );
+        }
+    }
+
+    fprintf(self->c,
+        "    default:\n"
+        "        return false;\n"
+        "    }\n"
+        "}\n"
+        "\n"
+        "/* encoded size excluding size preamble (zero if group is unknown) */\n"
+        "static uint32_t sizeofDynamic(const struct blink_gen_dynamic *in)\n"
+        "{\n"
+        "    switch(in->id){\n"
+    );
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        const char *name = self->groups[i].name;
+
+        if(BLINK_Group_hasID(self->groups[i].group)){
+
+            fprintf(self->c,
+                "    case %s_ID:\n"
+                "        return BLINK_Compact_sizeofUnsigned(%s_ID) + sizeof_%s(in->group);\n",
+                name, name, name
+            );
+        }
+    }
+
+    fprintf(self->c,
+        "    default:\n"
+        "        return 0U;\n"
+        "    }\n"
+        "}\n"
+        "\n"
+    );
+
+    if(self->useDynamic){
+
+        fprintf(self->c,
+            "/* encoded size including size preamble */\n"
+            "static uint32_t sizeofDynamicField(const struct blink_gen_dynamic *in)\n"
+            "{\n"
+            "    uint32_t size = sizeofDynamic(in);\n"
+            "\n"
+            "    return BLINK_Compact_sizeofUnsigned(size) + size;\n"
+            "}\n"
+            "\n"
+        );
+    }
+}
+
+static void writeKindOf(struct generator *self, struct group_info *info)
+{
+    size_t i;
+    bool any = false;
+
+    fprintf(self->c,
+        "static bool isKindOf_%s(uint64_t id)\n"
+        "{\n"
+        "    switch(id){\n",
+        info->name
+    );
+
+    for(i=0U; i < self->numberOfGroups; i++){
+
+        if(BLINK_Group_hasID(self->groups[i].group) && BLINK_Group_isKindOf(self->groups[i].group, info->group)){
+
+            fprintf(self->c, "    case %s_ID:\n", self->groups[i].name);
+            any = true;
+        }
+    }
+
+    if(any){
+
+        fprintf(self->c, "        return true;\n");
+    }
+
+    fprintf(self->c,
+        "    default:\n"
+        "        return false;\n"
+        "    }\n"
+        "}\n"
+        "\n"
+    );
+}
+
+static void writeDecode(struct generator *self, struct group_info *info)
+{
+    const struct blink_field_desc *desc = BLINK_Group_getFieldDescs(info->group);
+    size_t n = BLINK_Group_numberOfFields(info->group);
+    bool useNull = false;
+    bool useIndex = false;
+    char lv[NAME_MAX_SIZE + 16U];
+    size_t i;
+
+    for(i=0U; i < n; i++){
+
+        useNull = useNull || desc[i].isSequence || isNullable(desc[i].type);
+        useIndex = useIndex || desc[i].isSequence;
+    }
+
+    fprintf(self->c,
+        "static bool decode_%s(blink_stream_t in, struct %s *out, const struct blink_allocator *alloc, uint8_t depth)\n"
+        "{\n",
+        info->name, info->name
+    );
+
+    if(useNull){
+
+        fprintf(self->c, "    bool isNull;\n");
+    }
+
+    if(useIndex){
+
+        fprintf(self->c, "    uint32_t i;\n");
+    }
+
+    if(useNull || useIndex){
+
+        fprintf(self->c, "\n");
+    }
+
+    for(i=0U; i < n; i++){
+
+        const char *name = BLINK_Field_getName(desc[i].field);
+
+        if(desc[i].isSequence){
+
+            struct blink_field_desc elem = desc[i];
+
+            elem.isOptional = false;
+
+            fprintf(self->c,
+                "    if(!BLINK_Compact_decodeU32(in, &out->%s.size, &isNull)%s){\n"
+                "\n"
+                "        return false;\n"
+                "    }\n"
+                "\n",
+                name, desc[i].isOptional ? "" : " || isNull"
+            );
+
+            if(desc[i].isOptional){
+
+                fprintf(self->c, "    out->has%s = !isNull;\n\n", name);
+            }
+
+            fprintf(self->c,
+                "    if(!isNull && (out->%s.size > 0U)){\n"
+                "\n"
+                "        out->%s.data = allocElems(in, out->%s.size, sizeof(*out->%s.data), alloc);\n"
+                "\n"
+                "        if(out->%s.data == NULL){\n"
+                "\n"
+                "            return false;\n"
+                "        }\n"
+                "\n"
+                "        for(i=0U; i < out->%s.size; i++){\n"
+                "\n",
+                name, name, name, name, name, name
+            );
+
+            (void)snprintf(lv, sizeof(lv), "out->%s.data[i]", name);
+            writeDecodeValue(self, &elem, lv, "        ");
+
+            fprintf(self->c,
+                "        }\n"
+                "    }\n"
+                "\n"
+            );
+        }
+        else{
+
+            (void)snprintf(lv, sizeof(lv), "out->%s", name);
+            writeDecodeValue(self, &desc[i], lv, "");
+        }
+    }
+
+    fprintf(self->c,
+        "    return true;\n"
+        "}\n"
+        "\n"
+    );
+}
+
+/* `lv` names the value; the presence flag is has<field> alongside it */
+static void writeDecodeValue(struct generator *self, const struct blink_field_desc *desc, const char *lv, const char *indent)
+{
+    const char *name = BLINK_Field_getName(desc->field);
+    const char *check = desc->isOptional ? "" : " || isNull";
+    char has[NAME_MAX_SIZE + 16U];
+
+    (void)snprintf(has, sizeof(has), desc->isOptional ? "out->has%s && " : "", name);
+
+    switch(desc->type){
+    case BLINK_TYPE_STRING:
+    case BLINK_TYPE_BINARY:
+        fprintf(self->c, "%s    if(!readBytes(in, &%s, &isNull, alloc)%s){\n", indent, lv, check);
+        break;
+    case BLINK_TYPE_DECIMAL:
+        fprintf(self->c, "%s    if(!BLINK_Compact_decodeDecimal(in, &%s.mantissa, &%s.exponent, &isNull)%s){\n", indent, lv, lv, check);
+        break;
+    case BLINK_TYPE_DYNAMIC_GROUP:
+        if(desc->isOptional){
+
+            fprintf(self->c, "%s    if(!decodeDynamic(in, &%s, &isNull, alloc, depth) || (!isNull && !isKindOf_%s(%s.id))){\n", indent, lv, lookupGroup(self, desc->ref)->name, lv);
+        }
+        else{
+
+            fprintf(self->c, "%s    if(!decodeDynamic(in, &%s, &isNull, alloc, depth) || isNull || !isKindOf_%s(%s.id)){\n", indent, lv, lookupGroup(self, desc->ref)->name, lv);
+        }
+        break;
+    case BLINK_TYPE_OBJECT:
+        fprintf(self->c, "%s    if(!decodeDynamic(in, &%s, &isNull, alloc, depth)%s){\n", indent, lv, check);
+        break;
+    case BLINK_TYPE_FIXED:
+    case BLINK_TYPE_STATIC_GROUP:
+        if(desc->isOptional){
+
+            fprintf(self->c,
+                "%s    if(!BLINK_Compact_decodePresent(in, &out->has%s)){\n"
+                "\n"
+                "%s        return false;\n"
+                "%s    }\n"
+                "\n",
+                indent, name, indent, indent
+            );
+        }
+
+        if(desc->type == BLINK_TYPE_FIXED){
+
+            fprintf(self->c, "%s    if(%s!BLINK_Stream_read(in, %s, %luU)){\n", indent, has, lv, (unsigned long)desc->size);
+        }
+        else{
+
+            fprintf(self->c, "%s    if(%s!decode_%s(in, &%s, alloc, depth)){\n", indent, has, lookupGroup(self, desc->ref)->name, lv);
+        }
+        break;
+    default:
+        fprintf(self->c, "%s    if(!BLINK_Compact_decode%s(in, &%s, &isNull)%s){\n", indent, primitiveName(desc->type), lv, check);
+        break;
+    }
+
+    fprintf(self->c,
+        "\n"
+        "%s        return false;\n"
+        "%s    }\n"
+        "\n",
+        indent, indent
+    );
+
+    if(desc->isOptional && (isNullable(desc->type))){
+
+        fprintf(self->c, "%s    out->has%s = !isNull;\n\n", indent, name);
+    }
+}
+
+static void writeEncode(struct generator *self, struct group_info *info)
+{
+    const struct blink_field_desc *desc = BLINK_Group_getFieldDescs(info->group);
+    size_t n = BLINK_Group_numberOfFields(info->group);
+    bool useIndex = false;
+    char lv[NAME_MAX_SIZE + 16U];
+    size_t i;
+
+    for(i=0U; i < n; i++){
+
+        useIndex = useIndex || desc[i].isSequence;
+    }
+
+    fprintf(self->c,
+        "static bool encode_%s(const struct %s *in, blink_stream_t out)\n"
+        "{\n",
+        info->name, info->name
+    );
+
+    if(useIndex){
+
+        fprintf(self->c, "    uint32_t i;\n\n");
+    }
+
+    for(i=0U; i < n; i++){
+
+        const char *name = BLINK_Field_getName(desc[i].field);
+        const char *indent = "";
+
+        if(desc[i].isOptional){
+
+            fprintf(self->c,
+                "    if(!in->has%s){\n"
+                "\n"
+                "        if(!BLINK_Compact_encodeNull(out)){\n"
+                "\n"
+                "            return false;\n"
+                "        }\n"
+                "    }\n"
+                "    else{\n"
+                "\n",
+                name
+            );
+
+            indent = "    ";
+        }
+
+        if(desc[i].isSequence){
+
+            struct blink_field_desc elem = desc[i];
+
+            elem.isOptional = false;
+
+            fprintf(self->c,
+                "%s    if(!BLINK_Compact_encodeU32(in->%s.size, out)){\n"
+                "\n"
+                "%s        return false;\n"
+                "%s    }\n"
+                "\n"
+                "%s    for(i=0U; i < in->%s.size; i++){\n"
+                "\n",
+                indent, name, indent, indent, indent, name
+            );
+
+            (void)snprintf(lv, sizeof(lv), "in->%s.data[i]", name);
+            writeEncodeValue(self, &elem, lv, (desc[i].isOptional) ? "        " : "    ");
+
+            fprintf(self->c, "%s    }\n", indent);
+        }
+        else{
+
+            (void)snprintf(lv, sizeof(lv), "in->%s", name);
+            writeEncodeValue(self, &desc[i], lv, indent);
+        }
+
+        if(desc[i].isOptional){
+
+            fprintf(self->c, "    }\n");
+        }
+
+        fprintf(self->c, "\n");
+    }
+
+    fprintf(self->c,
+        "    return true;\n"
+        "}\n"
+        "\n"
+    );
+}
+
+/* optional values have already been found to be present */
+static void writeEncodeValue(struct generator *self, const struct blink_field_desc *desc, const char *lv, const char *indent)
+{
+    const char *present = ((desc->type == BLINK_TYPE_FIXED) || (desc->type == BLINK_TYPE_STATIC_GROUP)) && desc->isOptional ? "!BLINK_Compact_encodePresent(out) || " : "";
+
+    switch(desc->type){
+    case BLINK_TYPE_STRING:
+    case BLINK_TYPE_BINARY:
+        fprintf(self->c, "%s    if(!BLINK_Compact_encodeU32(%s.len, out) || ((%s.len > 0U) && !BLINK_Stream_writeRef(out, %s.data, %s.len))){\n", indent, lv, lv, lv, lv);
+        break;
+    case BLINK_TYPE_FIXED:
+        fprintf(self->c, "%s    if(%s!BLINK_Stream_write(out, %s, %luU)){\n", indent, present, lv, (unsigned long)desc->size);
+        break;
+    case BLINK_TYPE_DECIMAL:
+        fprintf(self->c, "%s    if(!BLINK_Compact_encodeDecimal(%s.mantissa, %s.exponent, out)){\n", indent, lv, lv);
+        break;
+    case BLINK_TYPE_STATIC_GROUP:
+        fprintf(self->c, "%s    if(%s!encode_%s(&%s, out)){\n", indent, present, lookupGroup(self, desc->ref)->name, lv);
+        break;
+    case BLINK_TYPE_DYNAMIC_GROUP:
+    case BLINK_TYPE_OBJECT:
+        fprintf(self->c, "%s    if(!encodeDynamic(&%s, out)){\n", indent, lv);
+        break;
+    default:
+        fprintf(self->c, "%s    if(!BLINK_Compact_encode%s(%s, out)){\n", indent, primitiveName(desc->type), lv);
+        break;
+    }
+
+    fprintf(self->c,
+        "\n"
+        "%s        return false;\n"
+        "%s    }\n",
+        indent, indent
+    );
+}
+
+static void writeSizeof(struct generator *self, struct group_info *info)
+{
+    const struct blink_field_desc *desc = BLINK_Group_getFieldDescs(info->group);
+    size_t n = BLINK_Group_numberOfFields(info->group);
+    bool useIndex = false;
+    char lv[NAME_MAX_SIZE + 16U];
+    size_t i;
+
+    for(i=0U; i < n; i++){
+
+        useIndex = useIndex || desc[i].isSequence;
+    }
+
+    fprintf(self->c,
+        "static uint32_t sizeof_%s(const struct %s *in)\n"
+        "{\n"
+        "    uint32_t size = 0U;\n",
+        info->name, info->name
+    );
+
+    if(useIndex){
+
+        fprintf(self->c, "    uint32_t i;\n");
+    }
+
+    fprintf(self->c, "\n");
+
+    for(i=0U; i < n; i++){
+
+        const char *name = BLINK_Field_getName(desc[i].field);
+        const char *indent = "";
+
+        if(desc[i].isOptional){
+
+            fprintf(self->c,
+                "    if(!in->has%s){\n"
+                "\n"
+                "        size += 1U;\n"
+                "    }\n"
+                "    else{\n"
+                "\n",
+                name
+            );
+
+            indent = "    ";
+        }
+
+        if(desc[i].isSequence){
+
+            struct blink_field_desc elem = desc[i];
+
+            elem.isOptional = false;
+
+            fprintf(self->c,
+                "%s    size += BLINK_Compact_sizeofUnsigned(in->%s.size);\n"
+                "\n"
+                "%s    for(i=0U; i < in->%s.size; i++){\n"
+                "\n",
+                indent, name, indent, name
+            );
+
+            (void)snprintf(lv, sizeof(lv), "in->%s.data[i]", name);
+            writeSizeofValue(self, &elem, lv, (desc[i].isOptional) ? "        " : "    ");
+
+            fprintf(self->c, "%s    }\n", indent);
+        }
+        else{
+
+            (void)snprintf(lv, sizeof(lv), "in->%s", name);
+            writeSizeofValue(self, &desc[i], lv, indent);
+        }
+
+        if(desc[i].isOptional){
+
+            fprintf(self->c, "    }\n");
+        }
+
+        fprintf(self->c, "\n");
+    }
+
+    fprintf(self->c,
+        "    return size;\n"
+        "}\n"
+        "\n"
+    );
+}
+
+static void writeSizeofValue(struct generator *self, const struct blink_field_desc *desc, const char *lv, const char *indent)
+{
+    const char *present = ((desc->type == BLINK_TYPE_FIXED) || (desc->type == BLINK_TYPE_STATIC_GROUP)) && desc->isOptional ? "1U + " : "";
+
+    switch(desc->type){
+    case BLINK_TYPE_STRING:
+    case BLINK_TYPE_BINARY:
+        fprintf(self->c, "%s    size += BLINK_Compact_sizeofUnsigned(%s.len) + %s.len;\n", indent, lv, lv);
+        break;
+    case BLINK_TYPE_FIXED:
+        fprintf(self->c, "%s    size += %s%luU;\n", indent, present, (unsigned long)desc->size);
+        break;
+    case BLINK_TYPE_BOOL:
+        fprintf(self->c, "%s    size += 1U;\n", indent);
+        break;
+    case BLINK_TYPE_F64:
+        fprintf(self->c, "%s    size += sizeofF64(%s);\n", indent, lv);
+        break;
+    case BLINK_TYPE_DECIMAL:
+        fprintf(self->c, "%s    size += BLINK_Compact_sizeofSigned(%s.exponent) + BLINK_Compact_sizeofSigned(%s.mantissa);\n", indent, lv, lv);
+        break;
+    case BLINK_TYPE_STATIC_GROUP:
+        fprintf(self->c, "%s    size += %ssizeof_%s(&%s);\n", indent, present, lookupGroup(self, desc->ref)->name, lv);
+        break;
+    case BLINK_TYPE_DYNAMIC_GROUP:
+    case BLINK_TYPE_OBJECT:
+        fprintf(self->c, "%s    size += sizeofDynamicField(&%s);\n", indent, lv);
+        break;
+    default:
+        fprintf(self->c, "%s    size += BLINK_Compact_sizeof%s(%s);\n", indent, isSigned(desc->type) ? "Signed" : "Unsigned", lv);
+        break;
+    }
+}
+
+/* types which are decoded with an `isNull` output (others use a presence flag) */
+static bool isNullable(enum blink_type_tag type)
+{
+    return (type != BLINK_TYPE_FIXED) && (type != BLINK_TYPE_STATIC_GROUP);
+}
+
+/* suffix of the blink_compact function for a primitive type */
+static const char *primitiveName(enum blink_type_tag type)
+{
+    switch(type){
+    case BLINK_TYPE_BOOL:
+        return "Bool";
+    case BLINK_TYPE_U8:
+        return "U8";
+    case BLINK_TYPE_U16:
+        return "U16";
+    case BLINK_TYPE_U32:
+    case BLINK_TYPE_TIME_OF_DAY_MILLI:
+        return "U32";
+    case BLINK_TYPE_U64:
+    case BLINK_TYPE_TIME_OF_DAY_NANO:
+        return "U64";
+    case BLINK_TYPE_I8:
+        return "I8";
+    case BLINK_TYPE_I16:
+        return "I16";
+    case BLINK_TYPE_I32:
+    case BLINK_TYPE_DATE:
+    case BLINK_TYPE_ENUM:
+        return "I32";
+    case BLINK_TYPE_F64:
+        return "F64";
+    default:
+        return "I64";
+    }
+}
+
+static const char *primitiveType(enum blink_type_tag type)
+{
+    switch(type){
+    case BLINK_TYPE_BOOL:
+        return "bool";
+    case BLINK_TYPE_U8:
+        return "uint8_t";
+    case BLINK_TYPE_U16:
+        return "uint16_t";
+    case BLINK_TYPE_U32:
+    case BLINK_TYPE_TIME_OF_DAY_MILLI:
+        return "uint32_t";
+    case BLINK_TYPE_U64:
+    case BLINK_TYPE_TIME_OF_DAY_NANO:
+        return "uint64_t";
+    case BLINK_TYPE_I8:
+        return "int8_t";
+    case BLINK_TYPE_I16:
+        return "int16_t";
+    case BLINK_TYPE_I32:
+    case BLINK_TYPE_DATE:
+    case BLINK_TYPE_ENUM:
+        return "int32_t";
+    case BLINK_TYPE_F64:
+        return "double";
+    default:
+        return "int64_t";
+    }
+}
+
+static bool isSigned(enum blink_type_tag type)
+{
+    switch(type){
+    case BLINK_TYPE_I8:
+    case BLINK_TYPE_I16:
+    case BLINK_TYPE_I32:
+    case BLINK_TYPE_I64:
+    case BLINK_TYPE_DATE:
+    case BLINK_TYPE_NANO_TIME:
+    case BLINK_TYPE_MILLI_TIME:
+    case BLINK_TYPE_ENUM:
+        return true;
+    default:
+        return false;
+    }
+}
@@ -23,9 +23,67 @@
 #ifndef BLINK_ALLOCATOR_H
 #define BLINK_ALLOCATOR_H
 
+#include <stddef.h>
+#include <stdbool.h>
+
+/** Allocator interface used by uBlink modules
+ *
+ * Either `calloc` or `ctxCalloc` must be defined. The `ctx` variants
+ * are used in preference and receive `ctx` as their first argument,
+ * which allows stateful allocators (e.g. blink_arena) to be plugged in.
+ *
+ * Freeing is optional; if neither `free` nor `ctxFree` is defined
+ * memory is never returned individually.
+ *
+ * */
 struct blink_allocator {
-    void * (*calloc)(size_t nelem, size_t elsize);  /**< mandatory calloc-like function */
+    void * (*calloc)(size_t nelem, size_t elsize);  /**< calloc-like function */
     void (*free)(void *ptr);                        /**< optional free-like function */
+    void * (*ctxCalloc)(void *ctx, size_t nelem, size_t elsize);  /**< calloc-like function taking `ctx` */
+    void (*ctxFree)(void *ctx, void *ptr);          /**< optional free-like function taking `ctx` */
+    void *ctx;                                      /**< passed to `ctxCalloc` and `ctxFree` */
 };
 
+/** @return true if allocator can allocate */
+static inline bool BLINK_Allocator_isValid(const struct blink_allocator *self)
+{
+    return (self->ctxCalloc != NULL) || (self->calloc != NULL);
+}
+
+/** Allocate zeroed memory
+ *
+ * @param[in] self allocator
+ * @param[in] nelem number of elements
+ * @param[in] elsize size of each element
+ * @return pointer to memory
+ * @retval NULL could not allocate
+ *
+ * */
+static inline void *BLINK_Allocator_calloc(const struct blink_allocator *self, size_t nelem, size_t elsize)
+{
+    return (self->ctxCalloc != NULL) ? self->ctxCalloc(self->ctx, nelem, elsize) : self->calloc(nelem, elsize);
+}
+
+/** Free memory (does nothing if the allocator cannot free)
+ *
+ * @param[in] self allocator
+ * @param[in] ptr memory returned by BLINK_Allocator_calloc()
+ *
+ * */
+static inline void BLINK_Allocator_free(const struct blink_allocator *self, void *ptr)
+{
+    if(self->ctxFree != NULL){
+
+        self->ctxFree(self->ctx, ptr);
+    }
+    else if(self->free != NULL){
+
+        self->free(ptr);
+    }
+    else{
+
+        /* memory is reclaimed some other way */
+    }
+}
+
 #endif
@@ -0,0 +1,217 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+#ifndef BLINK_ARENA_H
+#define BLINK_ARENA_H
+
+/**
+ * @defgroup blink_arena blink_arena
+ * @ingroup ublink
+ *
+ * An arena allocator for uBlink modules.
+ *
+ * Memory is allocated by bumping a pointer and is only reclaimed in bulk,
+ * either by rewinding to a mark or by resetting the whole arena. When
+ * the current block is exhausted further blocks are obtained from a
+ * backing allocator and chained. Blocks are kept across a reset so
+ * a steady-state decode-process-discard loop does not allocate.
+ *
+ * ### Example Workflow
+ *
+ * Initialise an arena with an optional initial heap and an optional
+ * backing allocator for additional blocks:
+ *
+ * @code
+ * static uint8_t heap[4096U];
+ * struct blink_arena arena;
+ * struct blink_allocator backing = {.calloc = calloc, .free = free};
+ * (void)BLINK_Arena_init(&arena, heap, sizeof(heap), &backing);
+ * @endcode
+ *
+ * Plug the arena into any function that takes an allocator:
+ *
+ * @code
+ * struct blink_allocator alloc = BLINK_Arena_getAllocator(&arena);
+ *
+ * for(;;){
+ *
+ *     blink_object_t msg = BLINK_Object_decodeCompact(in, schema, &alloc);
+ *
+ *     // process message...
+ *
+ *     // discard message
+ *     BLINK_Arena_reset(&arena);
+ * }
+ * @endcode
+ *
+ * Release temporary allocations back to a mark:
+ *
+ * @code
+ * struct blink_arena_mark mark = BLINK_Arena_mark(&arena);
+ * void *scratch = BLINK_Arena_calloc(&arena, 1U, 256U);
+ * BLINK_Arena_rewind(&arena, mark);
+ * @endcode
+ *
+ * Return chained blocks to the backing allocator:
+ *
+ * @code
+ * BLINK_Arena_destroy(&arena);
+ * @endcode
+ *
+ * @{
+ * */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ***********************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "blink_alloc.h"
+
+/* defines ************************************************************/
+
+#ifndef BLINK_ARENA_ALIGN
+/** alignment of every allocation (must be a power of two) */
+#define BLINK_ARENA_ALIGN 8U
+#endif
+
+#ifndef BLINK_ARENA_BLOCK_SIZE
+/** minimum size of a chained block in bytes */
+#define BLINK_ARENA_BLOCK_SIZE 4096U
+#endif
+
+/* types **************************************************************/
+
+struct blink_arena_block {
+    struct blink_arena_block *next; /**< next block in chain */
+    uint8_t *heap;                  /**< start of block memory */
+    size_t size;                    /**< size of block memory in bytes */
+    size_t pos;                     /**< free memory offset */
+};
+
+struct blink_arena {
+    struct blink_arena_block first;     /**< initial block (may have zero size) */
+    struct blink_arena_block *current;  /**< block currently being allocated from */
+    struct blink_allocator backing;     /**< source of chained blocks */
+    bool canChain;                      /**< true if `backing` is valid */
+};
+
+/** A position in an arena that can be rewound to */
+struct blink_arena_mark {
+    struct blink_arena_block *block;    /**< block */
+    size_t pos;                         /**< offset within block */
+};
+
+/** This type shall be used by uBlink modules to refer to initialised arenas */
+typedef struct blink_arena * blink_arena_t;
+
+/* function prototypes ************************************************/
+
+/** Initialise an arena
+ *
+ * @param[in] self
+ * @param[in] heap initial block (may be NULL), must be aligned to #BLINK_ARENA_ALIGN
+ * @param[in] size size of `heap` in bytes
+ * @param[in] backing allocator for chained blocks (may be NULL if the
+ *                    arena must not grow beyond `heap`)
+ *
+ * @return initialised arena
+ *
+ * */
+blink_arena_t BLINK_Arena_init(struct blink_arena *self, uint8_t *heap, size_t size, const struct blink_allocator *backing);
+
+/** Allocate zeroed memory from the arena
+ *
+ * @param[in] self
+ * @param[in] nelem number of elements
+ * @param[in] elsize size of each element
+ *
+ * @return pointer aligned to #BLINK_ARENA_ALIGN
+ *
+ * @retval NULL arena is exhausted and cannot chain another block
+ *
+ * */
+void *BLINK_Arena_calloc(blink_arena_t self, size_t nelem, size_t elsize);
+
+/** Record the current position in the arena
+ *
+ * @param[in] self
+ * @return mark
+ *
+ * */
+struct blink_arena_mark BLINK_Arena_mark(blink_arena_t self);
+
+/** Release everything allocated since a mark was taken
+ *
+ * @note marks taken after `mark` become invalid
+ *
+ * @param[in] self
+ * @param[in] mark from BLINK_Arena_mark()
+ *
+ * */
+void BLINK_Arena_rewind(blink_arena_t self, struct blink_arena_mark mark);
+
+/** Release everything allocated from the arena
+ *
+ * Chained blocks are retained for reuse.
+ *
+ * @param[in] self
+ *
+ * */
+void BLINK_Arena_reset(blink_arena_t self);
+
+/** Reset the arena and return chained blocks to the backing allocator
+ *
+ * @param[in] self
+ *
+ * */
+void BLINK_Arena_destroy(blink_arena_t self);
+
+/** Get an allocator interface for the arena
+ *
+ * Memory allocated through the interface is not freed individually.
+ *
+ * @param[in] self
+ * @return allocator
+ *
+ * */
+struct blink_allocator BLINK_Arena_getAllocator(blink_arena_t self);
+
+/** Discover how many bytes can be allocated without chaining a new block
+ *
+ * @param[in] self
+ * @return free space in bytes
+ *
+ * */
+size_t BLINK_Arena_getFreeSpace(blink_arena_t self);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif
@@ -40,6 +40,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 /* typedefs ***********************************************************/
 
@@ -47,6 +48,11 @@ struct blink_stream;
 
 typedef struct blink_stream * blink_stream_t;
 
+struct blink_schema;
+struct blink_field_desc;
+
+typedef struct blink_schema * blink_schema_t;
+
 /* functions **********************************************************/
 
 /**
@@ -228,6 +234,41 @@ bool BLINK_Compact_decodeDecimal(blink_stream_t in, int64_t *mantissa, int8_t *e
  * */
 bool BLINK_Compact_decodeF64(blink_stream_t in, double *out, bool *isNull);
 
+/**
+ * Decode an array of `u64`
+ *
+ * Decodes `n` consecutive non-NULL unsigned VLC integers (e.g. the
+ * elements of an integer sequence). Runs of single byte values are
+ * decoded with SIMD instructions where the stream is memory backed and
+ * the CPU supports it (define BLINK_NO_SIMD to disable).
+ *
+ * @param[in] in input stream
+ * @param[out] out array of at least `n` values
+ * @param[in] n number of values to decode
+ *
+ * @return all values were decoded
+ * @retval true
+ * @retval false
+ *
+ * */
+bool BLINK_Compact_decodeU64Array(blink_stream_t in, uint64_t *out, size_t n);
+
+/**
+ * Decode an array of `i64`
+ *
+ * Signed counterpart of BLINK_Compact_decodeU64Array()
+ *
+ * @param[in] in input stream
+ * @param[out] out array of at least `n` values
+ * @param[in] n number of values to decode
+ *
+ * @return all values were decoded
+ * @retval true
+ * @retval false
+ *
+ * */
+bool BLINK_Compact_decodeI64Array(blink_stream_t in, int64_t *out, size_t n);
+
 /**
  * Decode a present field
  *
@@ -241,6 +282,109 @@ bool BLINK_Compact_decodeF64(blink_stream_t in, double *out, bool *isNull);
  * */
 bool BLINK_Compact_decodePresent(blink_stream_t in, bool *out);
 
+/**
+ * Number of bytes in a VLC given its first byte
+ *
+ * @param[in] first first byte of VLC
+ *
+ * @return size of VLC in bytes (including `first`)
+ * @retval 0 `first` cannot start a VLC (wider than 64 bits)
+ *
+ * */
+uint8_t BLINK_Compact_sizeofVLC(uint8_t first);
+
+/**
+ * Skip a VLC
+ *
+ * Skips any integer, `bool`, `enum`, `f64`, presence flag, or null.
+ *
+ * @param[in] in input stream
+ *
+ * @return value was skipped
+ * @retval true
+ * @retval false
+ *
+ * */
+bool BLINK_Compact_skipVLC(blink_stream_t in);
+
+/**
+ * Skip `string` or `binary`
+ *
+ * @param[in] in input stream
+ *
+ * @return value was skipped
+ * @retval true
+ * @retval false
+ *
+ * */
+bool BLINK_Compact_skipString(blink_stream_t in);
+
+/**
+ * Skip `fixed`
+ *
+ * @param[in] in input stream
+ * @param[in] size size attribute of field
+ * @param[in] isOptional field is optional (i.e. has a presence flag)
+ *
+ * @return value was skipped
+ * @retval true
+ * @retval false
+ *
+ * */
+bool BLINK_Compact_skipFixed(blink_stream_t in, uint32_t size, bool isOptional);
+
+/**
+ * Skip `decimal`
+ *
+ * @param[in] in input stream
+ *
+ * @return value was skipped
+ * @retval true
+ * @retval false
+ *
+ * */
+bool BLINK_Compact_skipDecimal(blink_stream_t in);
+
+/**
+ * Skip a dynamic group (or null) using its size preamble
+ *
+ * @param[in] in input stream
+ *
+ * @return value was skipped
+ * @retval true
+ * @retval false size preamble is zero (W1), or group overruns the input
+ *
+ * */
+bool BLINK_Compact_skipDynamicGroup(blink_stream_t in);
+
+/**
+ * Skip a field of any type
+ *
+ * Sequences, static groups, and dynamic groups are skipped as a whole.
+ *
+ * @param[in] in input stream
+ * @param[in] desc field descriptor (see BLINK_Group_getFieldDescs())
+ *
+ * @return field was skipped
+ * @retval true
+ * @retval false
+ *
+ * */
+bool BLINK_Compact_skipField(blink_stream_t in, const struct blink_field_desc *desc);
+
+/**
+ * Skip all fields of a static group
+ *
+ * @param[in] in input stream
+ * @param[in] group group definition
+ *
+ * @return group was skipped
+ * @retval true
+ * @retval false
+ *
+ * */
+bool BLINK_Compact_skipStaticGroup(blink_stream_t in, blink_schema_t group);
+
 /**
  * Encode `bool`
  *
@@ -0,0 +1,125 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+#ifndef BLINK_FD_H
+#define BLINK_FD_H
+
+/**
+ * @defgroup blink_fd blink_fd
+ * @ingroup ublink
+ *
+ * Buffered streams over file descriptors (files, pipes, and sockets).
+ *
+ * Reads are served from a read-ahead buffer which is refilled with one
+ * large `read()`, and writes are coalesced in a write buffer which is
+ * drained with one large `write()` when it fills up or when
+ * BLINK_Fd_flush() is called. Transfers larger than a buffer bypass it.
+ *
+ * The buffers are supplied by the caller. A stream can have either or
+ * both.
+ *
+ * @note requires POSIX `read()` and `write()` (define BLINK_NO_FILE to leave this module out)
+ *
+ * ### Example Workflow
+ *
+ * @code
+ * static uint8_t readAhead[65536U];
+ * static uint8_t coalesce[65536U];
+ *
+ * struct blink_fd fd;
+ * struct blink_stream stream;
+ *
+ * (void)BLINK_Fd_initStream(&fd, &stream, sock, readAhead, sizeof(readAhead), coalesce, sizeof(coalesce));
+ *
+ * blink_object_t group = BLINK_Object_decodeCompact(&stream, schema, &alloc);
+ *
+ * (void)BLINK_Object_encodeCompact(group, &stream);
+ *
+ * // nothing is written until the buffer fills or is flushed
+ * (void)BLINK_Fd_flush(&fd);
+ * @endcode
+ *
+ * @{
+ * */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ***********************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "blink_stream.h"
+
+/* types **************************************************************/
+
+struct blink_fd {
+    int fd;                 /**< file descriptor */
+    uint8_t *in;            /**< read-ahead buffer */
+    size_t inSize;          /**< size of `in` */
+    size_t inPos;           /**< next unread byte in `in` */
+    size_t inLen;           /**< bytes held in `in` */
+    uint8_t *out;           /**< write buffer */
+    size_t outSize;         /**< size of `out` */
+    size_t outLen;          /**< bytes waiting in `out` */
+    uint64_t pos;           /**< bytes read and written through the stream */
+    bool eof;               /**< end of input was reached */
+};
+
+/* function prototypes ************************************************/
+
+/** Initialise a buffered stream over a file descriptor
+ *
+ * @param[in] self
+ * @param[in] stream stream to initialise
+ * @param[in] fd file descriptor
+ * @param[in] readBuffer read-ahead buffer (NULL if stream is not read)
+ * @param[in] readSize size of `readBuffer`
+ * @param[in] writeBuffer write buffer (NULL if stream is not written)
+ * @param[in] writeSize size of `writeBuffer`
+ *
+ * @return stream
+ *
+ * */
+blink_stream_t BLINK_Fd_initStream(struct blink_fd *self, struct blink_stream *stream, int fd, void *readBuffer, size_t readSize, void *writeBuffer, size_t writeSize);
+
+/** Write all buffered bytes to the file descriptor
+ *
+ * Bytes that could not be written (e.g. `EAGAIN` on a non-blocking
+ * descriptor) stay buffered and are written by the next flush.
+ *
+ * @param[in] self
+ *
+ * @return true if all buffered bytes were written
+ *
+ * */
+bool BLINK_Fd_flush(struct blink_fd *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif
@@ -0,0 +1,125 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+#ifndef BLINK_FILE_H
+#define BLINK_FILE_H
+
+/**
+ * @defgroup blink_file blink_file
+ * @ingroup ublink
+ *
+ * Memory mapped files for reading large capture files.
+ *
+ * The whole file is mapped read-only with a sequential access hint and
+ * exposed as a read-only buffer stream, so decoders read (and borrow)
+ * directly from the page cache without copying.
+ *
+ * A stream may start at any offset into the file. The file offset of
+ * the next byte in the stream is `offset + BLINK_Stream_tell(stream)`.
+ *
+ * @note requires POSIX `mmap()` (define BLINK_NO_FILE to leave this module out)
+ *
+ * ### Example Workflow
+ *
+ * @code
+ * struct blink_file file;
+ * struct blink_stream stream;
+ *
+ * if(BLINK_File_map(&file, "session.blink")){
+ *
+ *     // NULL if the file is empty
+ *     if(BLINK_File_initStream(&file, &stream, 0U) != NULL){
+ *
+ *         while(BLINK_Stream_tell(&stream) < BLINK_Stream_max(&stream)){
+ *
+ *             blink_object_t group = BLINK_Object_decodeCompact(&stream, schema, &alloc);
+ *
+ *             ...
+ *         }
+ *     }
+ *
+ *     BLINK_File_unmap(&file);
+ * }
+ * @endcode
+ *
+ * @{
+ * */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ***********************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "blink_stream.h"
+
+/* types **************************************************************/
+
+struct blink_file {
+    const uint8_t *data;    /**< mapped file (NULL if file is empty) */
+    uint64_t size;          /**< size of file in bytes */
+};
+
+/* function prototypes ************************************************/
+
+/** Map a file into memory for reading
+ *
+ * @param[in] self
+ * @param[in] path null terminated path of file
+ *
+ * @return true if file was mapped
+ *
+ * */
+bool BLINK_File_map(struct blink_file *self, const char *path);
+
+/** Unmap a file mapped by BLINK_File_map()
+ *
+ * @warning streams initialised from the file and data borrowed from
+ * them become invalid
+ *
+ * @param[in] self
+ *
+ * */
+void BLINK_File_unmap(struct blink_file *self);
+
+/** Initialise a read-only buffer stream over a mapped file
+ *
+ * @param[in] self
+ * @param[in] stream stream to initialise
+ * @param[in] offset file offset of the first byte in the stream
+ *
+ * @return stream
+ *
+ * @retval NULL offset is at (or beyond) the end of the file
+ *
+ * */
+blink_stream_t BLINK_File_initStream(const struct blink_file *self, struct blink_stream *stream, uint64_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif
@@ -0,0 +1,188 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+#ifndef BLINK_FRAME_H
+#define BLINK_FRAME_H
+
+/**
+ * @defgroup blink_frame blink_frame
+ * @ingroup ublink
+ *
+ * Split a stream of concatenated compact form messages into frames.
+ *
+ * A frame is the size preamble, the group ID, and the body of one
+ * message. The frame reader finds frame boundaries without decoding the
+ * body. Input goes into a buffer supplied by the caller, either with
+ * BLINK_Frame_fill() from a stream, or with BLINK_Frame_reserve() and
+ * BLINK_Frame_commit() straight from `recv()`. A message which is split
+ * across two reads is kept in the buffer until the rest arrives.
+ *
+ * If the reader is given a schema, frames with group IDs not in the
+ * schema are skipped without being returned. A skipped frame may be
+ * larger than the buffer.
+ *
+ * ### Example Workflow
+ *
+ * @code
+ * static uint8_t buffer[65536U];
+ *
+ * struct blink_frame_reader reader;
+ * struct blink_frame frame;
+ * struct blink_stream body;
+ * size_t space;
+ * ssize_t n;
+ *
+ * BLINK_Frame_init(&reader, buffer, sizeof(buffer), schema);
+ *
+ * for(;;){
+ *
+ *     uint8_t *ptr = BLINK_Frame_reserve(&reader, &space);
+ *
+ *     n = recv(sock, ptr, space, 0);
+ *
+ *     BLINK_Frame_commit(&reader, (n > 0) ? (size_t)n : 0U);
+ *
+ *     while(BLINK_Frame_next(&reader, &frame) == BLINK_FRAME_OK){
+ *
+ *         // the whole frame can be decoded
+ *         blink_object_t group = BLINK_Object_decodeCompact(BLINK_Stream_initBufferReadOnly(&body, frame.data, frame.len), schema, &alloc);
+ *
+ *         // or just the body if frame.id is enough to know what to do
+ *     }
+ * }
+ * @endcode
+ *
+ * @{
+ * */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ***********************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "blink_stream.h"
+#include "blink_schema.h"
+
+/* types **************************************************************/
+
+/** one complete message */
+struct blink_frame {
+    const uint8_t *data;    /**< first byte of frame (the size preamble) */
+    size_t len;             /**< bytes in frame including size preamble */
+    uint32_t size;          /**< value of size preamble */
+    uint64_t id;            /**< group ID */
+    const uint8_t *body;    /**< first byte after group ID */
+    size_t bodyLen;         /**< bytes in body (including any extensions) */
+};
+
+enum blink_frame_status {
+    BLINK_FRAME_OK = 0,     /**< frame returned */
+    BLINK_FRAME_PARTIAL,    /**< more input is needed */
+    BLINK_FRAME_ERROR       /**< malformed preamble, or frame larger than buffer */
+};
+
+struct blink_frame_reader {
+    uint8_t *buf;           /**< input buffer */
+    size_t size;            /**< size of `buf` */
+    size_t start;           /**< first unread byte in `buf` */
+    size_t end;             /**< one past the last byte in `buf` */
+    uint64_t need;          /**< bytes needed before the next frame can be returned */
+    uint64_t discard;       /**< bytes still to be dropped from a skipped frame */
+    uint64_t skipped;       /**< number of frames skipped */
+    blink_schema_t schema;  /**< frames with IDs not in schema are skipped (may be NULL) */
+};
+
+/* function prototypes ************************************************/
+
+/** Initialise a frame reader
+ *
+ * @param[in] self
+ * @param[in] buffer input buffer (limits the largest frame that can be returned)
+ * @param[in] size size of `buffer`
+ * @param[in] schema skip frames with IDs not defined in this schema (may be NULL)
+ *
+ * */
+void BLINK_Frame_init(struct blink_frame_reader *self, void *buffer, size_t size, blink_schema_t schema);
+
+/** Get the next complete frame
+ *
+ * `frame` points into the input buffer. It remains valid until the
+ * next call to BLINK_Frame_reserve() or BLINK_Frame_fill().
+ *
+ * @param[in] self
+ * @param[out] frame
+ *
+ * @return status
+ *
+ * @retval BLINK_FRAME_OK frame is complete
+ * @retval BLINK_FRAME_PARTIAL buffer does not hold a complete frame
+ * @retval BLINK_FRAME_ERROR input cannot be framed (reader must be initialised again)
+ *
+ * */
+enum blink_frame_status BLINK_Frame_next(struct blink_frame_reader *self, struct blink_frame *frame);
+
+/** Get free space at the end of the input buffer
+ *
+ * Unread bytes are moved to the front of the buffer first.
+ *
+ * @param[in] self
+ * @param[out] space number of bytes that may be written
+ *
+ * @return pointer to free space
+ *
+ * */
+uint8_t *BLINK_Frame_reserve(struct blink_frame_reader *self, size_t *space);
+
+/** Add bytes written to space returned by BLINK_Frame_reserve()
+ *
+ * @param[in] self
+ * @param[in] nbyte number of bytes written
+ *
+ * */
+void BLINK_Frame_commit(struct blink_frame_reader *self, size_t nbyte);
+
+/** Read from a stream into the input buffer
+ *
+ * If the stream has a maximum (e.g. a buffer stream) as much as will fit
+ * is read. Otherwise only the bytes needed to make progress on the next
+ * frame are read, so that a stream is never read beyond the last
+ * complete frame.
+ *
+ * @param[in] self
+ * @param[in] in input stream
+ *
+ * @return true if any bytes were read
+ *
+ * */
+bool BLINK_Frame_fill(struct blink_frame_reader *self, blink_stream_t in);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif
@@ -0,0 +1,132 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+#ifndef BLINK_IOVEC_H
+#define BLINK_IOVEC_H
+
+/**
+ * @defgroup blink_iovec blink_iovec
+ * @ingroup ublink
+ *
+ * Gather output streams flushed with `writev()`.
+ *
+ * A gather stream collects output as a list of segments. Small writes
+ * are copied into a coalescing buffer. Writes made with
+ * BLINK_Stream_writeRef() of at least `threshold` bytes are recorded
+ * as a reference to the caller's memory. BLINK_IOVec_flush() then sends
+ * every segment with as few `writev()` calls as possible.
+ *
+ * BLINK_Object_encodeCompact() writes string and binary values by
+ * reference. A batch of messages can therefore be encoded straight to
+ * the gather stream, and large payloads are never copied.
+ *
+ * @note requires POSIX `writev()` (define BLINK_NO_FILE to leave this module out)
+ *
+ * ### Example Workflow
+ *
+ * @code
+ * static struct iovec iov[64U];
+ * static uint8_t coalesce[4096U];
+ *
+ * struct blink_iovec gather;
+ * struct blink_stream stream;
+ *
+ * (void)BLINK_IOVec_initStream(&gather, &stream, sock, iov, 64U, coalesce, sizeof(coalesce), 256U);
+ *
+ * for(i=0U; i < n; i++){
+ *
+ *     (void)BLINK_Object_encodeCompact(batch[i], &stream);
+ * }
+ *
+ * // batch must not be modified until after flush
+ * (void)BLINK_IOVec_flush(&gather);
+ * @endcode
+ *
+ * @{
+ * */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ***********************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/uio.h>
+
+#include "blink_stream.h"
+
+/* types **************************************************************/
+
+struct blink_iovec {
+    int fd;                 /**< file descriptor */
+    struct iovec *iov;      /**< segments */
+    size_t iovMax;          /**< size of `iov` */
+    size_t iovCount;        /**< segments waiting in `iov` */
+    uint8_t *buf;           /**< coalescing buffer */
+    size_t bufSize;         /**< size of `buf` */
+    size_t bufLen;          /**< bytes held in `buf` */
+    size_t threshold;       /**< smallest write that is referenced rather than copied */
+    uint64_t pos;           /**< bytes written through the stream */
+    uint64_t sent;          /**< bytes written to the file descriptor */
+};
+
+/* function prototypes ************************************************/
+
+/** Initialise a gather output stream over a file descriptor
+ *
+ * @param[in] self
+ * @param[in] stream stream to initialise
+ * @param[in] fd file descriptor
+ * @param[in] iov segment array
+ * @param[in] iovMax number of elements in `iov` (at least one)
+ * @param[in] buffer coalescing buffer
+ * @param[in] bufferSize size of `buffer`
+ * @param[in] threshold smallest BLINK_Stream_writeRef() which is referenced
+ *
+ * @return stream
+ *
+ * */
+blink_stream_t BLINK_IOVec_initStream(struct blink_iovec *self, struct blink_stream *stream, int fd, struct iovec *iov, size_t iovMax, void *buffer, size_t bufferSize, size_t threshold);
+
+/** Write all segments to the file descriptor
+ *
+ * All references held by the stream are released if successful.
+ * Otherwise (e.g. `EAGAIN` on a non-blocking descriptor) the bytes that
+ * were not written stay queued, along with their references, for the
+ * next flush. `sent` counts the bytes written so far.
+ *
+ * @param[in] self
+ *
+ * @return true if all segments were written
+ *
+ * */
+bool BLINK_IOVec_flush(struct blink_iovec *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif
@@ -0,0 +1,823 @@
+/* Copyright (c) 2016 Cameron Harper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * */
+
+#ifndef BLINK_MESSAGE_HPP
+#define BLINK_MESSAGE_HPP
+
+/**
+ * @defgroup blink_message blink_message
+ * @ingroup ublink
+ *
+ * Header only C++ (C++14) typed messages.
+ *
+ * A message is declared as a list of field types. Each field type names
+ * its wire type, and field values are stored at fixed positions within
+ * the message object. Field lookup, encoding, and decoding are resolved
+ * at compile time and use the blink_compact primitives directly, so no
+ * schema or blink_object is involved at run time.
+ *
+ * ## Example
+ *
+ * The equivalent of:
+ *
+ * @code
+ * Leg ->
+ *    u32 Qty
+ *
+ * InsertOrder/1 ->
+ *    string Symbol,
+ *    u32 Price?,
+ *    Leg [] Legs
+ * @endcode
+ *
+ * is declared like so:
+ *
+ * @code
+ * struct Qty : blink::Field<blink::U32> {};
+ * using Leg = blink::Group<Qty>;
+ *
+ * struct Symbol : blink::Field<blink::String> {};
+ * struct Price : blink::Field<blink::Optional<blink::U32>> {};
+ * struct Legs : blink::Field<blink::Sequence<Leg>> {};
+ * using InsertOrder = blink::Message<1U, Symbol, Price, Legs>;
+ * @endcode
+ *
+ * and then used like so:
+ *
+ * @code
+ * InsertOrder order;
+ *
+ * order.set<Symbol>("IBM");
+ * order.set<Price>(125U);
+ * order.ref<Legs>().resize(1U);
+ * order.ref<Legs>()[0].set<Qty>(100U);
+ *
+ * (void)order.encodeCompact(out);
+ *
+ * // decoding into an existing message reuses string and sequence storage
+ * (void)order.decodeCompact(in);
+ * @endcode
+ *
+ * Dynamic group fields (blink::Dynamic) refer to exactly one message type.
+ * The `object` type is not supported.
+ *
+ * @{
+ * */
+
+/* includes ***********************************************************/
+
+#include "blink_stream.h"
+#include "blink_compact.h"
+
+#include <array>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
+
+namespace blink {
+
+/* wire types *********************************************************/
+
+struct String {};           /**< `string` */
+struct Binary {};           /**< `binary` */
+template<uint32_t N>
+struct Fixed {};            /**< `fixed(N)` */
+struct Bool {};             /**< `bool` */
+struct U8 {};               /**< `u8` */
+struct U16 {};              /**< `u16` */
+struct U32 {};              /**< `u32` */
+struct U64 {};              /**< `u64` */
+struct I8 {};               /**< `i8` */
+struct I16 {};              /**< `i16` */
+struct I32 {};              /**< `i32` */
+struct I64 {};              /**< `i64` */
+struct F64 {};              /**< `f64` */
+struct Decimal {};          /**< `decimal` */
+struct Date {};             /**< `date` */
+struct TimeOfDayMilli {};   /**< `timeOfDayMilli` */
+struct TimeOfDayNano {};    /**< `timeOfDayNano` */
+struct NanoTime {};         /**< `nanotime` */
+struct MilliTime {};        /**< `millitime` */
+template<typename E>
+struct Enum {};             /**< enum (E is a C++ enum type) */
+template<typename T>
+struct Sequence {};         /**< `T []` */
+template<typename T>
+struct Optional {};         /**< `T ?` */
+template<typename M>
+struct Dynamic {};          /**< `M*` (M is a blink::Message) */
+
+/** decimal value */
+struct DecimalValue {
+    int64_t mantissa;
+    int8_t exponent;
+};
+
+/** Base of every field declaration
+ *
+ * @tparam T wire type
+ *
+ * */
+template<typename T>
+struct Field {
+    using type = T;
+};
+
+template<typename T>
+struct Traits;
+
+/* implementation *****************************************************/
+
+namespace detail {
+
+    /* bytes that could remain in `in` (streams without a maximum are unlimited) */
+    inline uint32_t remaining(blink_stream_t in)
+    {
+        uint64_t max = BLINK_Stream_max(in);
+        uint64_t retval = (max == 0U) ? UINT32_MAX : (max - BLINK_Stream_tell(in));
+
+        return (retval < UINT32_MAX) ? (uint32_t)retval : UINT32_MAX;
+    }
+
+    template<typename T>
+    struct Strip {
+        using type = T;
+        static constexpr bool optional = false;
+    };
+
+    template<typename T>
+    struct Strip<Optional<T>> {
+        using type = T;
+        static constexpr bool optional = true;
+    };
+
+    template<typename F, typename... Fs>
+    struct IndexOf;
+
+    template<typename F, typename... Rest>
+    struct IndexOf<F, F, Rest...> : std::integral_constant<size_t, 0U> {};
+
+    template<typename F, typename G, typename... Rest>
+    struct IndexOf<F, G, Rest...> : std::integral_constant<size_t, 1U + IndexOf<F, Rest...>::value> {};
+
+    template<typename F>
+    struct IndexOf<F> {
+        static_assert(sizeof(F) == 0U, "field is not a member of this group");
+    };
+
+    /** storage for one field */
+    template<typename T>
+    struct Slot {
+        typename Traits<T>::value_type value;
+
+        bool present() const { return true; }
+        void mark() {}
+        void clear() {}
+
+        bool decode(blink_stream_t in)
+        {
+            bool isNull;
+
+            return Traits<T>::decode(in, value, isNull) && !isNull;
+        }
+
+        bool encode(blink_stream_t out) const
+        {
+            return Traits<T>::encode(value, out);
+        }
+
+        uint32_t size() const
+        {
+            return Traits<T>::size(value);
+        }
+    };
+
+    /* Optional values are NULL when absent, except for fixed and static
+     * group values which are preceded by a presence flag */
+    template<typename T>
+    struct Slot<Optional<T>> {
+        typename Traits<T>::value_type value;
+        bool isPresent = false;
+
+        bool present() const { return isPresent; }
+        void mark() { isPresent = true; }
+        void clear() { isPresent = false; }
+
+        bool decode(blink_stream_t in)
+        {
+            bool isNull = false;
+            bool retval;
+
+            if(Traits<T>::nullable){
+
+                retval = Traits<T>::decode(in, value, isNull);
+                isPresent = !isNull;
+            }
+            else{
+
+                retval = BLINK_Compact_decodePresent(in, &isPresent) && (!isPresent || Traits<T>::decode(in, value, isNull));
+            }
+
+            return retval;
+        }
+
+        bool encode(blink_stream_t out) const
+        {
+            if(!isPresent){
+
+                return BLINK_Compact_encodeNull(out);
+            }
+
+            return (Traits<T>::nullable || BLINK_Compact_encodePresent(out)) && Traits<T>::encode(value, out);
+        }
+
+        uint32_t size() const
+        {
+            return (isPresent) ? ((Traits<T>::nullable ? 0U : 1U) + Traits<T>::size(value)) : 1U;
+        }
+    };
+
+    /* the VLC primitives are the same shape for every integer type */
+    template<typename V, bool (*Decode)(blink_stream_t, V *, bool *), bool (*Encode)(V, blink_stream_t), bool Signed>
+    struct IntegerTraits {
+        using value_type = V;
+        static constexpr bool nullable = true;
+
+        static bool decode(blink_stream_t in, V &value, bool &isNull)
+        {
+            return Decode(in, &value, &isNull);
+        }
+
+        static bool encode(V value, blink_stream_t out)
+        {
+            return Encode(value, out);
+        }
+
+        static uint32_t size(V value)
+        {
+            return Signed ? BLINK_Compact_sizeofSigned((int64_t)value) : BLINK_Compact_sizeofUnsigned((uint64_t)value);
+        }
+    };
+
+    template<typename T>
+    struct BytesTraits {
+        using value_type = std::string;
+        static constexpr bool nullable = true;
+
+        /* string capacity is reused when decoding into an existing message */
+        static bool decode(blink_stream_t in, std::string &value, bool &isNull)
+        {
+            uint32_t size;
+
+            if(!BLINK_Compact_decodeU32(in, &size, &isNull)){
+
+                return false;
+            }
+
+            if(isNull){
+
+                return true;
+            }
+
+            if(size > remaining(in)){
+
+                return false;
+            }
+
+            if(BLINK_Stream_canBorrow(in)){
+
+                const uint8_t *data = BLINK_Stream_borrow(in, size);
+
+                if(data == NULL){
+
+                    return false;
+                }
+
+                value.assign((const char *)data, size);
+
+                return true;
+            }
+
+            value.resize(size);
+
+            return (size == 0U) || BLINK_Stream_read(in, &value[0], size);
+        }
+
+        static bool encode(const std::string &value, blink_stream_t out)
+        {
+            return BLINK_Compact_encodeU32((uint32_t)value.size(), out) && BLINK_Stream_write(out, value.data(), value.size());
+        }
+
+        static uint32_t size(const std::string &value)
+        {
+            return BLINK_Compact_sizeofUnsigned(value.size()) + (uint32_t)value.size();
+        }
+    };
+
+    template<typename Tuple, typename Fn, size_t... I>
+    inline bool all(Tuple &values, Fn fn, std::index_sequence<I...>)
+    {
+        bool retval = true;
+
+        (void)std::initializer_list<int>{((retval = retval && fn(std::get<I>(values))), 0)...};
+
+        return retval;
+    }
+
+    template<typename Tuple, size_t... I>
+    inline uint32_t sum(const Tuple &values, std::index_sequence<I...>)
+    {
+        uint32_t retval = 0U;
+
+        (void)std::initializer_list<int>{((retval += std::get<I>(values).size()), 0)...};
+
+        return retval;
+    }
+}
+
+/* groups *************************************************************/
+
+/** A group without an ID (i.e. one that can only be used as a static group)
+ *
+ * @tparam Fields field declarations (types derived from blink::Field) in encoding order
+ *
+ * */
+template<typename... Fields>
+class Group {
+
+    using Values = std::tuple<detail::Slot<typename Fields::type>...>;
+
+    template<typename F>
+    using Slot = typename std::tuple_element<detail::IndexOf<F, Fields...>::value, Values>::type;
+
+public:
+
+    /** value type of a field */
+    template<typename F>
+    using value_type = typename Traits<typename detail::Strip<typename F::type>::type>::value_type;
+
+    /** Get field value
+     *
+     * @tparam F field
+     * @return value (undefined if optional field is not present)
+     *
+     * */
+    template<typename F>
+    const value_type<F> &get() const
+    {
+        return std::get<detail::IndexOf<F, Fields...>::value>(values).value;
+    }
+
+    /** Get a modifiable reference to field value
+     *
+     * An optional field becomes present.
+     *
+     * @tparam F field
+     * @return value
+     *
+     * */
+    template<typename F>
+    value_type<F> &ref()
+    {
+        Slot<F> &slot = std::get<detail::IndexOf<F, Fields...>::value>(values);
+
+        slot.mark();
+
+        return slot.value;
+    }
+
+    /** Set field value
+     *
+     * @tparam F field
+     * @param[in] value
+     *
+     * */
+    template<typename F, typename V>
+    void set(V &&value)
+    {
+        ref<F>() = std::forward<V>(value);
+    }
+
+    /** Discover if field is present
+     *
+     * @tparam F field
+     * @return true if present (always true for required fields)
+     *
+     * */
+    template<typename F>
+    bool has() const
+    {
+        return std::get<detail::IndexOf<F, Fields...>::value>(values).present();
+    }
+
+    /** Make an optional field absent
+     *
+     * @tparam F field
+     *
+     * */
+    template<typename F>
+    void clear()
+    {
+        static_assert(detail::Strip<typename F::type>::optional, "field is not optional");
+
+        std::get<detail::IndexOf<F, Fields...>::value>(values).clear();
+    }
+
+    /** @return encoded size of fields */
+    uint32_t sizeofBody() const
+    {
+        return detail::sum(values, std::index_sequence_for<Fields...>());
+    }
+
+    /** Encode fields
+     *
+     * @param[in] out output stream
+     * @return true if successful
+     *
+     * */
+    bool encodeBody(blink_stream_t out) const
+    {
+        return detail::all(values, [out](const auto &slot){ return slot.encode(out); }, std::index_sequence_for<Fields...>());
+    }
+
+    /** Decode fields
+     *
+     * @param[in] in input stream
+     * @return true if successful
+     *
+     * */
+    bool decodeBody(blink_stream_t in)
+    {
+        return detail::all(values, [in](auto &slot){ return slot.decode(in); }, std::index_sequence_for<Fields...>());
+    }
+
+private:
+
+    Values values;
+};
+
+/** A group with an ID
+ *
+ * @tparam ID group ID
+ * @tparam Fields field declarations (types derived from blink::Field) in encoding order
+ *
+ * */
+template<uint64_t ID, typename... Fields>
+class Message : public Group<Fields...> {
+
+public:
+
+    static constexpr uint64_t id = ID;
+
+    /** Encode as a top level group
+     *
+     * @param[in] out output stream
+     * @return true if successful
+     *
+     * */
+    bool encodeCompact(blink_stream_t out) const
+    {
+        uint32_t size = BLINK_Compact_sizeofUnsigned(ID) + this->sizeofBody();
+
+        return BLINK_Compact_encodeU32(size, out) && BLINK_Compact_encodeU64(ID, out) && this->encodeBody(out);
+    }
+
+    /** Decode a top level group
+     *
+     * Storage already held by string and sequence fields is reused.
+     *
+     * @param[in] in input stream
+     * @return true if successful
+     *
+     * */
+    bool decodeCompact(blink_stream_t in)
+    {
+        bool isNull;
+
+        return Traits<Dynamic<Message>>::decode(in, *this, isNull) && !isNull;
+    }
+};
+
+/* traits *************************************************************/
+
+/** Wire type traits
+ *
+ * The primary template handles static groups (blink::Group and blink::Message).
+ *
+ * */
+template<typename T>
+struct Traits {
+    using value_type = T;
+    static constexpr bool nullable = false;
+
+    static bool decode(blink_stream_t in, T &value, bool &isNull)
+    {
+        isNull = false;
+
+        return value.decodeBody(in);
+    }
+
+    static bool encode(const T &value, blink_stream_t out)
+    {
+        return value.encodeBody(out);
+    }
+
+    static uint32_t size(const T &value)
+    {
+        return value.sizeofBody();
+    }
+};
+
+template<> struct Traits<U8> : detail::IntegerTraits<uint8_t, BLINK_Compact_decodeU8, BLINK_Compact_encodeU8, false> {};
+template<> struct Traits<U16> : detail::IntegerTraits<uint16_t, BLINK_Compact_decodeU16, BLINK_Compact_encodeU16, false> {};
+template<> struct Traits<U32> : detail::IntegerTraits<uint32_t, BLINK_Compact_decodeU32, BLINK_Compact_encodeU32, false> {};
+template<> struct Traits<U64> : detail::IntegerTraits<uint64_t, BLINK_Compact_decodeU64, BLINK_Compact_encodeU64, false> {};
+template<> struct Traits<I8> : detail::IntegerTraits<int8_t, BLINK_Compact_decodeI8, BLINK_Compact_encodeI8, true> {};
+template<> struct Traits<I16> : detail::IntegerTraits<int16_t, BLINK_Compact_decodeI16, BLINK_Compact_encodeI16, true> {};
+template<> struct Traits<I32> : detail::IntegerTraits<int32_t, BLINK_Compact_decodeI32, BLINK_Compact_encodeI32, true> {};
+template<> struct Traits<I64> : detail::IntegerTraits<int64_t, BLINK_Compact_decodeI64, BLINK_Compact_encodeI64, true> {};
+template<> struct Traits<Date> : Traits<I32> {};
+template<> struct Traits<TimeOfDayMilli> : Traits<U32> {};
+template<> struct Traits<TimeOfDayNano> : Traits<U64> {};
+template<> struct Traits<NanoTime> : Traits<I64> {};
+template<> struct Traits<MilliTime> : Traits<I64> {};
+template<> struct Traits<String> : detail::BytesTraits<String> {};
+template<> struct Traits<Binary> : detail::BytesTraits<Binary> {};
+
+template<>
+struct Traits<Bool> {
+    using value_type = bool;
+    static constexpr bool nullable = true;
+
+    /* also accepts std::vector<bool>::reference */
+    template<typename R>
+    static bool decode(blink_stream_t in, R &&value, bool &isNull)
+    {
+        bool b = false;
+        bool retval = BLINK_Compact_decodeBool(in, &b, &isNull);
+
+        value = b;
+
+        return retval;
+    }
+
+    static bool encode(bool value, blink_stream_t out)
+    {
+        return BLINK_Compact_encodeBool(value, out);
+    }
+
+    static uint32_t size(bool value)
+    {
+        (void)value;
+
+        return 1U;
+    }
+};
+
+template<>
+struct Traits<F64> {
+    using value_type = double;
+    static constexpr bool nullable = true;
+
+    static bool decode(blink_stream_t in, double &value, bool &isNull)
+    {
+        return BLINK_Compact_decodeF64(in, &value, &isNull);
+    }
+
+    static bool encode(double value, blink_stream_t out)
+    {
+        return BLINK_Compact_encodeF64(value, out);
+    }
+
+    static uint32_t size(double value)
+    {
+        uint64_t bits;
+
+        (void)std::memcpy(&bits, &value, sizeof(bits));
+
+        return BLINK_Compact_sizeofUnsigned(bits);
+    }
+};
+
+template<>
+struct Traits<Decimal> {
+    using value_type = DecimalValue;
+    static constexpr bool nullable = true;
+
+    static bool decode(blink_stream_t in, DecimalValue &value, bool &isNull)
+    {
+        return BLINK_Compact_decodeDecimal(in, &value.mantissa, &value.exponent, &isNull);
+    }
+
+    static bool encode(const DecimalValue &value, blink_stream_t out)
+    {
+        return BLINK_Compact_encodeDecimal(value.mantissa, value.exponent, out);
+    }
+
+    static uint32_t size(const DecimalValue &value)
+    {
+        return BLINK_Compact_sizeofSigned(value.exponent) + BLINK_Compact_sizeofSigned(value.mantissa);
+    }
+};
+
+template<uint32_t N>
+struct Traits<Fixed<N>> {
+    using value_type = std::array<uint8_t, N>;
+    static constexpr bool nullable = false;
+
+    static bool decode(blink_stream_t in, value_type &value, bool &isNull)
+    {
+        isNull = false;
+
+        return BLINK_Stream_read(in, value.data(), N);
+    }
+
+    static bool encode(const value_type &value, blink_stream_t out)
+    {
+        return BLINK_Stream_write(out, value.data(), N);
+    }
+
+    static uint32_t size(const value_type &value)
+    {
+        (void)value;
+
+        return N;
+    }
+};
+
+template<typename E>
+struct Traits<Enum<E>> {
+    using value_type = E;
+    static constexpr bool nullable = true;
+
+    static bool decode(blink_stream_t in, E &value, bool &isNull)
+    {
+        int32_t v;
+        bool retval = BLINK_Compact_decodeI32(in, &v, &isNull);
+
+        if(retval && !isNull){
+
+            value = static_cast<E>(v);
+        }
+
+        return retval;
+    }
+
+    static bool encode(E value, blink_stream_t out)
+    {
+        return BLINK_Compact_encodeI32(static_cast<int32_t>(value), out);
+    }
+
+    static uint32_t size(E value)
+    {
+        return BLINK_Compact_sizeofSigned(static_cast<int32_t>(value));
+    }
+};
+
+template<typename T>
+struct Traits<Sequence<T>> {
+    using value_type = std::vector<typename Traits<T>::value_type>;
+    static constexpr bool nullable = true;
+
+    /* element capacity is reused when decoding into an existing message */
+    static bool decode(blink_stream_t in, value_type &value, bool &isNull)
+    {
+        uint32_t n;
+        bool elemIsNull;
+        uint32_t i;
+
+        if(!BLINK_Compact_decodeU32(in, &n, &isNull)){
+
+            return false;
+        }
+
+        if(isNull){
+
+            return true;
+        }
+
+        /* every element occupies at least one byte */
+        if(n > detail::remaining(in)){
+
+            return false;
+        }
+
+        value.resize(n);
+
+        for(i=0U; i < n; i++){
+
+            if(!Traits<T>::decode(in, value[i], elemIsNull) || elemIsNull){
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static bool encode(const value_type &value, blink_stream_t out)
+    {
+        if(!BLINK_Compact_encodeU32((uint32_t)value.size(), out)){
+
+            return false;
+        }
+
+        for(const auto &elem : value){
+
+            if(!Traits<T>::encode(elem, out)){
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static uint32_t size(const value_type &value)
+    {
+        uint32_t retval = BLINK_Compact_sizeofUnsigned(value.size());
+
+        for(const auto &elem : value){
+
+            retval += Traits<T>::size(elem);
+        }
+
+        return retval;
+    }
+};
+
+template<typename M>
+struct Traits<Dynamic<M>> {
+    using value_type = M;
+    static constexpr bool nullable = true;
+
+    /* extensions are not supported */
+    static bool decode(blink_stream_t in, M &value, bool &isNull)
+    {
+        struct blink_stream bounded;
+        uint32_t size;
+        uint64_t id;
+
+        if(!BLINK_Compact_decodeU32(in, &size, &isNull)){
+
+            return false;
+        }
+
+        if(isNull){
+
+            return true;
+        }
+
+        if((size == 0U) || (size > detail::remaining(in))){
+
+            return false;
+        }
+
+        (void)BLINK_Stream_initBounded(&bounded, in, size);
+
+        return BLINK_Compact_decodeU64(&bounded, &id, &isNull) && !isNull && (id == M::id) && value.decodeBody(&bounded) && (BLINK_Stream_tell(&bounded) == size);
+    }
+
+    static bool encode(const M &value, blink_stream_t out)
+    {
+        uint32_t size = BLINK_Compact_sizeofUnsigned(M::id) + value.sizeofBody();
+
+        return BLINK_Compact_encodeU32(size, out) && BLINK_Compact_encodeU64(M::id, out) && value.encodeBody(out);
+    }
+
+    static uint32_t size(const M &value)
+    {
+        uint32_t size = BLINK_Compact_sizeofUnsigned(M::id) + value.sizeofBody();
+
+        return BLINK_Compact_sizeofUnsigned(size) + size;
+    }
+};
+
+}
+
+/** @} */
+#endif
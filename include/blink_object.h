@@ -50,6 +50,44 @@ typedef struct blink_object * blink_object_t;
 typedef struct blink_stream * blink_stream_t;
 typedef struct blink_schema * blink_schema_t;
 
+#ifndef BLINK_OBJECT_MASK_FIELDS
+    /** a field mask can select from groups with up to this many fields (including inherited fields) */
+    #define BLINK_OBJECT_MASK_FIELDS 64U
+#endif
+
+/** selects the fields of a group to decode (see BLINK_Object_initMask()) */
+struct blink_field_mask {
+    blink_schema_t group;                                       /**< group definition */
+    uint8_t selected[(BLINK_OBJECT_MASK_FIELDS + 7U) / 8U];     /**< bit `i` selects field `i` (see BLINK_Field_getIndex()) */
+};
+
+/** options for BLINK_Object_decodeCompactWithOptions() */
+struct blink_decode_options {
+
+    /** Reference string, binary, and fixed values in the input buffer
+     * instead of copying them
+     *
+     * Only takes effect when the input stream can borrow
+     * (see BLINK_Stream_canBorrow()), otherwise values are copied as
+     * normal.
+     *
+     * @warning the input buffer must remain valid and unmodified for the
+     * lifetime of the decoded object
+     *
+     * */
+    bool zeroCopy;
+
+    /** Decode only the fields selected by this mask (NULL to decode all fields)
+     *
+     * Applies when the top level group is `mask->group`. Unselected
+     * fields, including nested groups and sequences, are skipped
+     * without allocating or converting them and are left null. Other
+     * groups are decoded in full.
+     *
+     * */
+    const struct blink_field_mask *mask;
+};
+
 /* functions **********************************************************/
 
 /** Create a new group model from a group definition
@@ -71,6 +109,16 @@ blink_object_t BLINK_Object_newGroup(const struct blink_allocator *alloc, blink_
  * */
 void BLINK_Object_destroyGroup(blink_object_t *group);
 
+/** Clear all fields of an existing group model
+ *
+ * String buffers, sequence storage, and nested groups are retained
+ * so that they can be reused by later writes or decodes.
+ *
+ * @param[in] group
+ *
+ * */
+void BLINK_Object_reset(blink_object_t group);
+
 /** Clear a field (i.e. set to NULL)
  *
  * @param[in] group
@@ -324,9 +372,808 @@ blink_object_t BLINK_Object_getGroup(blink_object_t group, const char *fieldName
  * */
 blink_schema_t BLINK_Object_getFieldDefinition(blink_object_t group, const char *fieldName);
 
-bool BLINK_Object_encodeCompact(blink_object_t group, blink_stream_t out);
+/* The following functions take a field definition in place of a field
+ * name. Resolving the name once with BLINK_Group_getFieldByName() and
+ * reusing the definition avoids a name lookup on every access. A field
+ * definition may be used with objects of the declaring group or any
+ * of its subgroups. */
 
-blink_object_t BLINK_Object_decodeCompact(blink_stream_t in, blink_schema_t schema, const struct blink_allocator *alloc);
+/** Clear a field (i.e. set to NULL)
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_clearByField(blink_object_t group, blink_schema_t field);
+
+/** Test if a field value is NULL
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * @return true if field value is NULL
+ *
+ * */
+bool BLINK_Object_fieldIsNullByField(blink_object_t group, blink_schema_t field);
+
+/** Write enum to field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] symbol symbol definition (e.g. from BLINK_Enum_getSymbolByName())
+ *
+ * @return true if successful
+ *
+ * @retval false `symbol` is not a symbol of the enum referenced by `field`
+ *
+ * */
+bool BLINK_Object_setEnumByField(blink_object_t group, blink_schema_t field, blink_schema_t symbol);
+
+/** Write boolean to field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] value boolean
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setBoolByField(blink_object_t group, blink_schema_t field, bool value);
+
+/** Write decimal to field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] mantissa
+ * @param[in] exponent
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setDecimalByField(blink_object_t group, blink_schema_t field, int64_t mantissa, int8_t exponent);
+
+/** Write an unsigned integer to field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] value
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setUintByField(blink_object_t group, blink_schema_t field, uint64_t value);
+
+/** Write a signed integer to field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] value
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setIntByField(blink_object_t group, blink_schema_t field, int64_t value);
+
+/** Write f64 to field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] value f64
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setF64ByField(blink_object_t group, blink_schema_t field, double value);
+
+/** Write string to field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] str
+ * @param[in] len byte length of str
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setStringByField(blink_object_t group, blink_schema_t field, const char *str, uint32_t len);
+
+/** Write binary to field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] data
+ * @param[in] len byte length of data
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setBinaryByField(blink_object_t group, blink_schema_t field, const uint8_t *data, uint32_t len);
+
+/** Write fixed to field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] data
+ * @param[in] len byte length of data
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setFixedByField(blink_object_t group, blink_schema_t field, const uint8_t *data, uint32_t len);
+
+/** Write group to field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] value group
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setGroupByField(blink_object_t group, blink_schema_t field, blink_object_t value);
+
+/** Read enum from field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * @return pointer to enum string
+ *
+ * */
+const char *BLINK_Object_getEnumByField(blink_object_t group, blink_schema_t field);
+
+/** Read boolean from field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * @return boolean
+ *
+ * */
+bool BLINK_Object_getBoolByField(blink_object_t group, blink_schema_t field);
+
+/** Read decimal from field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[out] mantissa
+ * @param[out] exponent
+ *
+ * */
+void BLINK_Object_getDecimalByField(blink_object_t group, blink_schema_t field, int64_t *mantissa, int8_t *exponent);
+
+/** Read Uint from field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * @return uint
+ *
+ * */
+uint64_t BLINK_Object_getUintByField(blink_object_t group, blink_schema_t field);
+
+/** Read Int from field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * @return int
+ *
+ * */
+int64_t BLINK_Object_getIntByField(blink_object_t group, blink_schema_t field);
+
+/** Read f64 from field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * @return f64
+ *
+ * */
+double BLINK_Object_getF64ByField(blink_object_t group, blink_schema_t field);
+
+/** Read string from field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * */
+void BLINK_Object_getStringByField(blink_object_t group, blink_schema_t field, const char **str, uint32_t *len);
+
+/** Read binary from field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * */
+void BLINK_Object_getBinaryByField(blink_object_t group, blink_schema_t field, const uint8_t **data, uint32_t *len);
+
+/** Read fixed from field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * */
+void BLINK_Object_getFixedByField(blink_object_t group, blink_schema_t field, const uint8_t **data, uint32_t *len);
+
+/** Read group from field
+ *
+ * @param[in] group
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * @return group
+ *
+ * */
+blink_object_t BLINK_Object_getGroupByField(blink_object_t group, blink_schema_t field);
+
+/* The following functions operate on sequence fields. Elements are
+ * stored contiguously and are numbered from zero. Appending to a NULL
+ * sequence makes it an empty sequence first. */
+
+/** Get the number of elements in a sequence field
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * @return number of elements (zero if sequence is NULL)
+ *
+ * */
+uint32_t BLINK_Object_getSequenceSizeByField(blink_object_t group, blink_schema_t field);
+
+/** Reserve storage for a sequence field
+ *
+ * Appending up to `capacity` elements will not allocate. Does not
+ * change the number of elements.
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] capacity number of elements
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_reserveByField(blink_object_t group, blink_schema_t field, uint32_t capacity);
+
+/** Make a sequence field empty (i.e. zero elements but not NULL)
+ *
+ * Storage is retained for reuse. Use BLINK_Object_clearByField() to set
+ * the sequence to NULL.
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_clearSequenceByField(blink_object_t group, blink_schema_t field);
+
+/** Append an array of booleans to sequence field
+ *
+ * The sequence grows once to fit all `n` values.
+ *
+ * @note field type must be #BLINK_TYPE_BOOL
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] values array of `n` values
+ * @param[in] n number of values
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendBoolsByField(blink_object_t group, blink_schema_t field, const bool *values, uint32_t n);
+
+/** Append an array of unsigned integers to sequence field
+ *
+ * The sequence grows once to fit all `n` values.
+ *
+ * @note field type must be an unsigned integer or time of day type
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] values array of `n` values
+ * @param[in] n number of values
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendUintsByField(blink_object_t group, blink_schema_t field, const uint64_t *values, uint32_t n);
+
+/** Append an array of signed integers to sequence field
+ *
+ * The sequence grows once to fit all `n` values.
+ *
+ * @note field type must be a signed integer, date, time, or enum type
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] values array of `n` values
+ * @param[in] n number of values
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendIntsByField(blink_object_t group, blink_schema_t field, const int64_t *values, uint32_t n);
+
+/** Append an array of f64s to sequence field
+ *
+ * The sequence grows once to fit all `n` values.
+ *
+ * @note field type must be #BLINK_TYPE_F64
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] values array of `n` values
+ * @param[in] n number of values
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendF64sByField(blink_object_t group, blink_schema_t field, const double *values, uint32_t n);
+
+/** Append boolean to sequence field
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] value boolean
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendBoolByField(blink_object_t group, blink_schema_t field, bool value);
+
+/** Append decimal to sequence field
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] mantissa
+ * @param[in] exponent
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendDecimalByField(blink_object_t group, blink_schema_t field, int64_t mantissa, int8_t exponent);
+
+/** Append an unsigned integer to sequence field
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] value
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendUintByField(blink_object_t group, blink_schema_t field, uint64_t value);
+
+/** Append a signed integer to sequence field
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] value
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendIntByField(blink_object_t group, blink_schema_t field, int64_t value);
+
+/** Append f64 to sequence field
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] value
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendF64ByField(blink_object_t group, blink_schema_t field, double value);
+
+/** Append string to sequence field
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] str pointer to string
+ * @param[in] len length of string
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendStringByField(blink_object_t group, blink_schema_t field, const char *str, uint32_t len);
+
+/** Append binary to sequence field
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] data pointer to binary
+ * @param[in] len length of binary
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendBinaryByField(blink_object_t group, blink_schema_t field, const uint8_t *data, uint32_t len);
+
+/** Append fixed to sequence field
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] data pointer to fixed
+ * @param[in] len length of fixed
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendFixedByField(blink_object_t group, blink_schema_t field, const uint8_t *data, uint32_t len);
+
+/** Append group to sequence field
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] value group
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_appendGroupByField(blink_object_t group, blink_schema_t field, blink_object_t value);
+
+/** Write boolean to sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index (must be less than BLINK_Object_getSequenceSizeByField())
+ * @param[in] value boolean
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setBoolAtByField(blink_object_t group, blink_schema_t field, uint32_t index, bool value);
+
+/** Write decimal to sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index (must be less than BLINK_Object_getSequenceSizeByField())
+ * @param[in] mantissa
+ * @param[in] exponent
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setDecimalAtByField(blink_object_t group, blink_schema_t field, uint32_t index, int64_t mantissa, int8_t exponent);
+
+/** Write an unsigned integer to sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index (must be less than BLINK_Object_getSequenceSizeByField())
+ * @param[in] value
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setUintAtByField(blink_object_t group, blink_schema_t field, uint32_t index, uint64_t value);
+
+/** Write a signed integer to sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index (must be less than BLINK_Object_getSequenceSizeByField())
+ * @param[in] value
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setIntAtByField(blink_object_t group, blink_schema_t field, uint32_t index, int64_t value);
+
+/** Write f64 to sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index (must be less than BLINK_Object_getSequenceSizeByField())
+ * @param[in] value
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setF64AtByField(blink_object_t group, blink_schema_t field, uint32_t index, double value);
+
+/** Write string to sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index (must be less than BLINK_Object_getSequenceSizeByField())
+ * @param[in] str pointer to string
+ * @param[in] len length of string
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setStringAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const char *str, uint32_t len);
+
+/** Write binary to sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index (must be less than BLINK_Object_getSequenceSizeByField())
+ * @param[in] data pointer to binary
+ * @param[in] len length of binary
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setBinaryAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const uint8_t *data, uint32_t len);
+
+/** Write fixed to sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index (must be less than BLINK_Object_getSequenceSizeByField())
+ * @param[in] data pointer to fixed
+ * @param[in] len length of fixed
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setFixedAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const uint8_t *data, uint32_t len);
+
+/** Write group to sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index (must be less than BLINK_Object_getSequenceSizeByField())
+ * @param[in] value group
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_setGroupAtByField(blink_object_t group, blink_schema_t field, uint32_t index, blink_object_t value);
+
+/** Read boolean from sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index
+ *
+ * @return boolean
+ *
+ * */
+bool BLINK_Object_getBoolAtByField(blink_object_t group, blink_schema_t field, uint32_t index);
+
+/** Read decimal from sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index
+ * @param[out] mantissa
+ * @param[out] exponent
+ *
+ * */
+void BLINK_Object_getDecimalAtByField(blink_object_t group, blink_schema_t field, uint32_t index, int64_t *mantissa, int8_t *exponent);
+
+/** Read Uint from sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index
+ *
+ * @return uint
+ *
+ * */
+uint64_t BLINK_Object_getUintAtByField(blink_object_t group, blink_schema_t field, uint32_t index);
+
+/** Read Int from sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index
+ *
+ * @return int
+ *
+ * */
+int64_t BLINK_Object_getIntAtByField(blink_object_t group, blink_schema_t field, uint32_t index);
+
+/** Read f64 from sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index
+ *
+ * @return f64
+ *
+ * */
+double BLINK_Object_getF64AtByField(blink_object_t group, blink_schema_t field, uint32_t index);
+
+/** Read string from sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index
+ * @param[out] str
+ * @param[out] len
+ *
+ * */
+void BLINK_Object_getStringAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const char **str, uint32_t *len);
+
+/** Read binary from sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index
+ * @param[out] data
+ * @param[out] len
+ *
+ * */
+void BLINK_Object_getBinaryAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const uint8_t **data, uint32_t *len);
+
+/** Read fixed from sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index
+ * @param[out] data
+ * @param[out] len
+ *
+ * */
+void BLINK_Object_getFixedAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const uint8_t **data, uint32_t *len);
+
+/** Read group from sequence element
+ *
+ * @param[in] group
+ * @param[in] field sequence field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[in] index element index
+ *
+ * @return group
+ *
+ * */
+blink_object_t BLINK_Object_getGroupAtByField(blink_object_t group, blink_schema_t field, uint32_t index);
+
+/** Encode a group to compact form
+ *
+ * String and binary values are written with BLINK_Stream_writeRef() so
+ * that a gather stream (see blink_iovec) can send them without copying.
+ * In that case the group must not be modified or destroyed until the
+ * stream has been flushed.
+ *
+ * @param[in] group
+ * @param[in] out output stream
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Object_encodeCompact(blink_object_t group, blink_stream_t out);
+
+blink_object_t BLINK_Object_decodeCompact(blink_stream_t in, blink_schema_t schema, const struct blink_allocator *alloc);
+
+/** Decode a group from compact form with options
+ *
+ * BLINK_Object_decodeCompact() is equivalent to calling this function
+ * with `options` set to NULL.
+ *
+ * @param[in] in input stream
+ * @param[in] schema
+ * @param[in] alloc allocator for the new group
+ * @param[in] options decode options (may be NULL)
+ *
+ * @return group
+ *
+ * @retval NULL could not decode group
+ *
+ * */
+blink_object_t BLINK_Object_decodeCompactWithOptions(blink_stream_t in, blink_schema_t schema, const struct blink_allocator *alloc, const struct blink_decode_options *options);
+
+/** Initialise a field mask with no fields selected
+ *
+ * @param[out] mask
+ * @param[in] group group definition
+ *
+ * @return true if successful
+ *
+ * @retval false group has more than #BLINK_OBJECT_MASK_FIELDS fields
+ *
+ * */
+bool BLINK_Object_initMask(struct blink_field_mask *mask, blink_schema_t group);
+
+/** Select a field by name
+ *
+ * @param[in] mask
+ * @param[in] fieldName name of field
+ *
+ * @return true if field was found
+ *
+ * */
+bool BLINK_Object_maskSelect(struct blink_field_mask *mask, const char *fieldName);
+
+/** Select a field
+ *
+ * @param[in] mask
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ *
+ * @return true if field is in the mask group
+ *
+ * */
+bool BLINK_Object_maskSelectByField(struct blink_field_mask *mask, blink_schema_t field);
+
+/** Decode a group from compact form into an existing group model
+ *
+ * The group is reset (see BLINK_Object_reset()) and then populated
+ * from the input stream, reusing storage held from previous decodes.
+ * Once warmed up, decoding a stream of same-shaped messages requires
+ * no allocation.
+ *
+ * @param[in] in input stream
+ * @param[in] schema
+ * @param[in] group group model to decode into
+ * @param[in] options decode options (may be NULL)
+ *
+ * @return true if successful
+ *
+ * @retval false could not decode group, or the encoded group is not
+ *               of the same type as `group` (group is left reset)
+ *
+ * */
+bool BLINK_Object_decodeCompactInto(blink_stream_t in, blink_schema_t schema, blink_object_t group, const struct blink_decode_options *options);
+
+/** Get an upper bound on the memory needed to decode any instance of a group
+ *
+ * The bound is calculated from the group definition alone and is only
+ * available when every field is of bounded size (i.e. no sequences,
+ * unsized strings or binaries, or dynamic groups). String and binary
+ * values are assumed not to exceed their declared size.
+ *
+ * @param[in] group group definition
+ * @param[out] size size in bytes suitable for BLINK_Object_decodeCompactInBuffer()
+ *
+ * @return true if the group is bounded
+ *
+ * @retval false group size depends on the encoded message (see BLINK_Object_sizeofDecodeCompact())
+ *
+ * */
+bool BLINK_Object_getDecodeBound(blink_schema_t group, size_t *size);
+
+/** Calculate the memory needed to decode a group from compact form
+ *
+ * The encoded group is walked without being decoded. The result is
+ * the exact size of buffer BLINK_Object_decodeCompactInBuffer() needs
+ * to decode the same group with the same options.
+ *
+ * @note if `options` requests zero copy then the stream later passed to
+ * BLINK_Object_decodeCompactInBuffer() must be able to borrow
+ *
+ * @param[in] in encoded group
+ * @param[in] inLen size of `in` in bytes
+ * @param[in] schema
+ * @param[in] options decode options (may be NULL)
+ * @param[out] size size in bytes
+ *
+ * @return true if successful
+ *
+ * @retval false could not decode group
+ *
+ * */
+bool BLINK_Object_sizeofDecodeCompact(const uint8_t *in, uint32_t inLen, blink_schema_t schema, const struct blink_decode_options *options, size_t *size);
+
+/** Decode a group from compact form into a single caller provided buffer
+ *
+ * The whole object tree is allocated from `buffer` without calling
+ * any allocator. Use BLINK_Object_getDecodeBound() or
+ * BLINK_Object_sizeofDecodeCompact() to size the buffer.
+ *
+ * The decoded group is valid until the buffer is reused or released;
+ * it does not need to be destroyed. Setters may continue to use the
+ * remainder of the buffer.
+ *
+ * @param[in] in input stream
+ * @param[in] schema
+ * @param[in] buffer must be aligned to #BLINK_ARENA_ALIGN
+ * @param[in] size size of `buffer` in bytes
+ * @param[in] options decode options (may be NULL)
+ *
+ * @return group
+ *
+ * @retval NULL could not decode group or `buffer` is too small
+ *
+ * */
+blink_object_t BLINK_Object_decodeCompactInBuffer(blink_stream_t in, blink_schema_t schema, void *buffer, size_t size, const struct blink_decode_options *options);
 
 /** @} */
 
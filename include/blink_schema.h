@@ -150,6 +150,65 @@ struct blink_allocator;
 /** this type refers to any immutable schema object */
 typedef struct blink_schema * blink_schema_t;
 
+/** A field descriptor caches the type information of a field with all
+ * type references resolved
+ *
+ * Each group holds an array of descriptors, one for each field
+ * (including inherited fields), in the order fields are encoded.
+ *
+ * */
+struct blink_field_desc {
+    blink_schema_t field;           /**< field definition */
+    blink_schema_t ref;             /**< group (#BLINK_TYPE_STATIC_GROUP, #BLINK_TYPE_DYNAMIC_GROUP) or enum (#BLINK_TYPE_ENUM) definition */
+    uint32_t size;                  /**< size attribute (#BLINK_TYPE_STRING, #BLINK_TYPE_BINARY, #BLINK_TYPE_FIXED) */
+    enum blink_type_tag type;       /**< terminal type */
+    bool isOptional;                /**< field is optional */
+    bool isSequence;                /**< field is a sequence */
+};
+
+/** Decode program operation codes
+ *
+ * @see BLINK_Group_getDecodeProgram()
+ *
+ * */
+enum blink_decode_opcode {
+    BLINK_OP_END = 0,           /**< end of group */
+    BLINK_OP_STRING,            /**< string or binary */
+    BLINK_OP_FIXED,             /**< fixed */
+    BLINK_OP_BOOL,              /**< bool */
+    BLINK_OP_U8,                /**< u8 */
+    BLINK_OP_U16,               /**< u16 */
+    BLINK_OP_U32,               /**< u32 and timeOfDayMilli */
+    BLINK_OP_U64,               /**< u64 and timeOfDayNano */
+    BLINK_OP_I8,                /**< i8 */
+    BLINK_OP_I16,               /**< i16 */
+    BLINK_OP_I32,               /**< i32 and date */
+    BLINK_OP_I64,               /**< i64, nanotime, and millitime */
+    BLINK_OP_F64,               /**< f64 */
+    BLINK_OP_DECIMAL,           /**< decimal */
+    BLINK_OP_ENUM,              /**< enum (`ref` is the enum definition) */
+    BLINK_OP_STATIC_GROUP,      /**< enter static group (`ref` is the group definition) */
+    BLINK_OP_DYNAMIC_GROUP,     /**< enter dynamic group (`ref` is the group definition) */
+    BLINK_OP_OBJECT,            /**< enter dynamic group of any type */
+    BLINK_OP_INTEGER_SEQUENCE,  /**< integer sequence decoded in one go (`type` is the element type) */
+    BLINK_OP_SEQUENCE           /**< sequence of elements decoded by the next operation */
+};
+
+/** One operation in a decode program
+ *
+ * A decode program is the flattened field list of a group lowered into
+ * the operations needed to decode it, terminated by #BLINK_OP_END.
+ *
+ * */
+struct blink_decode_op {
+    blink_schema_t ref;             /**< group or enum definition */
+    uint32_t field;                 /**< index of field (see BLINK_Group_getFieldDescs()) */
+    uint32_t size;                  /**< size attribute */
+    enum blink_type_tag type;       /**< terminal type */
+    uint8_t code;                   /**< #blink_decode_opcode */
+    bool isOptional;                /**< field is optional */
+};
+
 /** A field iterator stores state required to iterate through all fields of a group (including any inherited fields) */
 struct blink_field_iterator {
     blink_schema_t *field;      /**< stack of pointers to fields within groups */
@@ -161,6 +220,17 @@ struct blink_group_iterator {
     struct blink_schema *def;   /**< definition pointer */
 };
 
+/** A name that has been split and hashed once so that it can be reused
+ * for any number of lookups without further string processing */
+struct blink_name {
+    const char *ns;             /**< namespace part of name (NULL if name is not qualified) */
+    size_t nsLen;               /**< length of `ns` */
+    uint32_t nsHash;            /**< hash of `ns` */
+    const char *name;           /**< unqualified part of name */
+    size_t nameLen;             /**< length of `name` */
+    uint32_t nameHash;          /**< hash of `name` */
+};
+
 /* function prototypes ************************************************/
 
 /** Create a new schema object from schema syntax object
@@ -193,6 +263,27 @@ blink_schema_t BLINK_Schema_getGroupByName(blink_schema_t self, const char *name
  * */
 blink_schema_t BLINK_Schema_getGroupByID(blink_schema_t schema, uint64_t id);
 
+/** Create a reusable name key
+ *
+ * The key refers to `name`, which must remain valid for the lifetime
+ * of the key.
+ *
+ * @param[in] name null terminated name string (may be qualified)
+ * @return name key
+ *
+ * */
+struct blink_name BLINK_Name_init(const char *name);
+
+/** Find group by name key
+ *
+ * @param[in] self
+ * @param[in] key name key created by BLINK_Name_init()
+ * @return group
+ * @retval NULL group not found
+ *
+ * */
+blink_schema_t BLINK_Schema_getGroupByKey(blink_schema_t self, const struct blink_name *key);
+
 const char *BLINK_Namespace_getName(blink_schema_t self);
 
 /** Get group name (within namespace)
@@ -245,6 +336,47 @@ bool BLINK_Group_hasID(blink_schema_t self);
  * */
 size_t BLINK_Group_numberOfFields(blink_schema_t self);
 
+/** Get field descriptors (including inherited fields)
+ *
+ * @param[in] self group
+ * @return array of BLINK_Group_numberOfFields() descriptors in encoding order
+ *
+ * */
+const struct blink_field_desc *BLINK_Group_getFieldDescs(blink_schema_t self);
+
+/** Get decode program
+ *
+ * The program is compiled from the field descriptors when the schema is
+ * created.
+ *
+ * @param[in] self group
+ * @return array of operations terminated by #BLINK_OP_END
+ *
+ * */
+const struct blink_decode_op *BLINK_Group_getDecodeProgram(blink_schema_t self);
+
+/** Find field by name (including inherited fields)
+ *
+ * @param[in] self group
+ * @param[in] name null terminated name string
+ * @return field
+ * @retval NULL field not found
+ *
+ * */
+blink_schema_t BLINK_Group_getFieldByName(blink_schema_t self, const char *name);
+
+/** Find field by name key (including inherited fields)
+ *
+ * @note only the unqualified part of the key is used
+ *
+ * @param[in] self group
+ * @param[in] key name key created by BLINK_Name_init()
+ * @return field
+ * @retval NULL field not found
+ *
+ * */
+blink_schema_t BLINK_Group_getFieldByKey(blink_schema_t self, const struct blink_name *key);
+
 /** Get field name
  * 
  * @param[in] self
@@ -253,6 +385,26 @@ size_t BLINK_Group_numberOfFields(blink_schema_t self);
  * */
 const char *BLINK_Field_getName(blink_schema_t self);
 
+/** Get field descriptor
+ *
+ * @param[in] self
+ * @return field descriptor
+ *
+ * */
+const struct blink_field_desc *BLINK_Field_getDesc(blink_schema_t self);
+
+/** Get field position
+ *
+ * Fields are numbered from zero starting with the fields inherited from
+ * the root supergroup. A field has the same position in the group that
+ * declares it and in every subgroup of that group.
+ *
+ * @param[in] self
+ * @return position of field within group
+ *
+ * */
+uint32_t BLINK_Field_getIndex(blink_schema_t self);
+
 /** Discover if field is optional
  *
  * @param[in] self
@@ -335,6 +487,18 @@ bool BLINK_Group_isKindOf(blink_schema_t self, blink_schema_t group);
  * */
 blink_schema_t BLINK_Enum_getSymbolByName(blink_schema_t self, const char *name);
 
+/** Find enum symbol by name key
+ *
+ * @note only the unqualified part of the key is used
+ *
+ * @param[in] self enum object
+ * @param[in] key name key created by BLINK_Name_init()
+ * @return symbol
+ * @retval NULL symbol not found
+ * 
+ * */
+blink_schema_t BLINK_Enum_getSymbolByKey(blink_schema_t self, const struct blink_name *key);
+
 /** Find enum symbol by value
  *
  * @param[in] self enum object
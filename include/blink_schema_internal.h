@@ -39,6 +39,7 @@
 #include <stdint.h>
 
 #include "blink_alloc.h"
+#include "blink_schema.h"
 
 /* types **************************************************************/
 
@@ -83,6 +84,13 @@ struct blink_schema {
     enum blink_schema_subclass type;
     const char *name;                   /**< name of type definition */          
     struct blink_schema *next;
+    uint32_t hash;                      /**< hash of name (valid once indexed) */
+};
+
+/** open addressed table of schema objects keyed by name */
+struct blink_schema_table {
+    struct blink_schema **slot;     /**< slots (NULL if empty) */
+    size_t size;                    /**< number of slots (zero or a power of two) */
 };
 
 /** type */
@@ -105,6 +113,8 @@ struct blink_schema_field {
     struct blink_schema super;
     struct blink_schema *a;         /**< annotations */    
     struct blink_schema_type type;  /**< field type information */
+    uint32_t index;                 /**< position within the field list of the declaring group (and of any subgroup) */
+    const struct blink_field_desc *desc;    /**< cached type information (valid once fields are flattened) */
     bool isOptional;                /**< field is optional */
 };
 
@@ -112,6 +122,7 @@ struct blink_schema_field {
 struct blink_schema_namespace {
     struct blink_schema super;    
     struct blink_schema *defs;  /**< list of groups, enums, and types in this namespace */
+    struct blink_schema_table defByName;    /**< `defs` by name */
 #ifndef BLINK_NO_ANNOTES    
     struct blink_schema *a;     /**< schema <- <annotes> */
 #endif    
@@ -128,6 +139,10 @@ struct blink_schema_group {
     struct blink_schema *s;         /**< optional supergroup */
     struct blink_schema *f;         /**< fields belonging to group */
     struct blink_schema_namespace *ns;     /**< link back to namespace */
+    struct blink_schema_table fieldByName;  /**< fields (including inherited fields) by name */
+    struct blink_field_desc *fieldDesc;     /**< descriptors of fields (including inherited fields) in encoding order */
+    size_t numberOfFields;                  /**< number of elements in `fieldDesc` */
+    struct blink_decode_op *program;        /**< decode program compiled from `fieldDesc` */
     bool hasID;                     /**< group has an ID */
 };
 
@@ -147,6 +162,7 @@ struct blink_schema_enum {
     struct blink_schema *a;
 #endif    
     struct blink_schema *s;   /**< symbols belonging to enumeration */
+    struct blink_schema_table symbolByName;    /**< `s` by name */
 };
 
 /** type definition */
@@ -177,6 +193,9 @@ struct blink_schema_base {
     struct blink_schema super;
     struct blink_schema *ns;        /**< a schema has zero or more namespace definitions */
     struct blink_allocator alloc;
+    struct blink_schema_table nsByName;     /**< `ns` by name */
+    struct blink_schema_group **groupByID;  /**< open addressed table of groups that have an ID */
+    size_t groupByIDSize;                   /**< number of slots in `groupByID` (zero or a power of two) */
 };
 
 /** @} */
@@ -0,0 +1,155 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+#ifndef BLINK_SLAB_H
+#define BLINK_SLAB_H
+
+/**
+ * @defgroup blink_slab blink_slab
+ * @ingroup ublink
+ *
+ * A size-class slab allocator for uBlink modules.
+ *
+ * Small allocations are rounded up to one of #BLINK_SLAB_NUM_CLASSES
+ * size classes. Each class has a free list which is refilled by carving
+ * up slabs obtained from a backing allocator. Freed memory goes back on
+ * the free list of its class, so once warmed up a long-running process
+ * can create and destroy objects without calling the backing allocator
+ * and without fragmenting its heap. Allocations larger than the
+ * largest class are passed through to the backing allocator.
+ *
+ * Allocations are aligned for any scalar type (`long double`, pointers,
+ * and 64 bit integers), provided the backing allocator returns memory
+ * with at least that alignment.
+ *
+ * @note not thread safe
+ *
+ * ### Example Workflow
+ *
+ * @code
+ * struct blink_slab slab;
+ * struct blink_allocator backing = {.calloc = calloc, .free = free};
+ * (void)BLINK_Slab_init(&slab, &backing);
+ *
+ * struct blink_allocator alloc = BLINK_Slab_getAllocator(&slab);
+ *
+ * blink_object_t group = BLINK_Object_newGroup(&alloc, definition);
+ *
+ * // memory returns to the slab
+ * BLINK_Object_destroyGroup(&group);
+ *
+ * // slabs return to the backing allocator
+ * BLINK_Slab_destroy(&slab);
+ * @endcode
+ *
+ * @{
+ * */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ***********************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "blink_alloc.h"
+
+/* defines ************************************************************/
+
+/** number of size classes */
+#define BLINK_SLAB_NUM_CLASSES 24U
+
+#ifndef BLINK_SLAB_SIZE
+/** size of a slab obtained from the backing allocator in bytes */
+#define BLINK_SLAB_SIZE 65536U
+#endif
+
+/* types **************************************************************/
+
+struct blink_slab {
+    struct blink_allocator backing;                 /**< source of slabs and large allocations */
+    void *freeList[BLINK_SLAB_NUM_CLASSES];         /**< free chunks of each size class */
+    void *slabs;                                    /**< slabs obtained from `backing` */
+};
+
+/** This type shall be used by uBlink modules to refer to initialised slab allocators */
+typedef struct blink_slab * blink_slab_t;
+
+/* function prototypes ************************************************/
+
+/** Initialise a slab allocator
+ *
+ * @param[in] self
+ * @param[in] backing allocator for slabs and large allocations (must be able to free)
+ *
+ * @return initialised slab allocator
+ *
+ * */
+blink_slab_t BLINK_Slab_init(struct blink_slab *self, const struct blink_allocator *backing);
+
+/** Allocate zeroed memory
+ *
+ * @param[in] self
+ * @param[in] nelem number of elements
+ * @param[in] elsize size of each element
+ *
+ * @return pointer to memory
+ *
+ * @retval NULL could not allocate
+ *
+ * */
+void *BLINK_Slab_calloc(blink_slab_t self, size_t nelem, size_t elsize);
+
+/** Free memory allocated by BLINK_Slab_calloc()
+ *
+ * @param[in] self
+ * @param[in] ptr (may be NULL)
+ *
+ * */
+void BLINK_Slab_free(blink_slab_t self, void *ptr);
+
+/** Return all slabs to the backing allocator
+ *
+ * @warning all memory allocated from the slab allocator becomes invalid
+ * (large allocations must still be freed with BLINK_Slab_free())
+ *
+ * @param[in] self
+ *
+ * */
+void BLINK_Slab_destroy(blink_slab_t self);
+
+/** Get an allocator interface for the slab allocator
+ *
+ * @param[in] self
+ * @return allocator
+ *
+ * */
+struct blink_allocator BLINK_Slab_getAllocator(blink_slab_t self);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif
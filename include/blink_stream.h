@@ -48,26 +48,29 @@ extern "C" {
 struct blink_stream_user {
     bool (*read)(void *state, void *out, size_t bytesToRead);
     bool (*write)(void *state, const void *in, size_t bytesToWrite);
-    uint32_t (*tell)(void *state);
+    uint64_t (*tell)(void *state);
     bool (*peek)(void *state, void *c);
-    bool (*seekCur)(void *state, int32_t offset);
-    bool (*seekSet)(void *state, uint32_t offset);
+    bool (*seekCur)(void *state, int64_t offset);
+    bool (*seekSet)(void *state, uint64_t offset);
     bool (*eof)(void *state);
+    bool (*writeRef)(void *state, const void *in, size_t bytesToWrite);    /**< optional (see BLINK_Stream_writeRef()) */
+};
+
+enum blink_stream_type {
+    BLINK_STREAM_NULL = 0,        /**< uninitialised */
+    BLINK_STREAM_BUFFER,          /**< buffer stream */
+    BLINK_STREAM_USER,            /**< user stream */
+    BLINK_STREAM_BOUNDED          /**< bounded stream */
 };
 
 struct blink_stream {
-    enum blink_stream_type {
-        BLINK_STREAM_NULL = 0,        /**< uninitialised */
-        BLINK_STREAM_BUFFER,          /**< buffer stream */
-        BLINK_STREAM_USER,            /**< user stream */
-        BLINK_STREAM_BOUNDED          /**< bounded stream */
-    } type;
+    enum blink_stream_type type;
     union blink_stream_state {
         struct {
             const uint8_t *in;  /**< readable buffer */
             uint8_t *out;       /**< writeable buffer */
-            uint32_t max;       /**< maximum size of buffer */
-            uint32_t pos;       /**< current position */
+            uint64_t max;       /**< maximum size of buffer */
+            uint64_t pos;       /**< current position */
             bool eof;
         } buffer;
         struct {
@@ -76,8 +79,8 @@ struct blink_stream {
         } user;
         struct {
             struct blink_stream *stream;
-            uint32_t max;                   
-            uint32_t pos;
+            uint64_t max;                   
+            uint64_t pos;
             bool eof;
         } bounded;
     } value;
@@ -100,6 +103,24 @@ typedef struct blink_stream * blink_stream_t;
  * */
 bool BLINK_Stream_write(blink_stream_t self, const void *buf, size_t nbyte);
 
+/** Write to a stream by reference
+ *
+ * Same as BLINK_Stream_write() except that a stream may record `buf`
+ * rather than copy it. The caller must keep `buf` unchanged until the
+ * stream has been flushed.
+ *
+ * Only user streams with a `writeRef` function take a reference; all
+ * other streams copy.
+ *
+ * @param[in] self stream
+ * @param[in] buf buffer to write
+ * @param[in] nbyte number of bytes to write
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_Stream_writeRef(blink_stream_t self, const void *buf, size_t nbyte);
+
 /** Read from a stream
  *
  * @param[in] self stream
@@ -121,6 +142,62 @@ bool BLINK_Stream_read(blink_stream_t self, void *buf, size_t nbyte);
  * */
 bool BLINK_Stream_peek(blink_stream_t self, void *buf);
 
+/** Read from a stream by returning a pointer into the underlying buffer
+ *
+ * The stream position is advanced by `nbyte` as though BLINK_Stream_read()
+ * had been called, but nothing is copied. The returned pointer remains
+ * valid for as long as the buffer the stream was initialised with.
+ *
+ * @param[in] self stream
+ * @param[in] nbyte number of bytes to read
+ *
+ * @return pointer to `nbyte` bytes within the stream buffer
+ *
+ * @retval NULL stream cannot borrow (see BLINK_Stream_canBorrow()) or
+ *              fewer than `nbyte` bytes remain
+ *
+ * */
+const uint8_t *BLINK_Stream_borrow(blink_stream_t self, size_t nbyte);
+
+/** Test if BLINK_Stream_borrow() is supported by a stream
+ *
+ * i.e. a readable buffer stream, or a bounded stream on top of one
+ *
+ * @param[in] self stream
+ *
+ * @return true if stream can borrow
+ *
+ * */
+bool BLINK_Stream_canBorrow(blink_stream_t self);
+
+/** Write to a stream by returning a pointer into the underlying buffer
+ *
+ * The stream position is advanced by `nbyte` and the caller may write
+ * up to `nbyte` bytes at the returned pointer. This allows a value to be
+ * back-patched once the data that follows it has been written.
+ *
+ * @param[in] self stream
+ * @param[in] nbyte number of bytes to reserve
+ *
+ * @return pointer to `nbyte` bytes within the stream buffer
+ *
+ * @retval NULL stream cannot reserve (see BLINK_Stream_canReserve()) or
+ *              fewer than `nbyte` bytes remain
+ *
+ * */
+uint8_t *BLINK_Stream_reserve(blink_stream_t self, size_t nbyte);
+
+/** Test if BLINK_Stream_reserve() is supported by a stream
+ *
+ * i.e. a writeable buffer stream, or a bounded stream on top of one
+ *
+ * @param[in] self stream
+ *
+ * @return true if stream can reserve
+ *
+ * */
+bool BLINK_Stream_canReserve(blink_stream_t self);
+
 /** Init a read only buffer stream
  *
  * @param[in] self
@@ -130,7 +207,7 @@ bool BLINK_Stream_peek(blink_stream_t self, void *buf);
  * @return stream
  * 
  * */
-blink_stream_t BLINK_Stream_initBufferReadOnly(struct blink_stream *self, const void *buf, uint32_t max);
+blink_stream_t BLINK_Stream_initBufferReadOnly(struct blink_stream *self, const void *buf, uint64_t max);
 
 /** Init a read/write buffer stream
  *
@@ -141,7 +218,7 @@ blink_stream_t BLINK_Stream_initBufferReadOnly(struct blink_stream *self, const
  * @return stream
  * 
  * */
-blink_stream_t BLINK_Stream_initBuffer(struct blink_stream *self, void *buf, uint32_t max);
+blink_stream_t BLINK_Stream_initBuffer(struct blink_stream *self, void *buf, uint64_t max);
 
 /** Init a user defined stream
  *
@@ -163,7 +240,7 @@ blink_stream_t BLINK_Stream_initUser(struct blink_stream *self, void *state, str
  * @return stream
  *
  * */
-blink_stream_t BLINK_Stream_initBounded(struct blink_stream *self, blink_stream_t stream, uint32_t max);
+blink_stream_t BLINK_Stream_initBounded(struct blink_stream *self, blink_stream_t stream, uint64_t max);
 
 /** Get current position
  *
@@ -171,7 +248,7 @@ blink_stream_t BLINK_Stream_initBounded(struct blink_stream *self, blink_stream_
  * @return stream position from origin
  *
  * */
-uint32_t BLINK_Stream_tell(blink_stream_t self);
+uint64_t BLINK_Stream_tell(blink_stream_t self);
 
 /** Set position to offset
  *
@@ -183,7 +260,7 @@ uint32_t BLINK_Stream_tell(blink_stream_t self);
  * @return true if position could be set to offset
  *
  * */
-bool BLINK_Stream_seekSet(blink_stream_t self, uint32_t offset);
+bool BLINK_Stream_seekSet(blink_stream_t self, uint64_t offset);
 
 /** Add offset to current position
  *
@@ -195,7 +272,7 @@ bool BLINK_Stream_seekSet(blink_stream_t self, uint32_t offset);
  * @return true if position could be modified by offset
  *
  * */
-bool BLINK_Stream_seekCur(blink_stream_t self, int32_t offset);
+bool BLINK_Stream_seekCur(blink_stream_t self, int64_t offset);
 
 /** Check if stream has reached EOF
  *
@@ -215,7 +292,7 @@ bool BLINK_Stream_eof(blink_stream_t self);
  * @retval 0 stream doesn't have a maximum
  *
  * */
-uint32_t BLINK_Stream_max(blink_stream_t self);
+uint64_t BLINK_Stream_max(blink_stream_t self);
 
 
 /** Set the maximum position of the stream
@@ -228,7 +305,113 @@ uint32_t BLINK_Stream_max(blink_stream_t self);
  * @return true if max could be set
  *
  * */
-bool BLINK_Stream_setMax(blink_stream_t self, uint32_t offset);
+bool BLINK_Stream_setMax(blink_stream_t self, uint64_t offset);
+
+/* inline functions ***************************************************/
+
+/** Get a cursor for reading directly from the memory underlying a stream
+ *
+ * This is a fast path for buffer streams and bounded streams on top of
+ * buffer streams. Data between the returned pointer and `end` may be
+ * read directly; BLINK_Stream_advanceRead() must then be called to
+ * consume it.
+ *
+ * @param[in] self stream
+ * @param[out] end one past the last readable byte
+ *
+ * @return pointer to next readable byte
+ *
+ * @retval NULL stream is not memory backed (use BLINK_Stream_read())
+ *
+ * */
+static inline const uint8_t *BLINK_Stream_readCursor(blink_stream_t self, const uint8_t **end)
+{
+    const uint8_t *retval = NULL;
+
+    if(self->type == BLINK_STREAM_BUFFER){
+
+        if(self->value.buffer.in != NULL){
+
+            retval = &self->value.buffer.in[self->value.buffer.pos];
+            *end = &self->value.buffer.in[self->value.buffer.max];
+        }
+    }
+    else if(self->type == BLINK_STREAM_BOUNDED){
+
+        blink_stream_t base = self->value.bounded.stream;
+
+        if((base != NULL) && (base->type == BLINK_STREAM_BUFFER) && (base->value.buffer.in != NULL)){
+
+            uint64_t remaining = self->value.bounded.max - self->value.bounded.pos;
+
+            retval = &base->value.buffer.in[base->value.buffer.pos];
+            *end = ((base->value.buffer.max - base->value.buffer.pos) < remaining) ? &base->value.buffer.in[base->value.buffer.max] : &retval[remaining];
+        }
+    }
+    else{
+
+        /* no action */
+    }
+
+    return retval;
+}
+
+/** Consume bytes read via BLINK_Stream_readCursor()
+ *
+ * @param[in] self stream
+ * @param[in] nbyte number of bytes read (must not exceed cursor range)
+ *
+ * */
+static inline void BLINK_Stream_advanceRead(blink_stream_t self, uint32_t nbyte)
+{
+    if(self->type == BLINK_STREAM_BOUNDED){
+
+        self->value.bounded.pos += nbyte;
+        self = self->value.bounded.stream;
+    }
+
+    self->value.buffer.pos += nbyte;
+}
+
+/** Get a cursor for writing directly to the memory underlying a stream
+ *
+ * Counterpart of BLINK_Stream_readCursor() for writeable buffer streams.
+ * BLINK_Stream_advanceWrite() must be called to commit the bytes written.
+ *
+ * @param[in] self stream
+ * @param[out] end one past the last writeable byte
+ *
+ * @return pointer to next writeable byte
+ *
+ * @retval NULL stream is not memory backed (use BLINK_Stream_write())
+ *
+ * */
+static inline uint8_t *BLINK_Stream_writeCursor(blink_stream_t self, uint8_t **end)
+{
+    uint8_t *retval = NULL;
+
+    if(self->type == BLINK_STREAM_BUFFER){
+
+        if(self->value.buffer.out != NULL){
+
+            retval = &self->value.buffer.out[self->value.buffer.pos];
+            *end = &self->value.buffer.out[self->value.buffer.max];
+        }
+    }
+
+    return retval;
+}
+
+/** Commit bytes written via BLINK_Stream_writeCursor()
+ *
+ * @param[in] self stream
+ * @param[in] nbyte number of bytes written (must not exceed cursor range)
+ *
+ * */
+static inline void BLINK_Stream_advanceWrite(blink_stream_t self, uint32_t nbyte)
+{
+    self->value.buffer.pos += nbyte;
+}
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,221 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+#ifndef BLINK_VIEW_H
+#define BLINK_VIEW_H
+
+/**
+ * @defgroup blink_view blink_view
+ * @ingroup ublink
+ *
+ * Read fields directly from a compact form message without decoding
+ * the whole message.
+ *
+ * BLINK_View_init() checks the size preamble and group ID once. After
+ * that, fields are located only when they are read. Locating a field
+ * means skipping the fields before it; the offsets found along the way
+ * are saved so that no field is skipped twice. Only the field that is
+ * read gets decoded, and strings are returned as pointers into the
+ * message.
+ *
+ * A view suits routing and filtering, where only a few fields of a wide
+ * message are needed. Use BLINK_Object_decodeCompact() when most fields
+ * are needed.
+ *
+ * ### Example Workflow
+ *
+ * @code
+ * // look up fields once
+ * blink_schema_t symbol = BLINK_Group_getFieldByName(BLINK_Schema_getGroupByName(schema, "InsertOrder"), "Symbol");
+ *
+ * struct blink_view view;
+ * const uint8_t *data;
+ * uint32_t len;
+ * bool isNull;
+ *
+ * if(BLINK_View_init(&view, schema, frame.data, frame.len)){
+ *
+ *     if(BLINK_View_getStringByField(&view, symbol, &data, &len, &isNull)){
+ *
+ *         // data points into frame
+ *     }
+ * }
+ * @endcode
+ *
+ * @{
+ * */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ***********************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "blink_stream.h"
+#include "blink_schema.h"
+
+/* defines ************************************************************/
+
+#ifndef BLINK_VIEW_MAX_FIELDS
+    /** a view can be made of groups with up to this many fields (including inherited fields) */
+    #define BLINK_VIEW_MAX_FIELDS 64U
+#endif
+
+/* types **************************************************************/
+
+struct blink_view {
+    blink_schema_t group;                           /**< group definition */
+    const struct blink_field_desc *desc;            /**< field descriptors of `group` */
+    const uint8_t *in;                              /**< first byte of message */
+    struct blink_stream stream;                     /**< positioned at first field not yet located */
+    uint32_t numberOfFields;                        /**< number of fields in `group` */
+    uint32_t located;                               /**< number of fields located */
+    uint32_t offset[BLINK_VIEW_MAX_FIELDS + 1U];    /**< field `i` is in range (`in + offset[i]` .. `in + offset[i+1]`) */
+};
+
+/* function prototypes ************************************************/
+
+/** Initialise a view of one compact form message
+ *
+ * @param[in] self
+ * @param[in] schema
+ * @param[in] in message starting with size preamble (e.g. blink_frame.data)
+ * @param[in] len bytes available at `in`
+ *
+ * @return true if successful
+ *
+ * @retval false message is truncated, group ID is unknown, or group has
+ *               more than #BLINK_VIEW_MAX_FIELDS fields
+ *
+ * */
+bool BLINK_View_init(struct blink_view *self, blink_schema_t schema, const void *in, size_t len);
+
+/** Test if field is null
+ *
+ * @param[in] self
+ * @param[in] field field definition (e.g. from BLINK_Group_getFieldByName())
+ * @param[out] isNull
+ *
+ * @return true if field could be located
+ *
+ * */
+bool BLINK_View_fieldIsNullByField(struct blink_view *self, blink_schema_t field, bool *isNull);
+
+/** Read `u8`, `u16`, `u32`, `u64`, `timeOfDayMilli`, or `timeOfDayNano` field
+ *
+ * @param[in] self
+ * @param[in] field field definition
+ * @param[out] value
+ * @param[out] isNull
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_View_getUintByField(struct blink_view *self, blink_schema_t field, uint64_t *value, bool *isNull);
+
+/** Read `i8`, `i16`, `i32`, `i64`, `date`, `nanoTime`, `milliTime`, or `enum` field
+ *
+ * @param[in] self
+ * @param[in] field field definition
+ * @param[out] value
+ * @param[out] isNull
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_View_getIntByField(struct blink_view *self, blink_schema_t field, int64_t *value, bool *isNull);
+
+/** Read `bool` field
+ *
+ * @param[in] self
+ * @param[in] field field definition
+ * @param[out] value
+ * @param[out] isNull
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_View_getBoolByField(struct blink_view *self, blink_schema_t field, bool *value, bool *isNull);
+
+/** Read `f64` field
+ *
+ * @param[in] self
+ * @param[in] field field definition
+ * @param[out] value
+ * @param[out] isNull
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_View_getF64ByField(struct blink_view *self, blink_schema_t field, double *value, bool *isNull);
+
+/** Read `decimal` field
+ *
+ * @param[in] self
+ * @param[in] field field definition
+ * @param[out] mantissa
+ * @param[out] exponent
+ * @param[out] isNull
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_View_getDecimalByField(struct blink_view *self, blink_schema_t field, int64_t *mantissa, int8_t *exponent, bool *isNull);
+
+/** Read `string`, `binary`, or `fixed` field without copying
+ *
+ * @param[in] self
+ * @param[in] field field definition
+ * @param[out] data pointer into the message
+ * @param[out] len
+ * @param[out] isNull
+ *
+ * @return true if successful
+ *
+ * */
+bool BLINK_View_getStringByField(struct blink_view *self, blink_schema_t field, const uint8_t **data, uint32_t *len, bool *isNull);
+
+/** Get the encoded form of any field
+ *
+ * Use this for sequences and groups, which can then be decoded with
+ * the blink_compact or blink_object functions.
+ *
+ * @param[in] self
+ * @param[in] field field definition
+ * @param[out] data pointer into the message
+ * @param[out] len
+ *
+ * @return true if field could be located
+ *
+ * */
+bool BLINK_View_getEncodedByField(struct blink_view *self, blink_schema_t field, const uint8_t **data, size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif
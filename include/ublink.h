@@ -33,7 +33,16 @@
 #include "blink_compact.h"
 #include "blink_schema.h"
 #include "blink_pool.h"
+#include "blink_arena.h"
+#include "blink_slab.h"
 #include "blink_stream.h"
+#include "blink_frame.h"
+#include "blink_view.h"
+#include "blink_file.h"
+#include "blink_fd.h"
+#ifndef BLINK_NO_FILE
+#include "blink_iovec.h"
+#endif
 #include "blink_object.h"
 
 #endif
@@ -0,0 +1,221 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+/* includes ***********************************************************/
+
+#include "blink_arena.h"
+#include "blink_debug.h"
+
+#include <string.h>
+
+/* static function prototypes *****************************************/
+
+static struct blink_arena_block *newBlock(blink_arena_t self, const struct blink_arena_block *last, size_t size);
+static void *arenaCalloc(void *ctx, size_t nelem, size_t elsize);
+
+/* functions **********************************************************/
+
+blink_arena_t BLINK_Arena_init(struct blink_arena *self, uint8_t *heap, size_t size, const struct blink_allocator *backing)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT((heap != NULL) || (size == 0U))
+    BLINK_ASSERT(((size_t)heap % BLINK_ARENA_ALIGN) == 0U)
+
+    (void)memset(self, 0, sizeof(*self));
+
+    self->first.heap = heap;
+    self->first.size = size;
+    self->current = &self->first;
+
+    if(backing != NULL){
+
+        self->backing = *backing;
+        self->canChain = BLINK_Allocator_isValid(backing);
+    }
+
+    return self;
+}
+
+void *BLINK_Arena_calloc(blink_arena_t self, size_t nelem, size_t elsize)
+{
+    BLINK_ASSERT(self != NULL)
+
+    void *retval = NULL;
+
+    if((nelem > 0U) && (elsize > 0U)){
+
+        if((nelem > ((SIZE_MAX - BLINK_ARENA_ALIGN) / elsize))){
+
+            BLINK_ERROR("allocation too large")
+        }
+        else{
+
+            size_t size = ((nelem * elsize) + (BLINK_ARENA_ALIGN - 1U)) & ~((size_t)BLINK_ARENA_ALIGN - 1U);
+            struct blink_arena_block *block = self->current;
+
+            while(retval == NULL){
+
+                if((block->size - block->pos) >= size){
+
+                    retval = &block->heap[block->pos];
+                    block->pos += size;
+                    self->current = block;
+
+                    /* memory may have been used before a reset or rewind */
+                    (void)memset(retval, 0, size);
+                }
+                /* blocks beyond the current block are unused */
+                else if(block->next != NULL){
+
+                    block = block->next;
+                    block->pos = 0U;
+                }
+                else{
+
+                    block->next = newBlock(self, block, size);
+
+                    if(block->next == NULL){
+
+                        BLINK_DEBUG("insufficient memory (asking for %lu bytes)", (unsigned long)size)
+                        break;
+                    }
+
+                    block = block->next;
+                }
+            }
+        }
+    }
+
+    return retval;
+}
+
+struct blink_arena_mark BLINK_Arena_mark(blink_arena_t self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    struct blink_arena_mark retval = {
+        .block = self->current,
+        .pos = self->current->pos
+    };
+
+    return retval;
+}
+
+void BLINK_Arena_rewind(blink_arena_t self, struct blink_arena_mark mark)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(mark.block != NULL)
+    BLINK_ASSERT(mark.pos <= mark.block->size)
+
+    self->current = mark.block;
+    self->current->pos = mark.pos;
+}
+
+void BLINK_Arena_reset(blink_arena_t self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    self->current = &self->first;
+    self->first.pos = 0U;
+}
+
+void BLINK_Arena_destroy(blink_arena_t self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    struct blink_arena_block *block = self->first.next;
+
+    while(block != NULL){
+
+        struct blink_arena_block *next = block->next;
+
+        BLINK_Allocator_free(&self->backing, block);
+        block = next;
+    }
+
+    self->first.next = NULL;
+
+    BLINK_Arena_reset(self);
+}
+
+struct blink_allocator BLINK_Arena_getAllocator(blink_arena_t self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    struct blink_allocator retval = {
+        .ctxCalloc = arenaCalloc,
+        .ctx = self
+    };
+
+    return retval;
+}
+
+size_t BLINK_Arena_getFreeSpace(blink_arena_t self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    return (self->current->size - self->current->pos);
+}
+
+/* static functions ***************************************************/
+
+/* chain a block big enough for size bytes; blocks at least double in
+ * size so that large messages need few blocks */
+static struct blink_arena_block *newBlock(blink_arena_t self, const struct blink_arena_block *last, size_t size)
+{
+    struct blink_arena_block *retval = NULL;
+    size_t header = (sizeof(struct blink_arena_block) + (BLINK_ARENA_ALIGN - 1U)) & ~((size_t)BLINK_ARENA_ALIGN - 1U);
+    size_t blockSize = (last->size < (SIZE_MAX / 4U)) ? (last->size * 2U) : size;
+
+    blockSize = (blockSize < BLINK_ARENA_BLOCK_SIZE) ? BLINK_ARENA_BLOCK_SIZE : blockSize;
+    blockSize = (blockSize < size) ? size : blockSize;
+
+    if(!self->canChain){
+
+        BLINK_DEBUG("arena is exhausted and has no backing allocator")
+    }
+    else if(blockSize > (SIZE_MAX - header)){
+
+        BLINK_ERROR("allocation too large")
+    }
+    else{
+
+        retval = BLINK_Allocator_calloc(&self->backing, 1U, header + blockSize);
+
+        if(retval != NULL){
+
+            retval->heap = &((uint8_t *)retval)[header];
+            retval->size = blockSize;
+        }
+        else{
+
+            BLINK_ERROR("calloc()")
+        }
+    }
+
+    return retval;
+}
+
+static void *arenaCalloc(void *ctx, size_t nelem, size_t elsize)
+{
+    return BLINK_Arena_calloc((blink_arena_t)ctx, nelem, elsize);
+}
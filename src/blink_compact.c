@@ -25,13 +25,60 @@
 #include "blink_compact.h"
 #include "blink_debug.h"
 #include "blink_stream.h"
+#include "blink_schema.h"
 
 #include <string.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(BLINK_NO_SIMD)
+#define BLINK_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/* defines ************************************************************/
+
+/* number of bytes that may be loaded/stored in one go by the VLC kernels */
+#define VLC_WIDE 9U
+
+/* static variables ***************************************************/
+
+/* encoded VLC size indexed by number of significant bits (including sign bit if signed) */
+static const uint8_t sizeByBits[66U] = {
+    1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U,         /* 0..7 */
+    2U, 2U, 2U, 2U, 2U, 2U, 2U,             /* 8..14 */
+    3U, 3U,                                 /* 15..16 */
+    4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U,         /* 17..24 */
+    5U, 5U, 5U, 5U, 5U, 5U, 5U, 5U,         /* 25..32 */
+    6U, 6U, 6U, 6U, 6U, 6U, 6U, 6U,         /* 33..40 */
+    7U, 7U, 7U, 7U, 7U, 7U, 7U, 7U,         /* 41..48 */
+    8U, 8U, 8U, 8U, 8U, 8U, 8U, 8U,         /* 49..56 */
+    9U, 9U, 9U, 9U, 9U, 9U, 9U, 9U, 9U      /* 57..65 */
+};
+
+/* types **************************************************************/
+
+/* decodes a run of single byte VLCs, returns number decoded */
+typedef size_t (* run_decoder)(const uint8_t *in, size_t avail, bool isSigned, uint64_t *out, size_t max);
+
 /* static function prototypes *****************************************/
 
+static bool decodeVLCArray(blink_stream_t in, bool isSigned, uint64_t *out, size_t n);
+static size_t decodeRun(const uint8_t *in, size_t avail, bool isSigned, uint64_t *out, size_t max);
+static size_t decodeRun_scalar(const uint8_t *in, size_t avail, bool isSigned, uint64_t *out, size_t max);
+#ifdef BLINK_SIMD_X86
+static size_t decodeRun_sse41(const uint8_t *in, size_t avail, bool isSigned, uint64_t *out, size_t max);
+static size_t decodeRun_avx2(const uint8_t *in, size_t avail, bool isSigned, uint64_t *out, size_t max);
+#endif
+
+static uint8_t countBits(uint64_t value);
+static uint64_t load64(const uint8_t *in);
+static void store64(uint64_t value, uint8_t *out);
+
 static bool encodeVLC(uint64_t in, bool isSigned, blink_stream_t out);
 static bool decodeVLC(blink_stream_t in, bool isSigned, uint64_t *out, bool *isNull);
+static void packVLC(uint64_t in, uint8_t bytes, uint8_t *out);
+static void unpackVLC(const uint8_t *in, bool isSigned, uint64_t *out, bool *isNull, bool wide);
+static bool skipBytes(blink_stream_t in, uint32_t n);
+static bool skipValue(blink_stream_t in, const struct blink_field_desc *desc, bool isOptional);
 
 /* functions **********************************************************/
 
@@ -179,6 +226,20 @@ bool BLINK_Compact_decodeU64(blink_stream_t in, uint64_t *out, bool *isNull)
     return decodeVLC(in, false, out, isNull);
 }
 
+bool BLINK_Compact_decodeU64Array(blink_stream_t in, uint64_t *out, size_t n)
+{
+    BLINK_ASSERT((n == 0U) || (out != NULL))
+
+    return decodeVLCArray(in, false, out, n);
+}
+
+bool BLINK_Compact_decodeI64Array(blink_stream_t in, int64_t *out, size_t n)
+{
+    BLINK_ASSERT((n == 0U) || (out != NULL))
+
+    return decodeVLCArray(in, true, (uint64_t *)out, n);
+}
+
 bool BLINK_Compact_decodeI8(blink_stream_t in, int8_t *out, bool *isNull)
 {
     BLINK_ASSERT(out != NULL)
@@ -352,6 +413,187 @@ bool BLINK_Compact_decodePresent(blink_stream_t in, bool *out)
     return retval;
 }
 
+uint8_t BLINK_Compact_sizeofVLC(uint8_t first)
+{
+    uint8_t retval;
+
+    if(first < 0x80U){
+
+        retval = 1U;
+    }
+    else if(first < 0xc0U){
+
+        retval = 2U;
+    }
+    else if(first == 0xc0U){
+
+        retval = 1U;    /* NULL */
+    }
+    else if((first & 0x3fU) <= 8U){
+
+        retval = (first & 0x3fU) + 1U;
+    }
+    else{
+
+        retval = 0U;
+    }
+
+    return retval;
+}
+
+bool BLINK_Compact_skipVLC(blink_stream_t in)
+{
+    bool retval = false;
+    uint8_t first;
+    uint8_t bytes;
+    const uint8_t *end;
+    const uint8_t *cursor = BLINK_Stream_readCursor(in, &end);
+
+    if((cursor != NULL) && (cursor < end)){
+
+        bytes = BLINK_Compact_sizeofVLC(*cursor);
+
+        if((bytes > 0U) && ((size_t)(end - cursor) >= (size_t)bytes)){
+
+            BLINK_Stream_advanceRead(in, bytes);
+            retval = true;
+        }
+    }
+
+    /* slow path for streams that are not memory backed, and for error handling */
+    if(!retval && BLINK_Stream_peek(in, &first)){
+
+        bytes = BLINK_Compact_sizeofVLC(first);
+
+        if(bytes > 0U){
+
+            retval = skipBytes(in, bytes);
+        }
+        else{
+
+            BLINK_ERROR("cannot handle a VLC field larger than 8 bytes")
+        }
+    }
+
+    return retval;
+}
+
+bool BLINK_Compact_skipString(blink_stream_t in)
+{
+    bool retval = false;
+    uint32_t size;
+    bool isNull;
+
+    if(BLINK_Compact_decodeU32(in, &size, &isNull)){
+
+        retval = (isNull) ? true : skipBytes(in, size);
+    }
+
+    return retval;
+}
+
+bool BLINK_Compact_skipFixed(blink_stream_t in, uint32_t size, bool isOptional)
+{
+    bool retval = true;
+    bool isPresent = true;
+
+    if(isOptional){
+
+        retval = BLINK_Compact_decodePresent(in, &isPresent);
+    }
+
+    if(retval && isPresent){
+
+        retval = skipBytes(in, size);
+    }
+
+    return retval;
+}
+
+bool BLINK_Compact_skipDecimal(blink_stream_t in)
+{
+    bool retval = false;
+    int8_t exponent;
+    bool isNull;
+
+    if(BLINK_Compact_decodeI8(in, &exponent, &isNull)){
+
+        retval = (isNull) ? true : BLINK_Compact_skipVLC(in);
+    }
+
+    return retval;
+}
+
+bool BLINK_Compact_skipDynamicGroup(blink_stream_t in)
+{
+    bool retval = false;
+    uint32_t size;
+    bool isNull;
+
+    if(BLINK_Compact_decodeU32(in, &size, &isNull)){
+
+        if(isNull){
+
+            retval = true;
+        }
+        /* as rejected by the decoder */
+        else if(size == 0U){
+
+            BLINK_ERROR("W1: Group cannot have size of zero")
+        }
+        else{
+
+            retval = skipBytes(in, size);
+        }
+    }
+
+    return retval;
+}
+
+bool BLINK_Compact_skipField(blink_stream_t in, const struct blink_field_desc *desc)
+{
+    BLINK_ASSERT(desc != NULL)
+
+    bool retval;
+    uint32_t n;
+    uint32_t i;
+    bool isNull;
+
+    if(desc->isSequence){
+
+        retval = BLINK_Compact_decodeU32(in, &n, &isNull);
+
+        /* elements are never optional */
+        for(i=0U; retval && !isNull && (i < n); i++){
+
+            retval = skipValue(in, desc, false);
+        }
+    }
+    else{
+
+        retval = skipValue(in, desc, desc->isOptional);
+    }
+
+    return retval;
+}
+
+bool BLINK_Compact_skipStaticGroup(blink_stream_t in, blink_schema_t group)
+{
+    BLINK_ASSERT(group != NULL)
+
+    bool retval = true;
+    const struct blink_field_desc *desc = BLINK_Group_getFieldDescs(group);
+    size_t n = BLINK_Group_numberOfFields(group);
+    size_t i;
+
+    for(i=0U; retval && (i < n); i++){
+
+        retval = BLINK_Compact_skipField(in, &desc[i]);
+    }
+
+    return retval;
+}
+
 bool BLINK_Compact_encodeBool(bool in, blink_stream_t out)
 {
     return encodeVLC((in ? 0x01U : 0x00U), false, out);
@@ -421,222 +663,485 @@ bool BLINK_Compact_encodeDecimal(int64_t mantissa, int8_t exponent, blink_stream
 
 uint8_t BLINK_Compact_sizeofUnsigned(uint64_t value)
 {
-    uint8_t retval;
+    return sizeByBits[countBits(value)];
+}
 
-    if(value <= 0x7fUL){
-        retval = 1U;
-    }
-    else if(value <= 0x3fffUL){
-        retval = 2U;            
-    }
-    else if(value <= 0xffffUL){
-        retval = 3U;
-    }
-    else if(value <= 0xffffffUL){
-        retval = 4U;
-    }
-    else if(value <= 0xffffffffUL){
-        retval = 5U;
-    }
-    else if(value <= 0xffffffffffUL){
-        retval = 6U;
-    }
-    else if(value <= 0xffffffffffffUL){
-        retval = 7U;
+uint8_t BLINK_Compact_sizeofSigned(int64_t value)
+{
+    /* fold negative values onto the positive range and count a sign bit */
+    uint64_t folded = (uint64_t)value ^ (uint64_t)(value >> 63);
+
+    return sizeByBits[countBits(folded) + 1U];
+}
+
+/* static functions ***************************************************/
+
+static bool encodeVLC(uint64_t in, bool isSigned, blink_stream_t out)
+{
+    uint8_t buffer[9U];
+    uint8_t bytes = (isSigned) ? BLINK_Compact_sizeofSigned((int64_t)in) : BLINK_Compact_sizeofUnsigned(in);
+    uint8_t *end;
+    uint8_t *cursor = BLINK_Stream_writeCursor(out, &end);
+    bool retval;
+
+    if((cursor != NULL) && ((size_t)(end - cursor) >= (size_t)VLC_WIDE)){
+
+        /* room for a wide store */
+        if(bytes > 2U){
+
+            cursor[0] = 0xC0U | (bytes-1U);
+            store64(in, &cursor[1]);
+        }
+        else{
+
+            packVLC(in, bytes, cursor);
+        }
+
+        BLINK_Stream_advanceWrite(out, bytes);
+        retval = true;
     }
-    else if(value <= 0xffffffffffffffUL){
-        retval = 8U;
+    else if((cursor != NULL) && ((size_t)(end - cursor) >= (size_t)bytes)){
+
+        packVLC(in, bytes, cursor);
+        BLINK_Stream_advanceWrite(out, bytes);
+        retval = true;
     }
     else{
-        retval = 9U;
+
+        packVLC(in, bytes, buffer);
+        retval = BLINK_Stream_write(out, buffer, bytes);
     }
 
     return retval;
 }
 
-uint8_t BLINK_Compact_sizeofSigned(int64_t value)
+static bool decodeVLC(blink_stream_t in, bool isSigned, uint64_t *out, bool *isNull)
 {
-    uint8_t retval;
+    BLINK_ASSERT(out != NULL)
+    BLINK_ASSERT(isNull != NULL)
 
-    if(value < 0){
+    uint8_t buffer[9U];
+    bool retval = false;
+    uint8_t bytes;
+    const uint8_t *end;
+    const uint8_t *cursor = BLINK_Stream_readCursor(in, &end);
 
-        if(value >= -64){
-            retval = 1U;
-        }
-        else if(value >= -8192){
-            retval = 2U;
-        }
-        else if(value >= -32768){
-            retval = 3U;
-        }
-        else if(value >= -8388608){
-            retval = 4U;
-        }
-        else if(value >= -2147483648){
-            retval = 5U;
-        }            
-        else if(value >= -549755813888){
-            retval = 6U;
-        }            
-        else if(value >= -140737488355328){
-            retval = 7U;
-        }            
-        else if(value >= -36028797018963968){
-            retval = 8U;
-        }            
-        else{
-            retval = 9U;
+    if((cursor != NULL) && (cursor < end)){
+
+        bytes = BLINK_Compact_sizeofVLC(*cursor);
+
+        if((bytes > 0U) && ((size_t)(end - cursor) >= (size_t)bytes)){
+
+            unpackVLC(cursor, isSigned, out, isNull, ((size_t)(end - cursor) >= (size_t)VLC_WIDE));
+            BLINK_Stream_advanceRead(in, bytes);
+            retval = true;
         }
     }
-    else{
 
-        if(value <= 0x3fL){
-            retval = 1U;
-        }
-        else if(value <= 0x1fffL){
-            retval = 2U;            
-        }
-        else if(value <= 0x7fffL){
-            retval = 3U;
-        }
-        else if(value <= 0x7fffffL){
-            retval = 4U;
-        }
-        else if(value <= 0x7fffffffL){
-            retval = 5U;
-        }
-        else if(value <= 0x7fffffffffL){
-            retval = 6U;
-        }
-        else if(value <= 0x7fffffffffffL){
-            retval = 7U;
-        }
-        else if(value <= 0x7fffffffffffffL){
-            retval = 8U;
-        }
-        else{
-            retval = 9U;
+    /* slow path for streams that are not memory backed, and for error handling */
+    if(!retval){
+
+        if(BLINK_Stream_read(in, buffer, 1U)){
+
+            bytes = BLINK_Compact_sizeofVLC(*buffer);
+
+            if(bytes > 0U){
+
+                if(BLINK_Stream_read(in, &buffer[1], bytes - 1U)){
+
+                    unpackVLC(buffer, isSigned, out, isNull, false);
+                    retval = true;
+                }
+            }
+            else{
+
+                /* VLC too large */
+                BLINK_ERROR("cannot handle a VLC field larger than 8 bytes")
+            }
         }
     }
 
     return retval;
 }
 
-/* static functions ***************************************************/
-
-static bool encodeVLC(uint64_t in, bool isSigned, blink_stream_t out)
+static void packVLC(uint64_t in, uint8_t bytes, uint8_t *out)
 {
-    uint8_t buffer[9U];
-    uint8_t bytes = (isSigned) ? BLINK_Compact_sizeofSigned((int64_t)in) : BLINK_Compact_sizeofUnsigned(in);
     uint8_t i;
 
     if(bytes == 1U){
 
-        *buffer = (uint8_t)(in & 0x7fU);
+        *out = (uint8_t)(in & 0x7fU);
     }
     else if(bytes == 2U){
 
-        buffer[0] = 0x80U | (uint8_t)(in & 0x3fU);
-        buffer[1] = (uint8_t)(in >> 6);   
+        out[0] = 0x80U | (uint8_t)(in & 0x3fU);
+        out[1] = (uint8_t)(in >> 6);   
     }
     else{
         
-        buffer[0] = 0xC0U | (bytes-1U);
+        out[0] = 0xC0U | (bytes-1U);
         for(i=1; i < bytes; i++){
 
-            buffer[i] = (uint8_t)(in >> ((i-1U)*8U));
+            out[i] = (uint8_t)(in >> ((i-1U)*8U));
         }            
     }
-    
-    return BLINK_Stream_write(out, buffer, bytes);    
 }
 
-static bool decodeVLC(blink_stream_t in, bool isSigned, uint64_t *out, bool *isNull)
+/* in must point to at least BLINK_Compact_sizeofVLC(in[0]) bytes, or VLC_WIDE
+ * bytes if `wide` is set in which case the value is extracted with one load */
+static void unpackVLC(const uint8_t *in, bool isSigned, uint64_t *out, bool *isNull, bool wide)
 {
-    BLINK_ASSERT(out != NULL)
-    BLINK_ASSERT(isNull != NULL)
-
-    uint8_t buffer[9U];
-    bool retval = false;
-    uint8_t bytes;
+    uint64_t value;
+    uint64_t sign;
+    uint8_t bits;
     uint8_t i;
 
     *isNull = false;
 
-    if(BLINK_Stream_read(in, buffer, 1U)){
+    if(in[0] < 0x80U){
 
-        if(buffer[0] < 0xc0U){
+        value = (uint64_t)in[0];
+        bits = 7U;
+    }
+    else if(in[0] < 0xc0U){
 
-            if(buffer[0] < 0x80U){
+        value = (uint64_t)(in[0] & 0x3fU) | ((uint64_t)in[1] << 6);
+        bits = 14U;
+    }
+    else if(in[0] == 0xc0U){
 
-                if(isSigned && ((buffer[0] & 0x40U) == 0x40U)){
+        value = 0U;
+        bits = 0U;
+        *isNull = true;
+    }
+    else{
 
-                    *out = 0xffffffffffffffc0U;                           
-                }
-                else{
-                    
-                    *out = 0x0U;
-                }
-                *out |= (uint64_t)(buffer[0] & 0x7fU);
-                retval = true;  
-            }
-            else{
+        bits = (in[0] & 0x3fU) * 8U;
+        
+        if(wide){
 
-                if(BLINK_Stream_read(in, &buffer[1], 1U)){
+            value = load64(&in[1]) & (0xffffffffffffffffU >> (64U - bits));
+        }
+        else{
 
-                    if(isSigned && ((buffer[1] & 0x80U) == 0x80U)){
+            value = 0U;
 
-                        *out = 0xffffffffffffff00U;                               
-                    }
-                    else{
-                        
-                        *out = 0x0U;
-                    }
-                    *out |= (uint64_t)buffer[1];
-                    *out <<= 6U;
-                    *out |= (uint64_t)(buffer[0] & 0x3fU);
-                    retval = true;
-                }
+            for(i=(in[0] & 0x3fU); i != 0U; i--){
+
+                value <<= 8;
+                value |= in[i];
             }
         }
-        else if(buffer[0] == 0xc0U){
+    }
 
-            *isNull = true;
-            retval = true;
+    if(isSigned && !*isNull){
+
+        /* sign extend */
+        sign = (uint64_t)1U << (bits - 1U);
+        value = (value ^ sign) - sign;
+    }
+
+    *out = value;
+}
+
+static bool skipValue(blink_stream_t in, const struct blink_field_desc *desc, bool isOptional)
+{
+    bool retval;
+    bool isPresent = true;
+
+    switch(desc->type){
+    case BLINK_TYPE_STRING:
+    case BLINK_TYPE_BINARY:
+        retval = BLINK_Compact_skipString(in);
+        break;
+    case BLINK_TYPE_FIXED:
+        retval = BLINK_Compact_skipFixed(in, desc->size, isOptional);
+        break;
+    case BLINK_TYPE_DECIMAL:
+        retval = BLINK_Compact_skipDecimal(in);
+        break;
+    case BLINK_TYPE_STATIC_GROUP:
+
+        retval = !isOptional || BLINK_Compact_decodePresent(in, &isPresent);
+
+        if(retval && isPresent){
+
+            retval = BLINK_Compact_skipStaticGroup(in, desc->ref);
         }
-        else{
+        break;
+
+    case BLINK_TYPE_DYNAMIC_GROUP:
+    case BLINK_TYPE_OBJECT:
+        retval = BLINK_Compact_skipDynamicGroup(in);
+        break;
+    default:
+        /* integers, bool, enum, f64, and time types */
+        retval = BLINK_Compact_skipVLC(in);
+        break;
+    }
+
+    return retval;
+}
+
+/* skip without copying for memory backed streams */
+static bool skipBytes(blink_stream_t in, uint32_t n)
+{
+    uint8_t buffer[64U];
+    bool retval = true;
+    uint32_t size;
+    const uint8_t *end;
+    const uint8_t *cursor = BLINK_Stream_readCursor(in, &end);
 
-            bytes = buffer[0] & 0x3fU;
+    if((cursor != NULL) && ((size_t)(end - cursor) >= (size_t)n)){
 
-            if(bytes <= 8U){
+        BLINK_Stream_advanceRead(in, n);
+    }
+    else{
 
-                if(BLINK_Stream_read(in, &buffer[1], bytes)){
+        while(retval && (n > 0U)){
 
-                    if(isSigned && ((buffer[bytes] & 0x80U) == 0x80U)){
-                        
-                        *out = 0xffffffffffff00U | buffer[bytes];
-                    }
-                    else{
+            size = (n < sizeof(buffer)) ? n : (uint32_t)sizeof(buffer);
+            retval = BLINK_Stream_read(in, buffer, size);
+            n -= size;
+        }
+    }
 
-                        *out = buffer[bytes];
-                    }
+    return retval;
+}
 
-                    for(i=bytes-1U; i != 0U; i--){
+static uint8_t countBits(uint64_t value)
+{
+#if defined(__GNUC__)
+    return (value == 0U) ? 0U : (uint8_t)(64 - __builtin_clzll(value));
+#else
+    uint8_t retval = 0U;
 
-                        *out <<= 8;
-                        *out |= buffer[i];                        
-                    }
+    while(value != 0U){
 
-                    retval = true;
+        value >>= 1;
+        retval++;
+    }
+
+    return retval;
+#endif
+}
+
+static uint64_t load64(const uint8_t *in)
+{
+    uint64_t retval;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    (void)memcpy(&retval, in, sizeof(retval));
+#else
+    uint8_t i;
+
+    retval = 0U;
+
+    for(i=8U; i != 0U; i--){
+
+        retval <<= 8;
+        retval |= in[i-1U];
+    }
+#endif
+    return retval;
+}
+
+static void store64(uint64_t value, uint8_t *out)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    (void)memcpy(out, &value, sizeof(value));
+#else
+    uint8_t i;
+
+    for(i=0U; i < 8U; i++){
+
+        out[i] = (uint8_t)(value >> (i*8U));
+    }
+#endif
+}
+
+static bool decodeVLCArray(blink_stream_t in, bool isSigned, uint64_t *out, size_t n)
+{
+    bool retval = true;
+    bool isNull;
+    size_t i = 0U;
+    size_t run;
+    const uint8_t *end;
+    const uint8_t *cursor;
+
+    while(retval && (i < n)){
+
+        cursor = BLINK_Stream_readCursor(in, &end);
+        run = 0U;
+
+        if(cursor != NULL){
+
+            run = decodeRun(cursor, (size_t)(end - cursor), isSigned, &out[i], n - i);
+            BLINK_Stream_advanceRead(in, (uint32_t)run);
+            i += run;
+        }
+
+        /* anything that isn't a single byte VLC */
+        if((run == 0U) && (i < n)){
+
+            if(decodeVLC(in, isSigned, &out[i], &isNull)){
+
+                if(isNull){
+
+                    BLINK_ERROR("sequence element cannot be NULL")
+                    retval = false;
+                }
+                else{
+
+                    i++;
                 }
             }
             else{
 
-                /* VLC too large */
-                BLINK_ERROR("cannot handle a VLC field larger than 8 bytes")
+                retval = false;
             }
         }
     }
 
     return retval;
 }
+
+static size_t decodeRun(const uint8_t *in, size_t avail, bool isSigned, uint64_t *out, size_t max)
+{
+    static run_decoder kernel = NULL;
+
+    if(kernel == NULL){
+
+#ifdef BLINK_SIMD_X86
+        if(__builtin_cpu_supports("avx2")){
+
+            kernel = decodeRun_avx2;
+        }
+        else if(__builtin_cpu_supports("sse4.1")){
+
+            kernel = decodeRun_sse41;
+        }
+        else{
+
+            kernel = decodeRun_scalar;
+        }
+#else
+        kernel = decodeRun_scalar;
+#endif
+    }
+
+    return kernel(in, avail, isSigned, out, max);
+}
+
+static size_t decodeRun_scalar(const uint8_t *in, size_t avail, bool isSigned, uint64_t *out, size_t max)
+{
+    size_t i = 0U;
+    uint64_t sign = (isSigned) ? 0x40U : 0x0U;
+
+    while((i < max) && (i < avail) && (in[i] < 0x80U)){
+
+        out[i] = ((uint64_t)in[i] ^ sign) - sign;
+        i++;
+    }
+
+    return i;
+}
+
+#ifdef BLINK_SIMD_X86
+
+/* 16 single byte VLCs at a time are widened to 64 bits with SSE4.1.
+ * Signed 7 bit values are sign extended to 8 bits by (x ^ 0x40) - 0x40
+ * before widening. All 16 results are stored before the number of valid
+ * results is known, so this only runs while `max` has room for 16. */
+__attribute__((target("sse4.1")))
+static size_t decodeRun_sse41(const uint8_t *in, size_t avail, bool isSigned, uint64_t *out, size_t max)
+{
+    size_t i = 0U;
+    size_t valid = 16U;
+    const __m128i sign = _mm_set1_epi8((isSigned) ? 0x40 : 0x00);
+
+    while((valid == 16U) && ((max - i) >= 16U) && ((avail - i) >= 16U)){
+
+        __m128i v = _mm_loadu_si128((const __m128i *)&in[i]);
+        unsigned mask = (unsigned)_mm_movemask_epi8(v);
+
+        v = _mm_sub_epi8(_mm_xor_si128(v, sign), sign);
+
+        if(isSigned){
+
+            _mm_storeu_si128((__m128i *)&out[i],      _mm_cvtepi8_epi64(v));
+            _mm_storeu_si128((__m128i *)&out[i+2U],   _mm_cvtepi8_epi64(_mm_srli_si128(v, 2)));
+            _mm_storeu_si128((__m128i *)&out[i+4U],   _mm_cvtepi8_epi64(_mm_srli_si128(v, 4)));
+            _mm_storeu_si128((__m128i *)&out[i+6U],   _mm_cvtepi8_epi64(_mm_srli_si128(v, 6)));
+            _mm_storeu_si128((__m128i *)&out[i+8U],   _mm_cvtepi8_epi64(_mm_srli_si128(v, 8)));
+            _mm_storeu_si128((__m128i *)&out[i+10U],  _mm_cvtepi8_epi64(_mm_srli_si128(v, 10)));
+            _mm_storeu_si128((__m128i *)&out[i+12U],  _mm_cvtepi8_epi64(_mm_srli_si128(v, 12)));
+            _mm_storeu_si128((__m128i *)&out[i+14U],  _mm_cvtepi8_epi64(_mm_srli_si128(v, 14)));
+        }
+        else{
+
+            _mm_storeu_si128((__m128i *)&out[i],      _mm_cvtepu8_epi64(v));
+            _mm_storeu_si128((__m128i *)&out[i+2U],   _mm_cvtepu8_epi64(_mm_srli_si128(v, 2)));
+            _mm_storeu_si128((__m128i *)&out[i+4U],   _mm_cvtepu8_epi64(_mm_srli_si128(v, 4)));
+            _mm_storeu_si128((__m128i *)&out[i+6U],   _mm_cvtepu8_epi64(_mm_srli_si128(v, 6)));
+            _mm_storeu_si128((__m128i *)&out[i+8U],   _mm_cvtepu8_epi64(_mm_srli_si128(v, 8)));
+            _mm_storeu_si128((__m128i *)&out[i+10U],  _mm_cvtepu8_epi64(_mm_srli_si128(v, 10)));
+            _mm_storeu_si128((__m128i *)&out[i+12U],  _mm_cvtepu8_epi64(_mm_srli_si128(v, 12)));
+            _mm_storeu_si128((__m128i *)&out[i+14U],  _mm_cvtepu8_epi64(_mm_srli_si128(v, 14)));
+        }
+
+        valid = (mask == 0U) ? 16U : (size_t)__builtin_ctz(mask);
+        i += valid;
+    }
+
+    return i + decodeRun_scalar(&in[i], avail - i, isSigned, &out[i], max - i);
+}
+
+/* as decodeRun_sse41() but 32 at a time */
+__attribute__((target("avx2")))
+static size_t decodeRun_avx2(const uint8_t *in, size_t avail, bool isSigned, uint64_t *out, size_t max)
+{
+    size_t i = 0U;
+    size_t valid = 32U;
+    const __m256i sign = _mm256_set1_epi8((isSigned) ? 0x40 : 0x00);
+
+    while((valid == 32U) && ((max - i) >= 32U) && ((avail - i) >= 32U)){
+
+        __m256i v = _mm256_loadu_si256((const __m256i *)&in[i]);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(v);
+
+        v = _mm256_sub_epi8(_mm256_xor_si256(v, sign), sign);
+
+        __m128i lo = _mm256_castsi256_si128(v);
+        __m128i hi = _mm256_extracti128_si256(v, 1);
+
+        if(isSigned){
+
+            _mm256_storeu_si256((__m256i *)&out[i],      _mm256_cvtepi8_epi64(lo));
+            _mm256_storeu_si256((__m256i *)&out[i+4U],   _mm256_cvtepi8_epi64(_mm_srli_si128(lo, 4)));
+            _mm256_storeu_si256((__m256i *)&out[i+8U],   _mm256_cvtepi8_epi64(_mm_srli_si128(lo, 8)));
+            _mm256_storeu_si256((__m256i *)&out[i+12U],  _mm256_cvtepi8_epi64(_mm_srli_si128(lo, 12)));
+            _mm256_storeu_si256((__m256i *)&out[i+16U],  _mm256_cvtepi8_epi64(hi));
+            _mm256_storeu_si256((__m256i *)&out[i+20U],  _mm256_cvtepi8_epi64(_mm_srli_si128(hi, 4)));
+            _mm256_storeu_si256((__m256i *)&out[i+24U],  _mm256_cvtepi8_epi64(_mm_srli_si128(hi, 8)));
+            _mm256_storeu_si256((__m256i *)&out[i+28U],  _mm256_cvtepi8_epi64(_mm_srli_si128(hi, 12)));
+        }
+        else{
+
+            _mm256_storeu_si256((__m256i *)&out[i],      _mm256_cvtepu8_epi64(lo));
+            _mm256_storeu_si256((__m256i *)&out[i+4U],   _mm256_cvtepu8_epi64(_mm_srli_si128(lo, 4)));
+            _mm256_storeu_si256((__m256i *)&out[i+8U],   _mm256_cvtepu8_epi64(_mm_srli_si128(lo, 8)));
+            _mm256_storeu_si256((__m256i *)&out[i+12U],  _mm256_cvtepu8_epi64(_mm_srli_si128(lo, 12)));
+            _mm256_storeu_si256((__m256i *)&out[i+16U],  _mm256_cvtepu8_epi64(hi));
+            _mm256_storeu_si256((__m256i *)&out[i+20U],  _mm256_cvtepu8_epi64(_mm_srli_si128(hi, 4)));
+            _mm256_storeu_si256((__m256i *)&out[i+24U],  _mm256_cvtepu8_epi64(_mm_srli_si128(hi, 8)));
+            _mm256_storeu_si256((__m256i *)&out[i+28U],  _mm256_cvtepu8_epi64(_mm_srli_si128(hi, 12)));
+        }
+
+        valid = (mask == 0U) ? 32U : (size_t)__builtin_ctz(mask);
+        i += valid;
+    }
+
+    return i + decodeRun_sse41(&in[i], avail - i, isSigned, &out[i], max - i);
+}
+
+#endif
@@ -0,0 +1,251 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+#ifndef BLINK_NO_FILE
+
+/* includes ***********************************************************/
+
+#include "blink_fd.h"
+#include "blink_debug.h"
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+/* static function prototypes *****************************************/
+
+static bool fdRead(void *state, void *out, size_t bytesToRead);
+static bool fdWrite(void *state, const void *in, size_t bytesToWrite);
+static uint64_t fdTell(void *state);
+static bool fdPeek(void *state, void *c);
+static bool fdEof(void *state);
+static bool refill(struct blink_fd *self);
+static bool writeAll(int fd, const uint8_t *in, size_t size, size_t *written);
+
+/* functions **********************************************************/
+
+blink_stream_t BLINK_Fd_initStream(struct blink_fd *self, struct blink_stream *stream, int fd, void *readBuffer, size_t readSize, void *writeBuffer, size_t writeSize)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(stream != NULL)
+    BLINK_ASSERT((readSize == 0U) || (readBuffer != NULL))
+    BLINK_ASSERT((writeSize == 0U) || (writeBuffer != NULL))
+
+    static const struct blink_stream_user fn = {
+        .read = fdRead,
+        .write = fdWrite,
+        .tell = fdTell,
+        .peek = fdPeek,
+        .eof = fdEof
+    };
+
+    (void)memset(self, 0, sizeof(*self));
+
+    self->fd = fd;
+    self->in = (uint8_t *)readBuffer;
+    self->inSize = (readBuffer != NULL) ? readSize : 0U;
+    self->out = (uint8_t *)writeBuffer;
+    self->outSize = (writeBuffer != NULL) ? writeSize : 0U;
+
+    return BLINK_Stream_initUser(stream, self, fn);
+}
+
+bool BLINK_Fd_flush(struct blink_fd *self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    size_t written;
+    bool retval = writeAll(self->fd, self->out, self->outLen, &written);
+
+    /* keep what could not be written for the next flush */
+    (void)memmove(self->out, &self->out[written], self->outLen - written);
+    self->outLen -= written;
+
+    return retval;
+}
+
+/* static functions ***************************************************/
+
+static bool fdRead(void *state, void *out, size_t bytesToRead)
+{
+    struct blink_fd *self = (struct blink_fd *)state;
+    uint8_t *ptr = (uint8_t *)out;
+    bool retval = true;
+    size_t size;
+    ssize_t n;
+
+    while(retval && (bytesToRead > 0U)){
+
+        size = self->inLen - self->inPos;
+
+        if(size > 0U){
+
+            size = (size < bytesToRead) ? size : bytesToRead;
+
+            (void)memcpy(ptr, &self->in[self->inPos], size);
+
+            self->inPos += size;
+        }
+        /* large reads go straight to the destination */
+        else if(bytesToRead >= self->inSize){
+
+            do{
+
+                n = read(self->fd, ptr, bytesToRead);
+            }
+            while((n < 0) && (errno == EINTR));
+
+            self->eof = (n == 0);
+            size = (n > 0) ? (size_t)n : 0U;
+            retval = (n > 0);
+        }
+        else{
+
+            size = 0U;
+            retval = refill(self);
+        }
+
+        ptr = &ptr[size];
+        bytesToRead -= size;
+        self->pos += size;
+    }
+
+    return retval;
+}
+
+static bool fdWrite(void *state, const void *in, size_t bytesToWrite)
+{
+    struct blink_fd *self = (struct blink_fd *)state;
+    bool retval = true;
+
+    if((self->outSize - self->outLen) < bytesToWrite){
+
+        retval = BLINK_Fd_flush(self);
+    }
+
+    if(retval){
+
+        /* large writes bypass the buffer */
+        if(bytesToWrite > self->outSize){
+
+            size_t written;
+
+            retval = writeAll(self->fd, (const uint8_t *)in, bytesToWrite, &written);
+        }
+        else{
+
+            (void)memcpy(&self->out[self->outLen], in, bytesToWrite);
+            self->outLen += bytesToWrite;
+        }
+    }
+
+    if(retval){
+
+        self->pos += bytesToWrite;
+    }
+
+    return retval;
+}
+
+static uint64_t fdTell(void *state)
+{
+    return ((const struct blink_fd *)state)->pos;
+}
+
+static bool fdPeek(void *state, void *c)
+{
+    struct blink_fd *self = (struct blink_fd *)state;
+    bool retval = true;
+
+    if(self->inPos == self->inLen){
+
+        retval = refill(self);
+    }
+
+    if(retval){
+
+        *((uint8_t *)c) = self->in[self->inPos];
+    }
+
+    return retval;
+}
+
+static bool fdEof(void *state)
+{
+    return ((const struct blink_fd *)state)->eof;
+}
+
+/* replace the (empty) read-ahead buffer with at least one byte */
+static bool refill(struct blink_fd *self)
+{
+    bool retval = false;
+    ssize_t n;
+
+    if(self->inSize > 0U){
+
+        do{
+
+            n = read(self->fd, self->in, self->inSize);
+        }
+        while((n < 0) && (errno == EINTR));
+
+        self->inPos = 0U;
+        self->inLen = (n > 0) ? (size_t)n : 0U;
+        self->eof = (n == 0);
+
+        retval = (n > 0);
+    }
+
+    return retval;
+}
+
+/* written is set to the number of bytes written even on failure */
+static bool writeAll(int fd, const uint8_t *in, size_t size, size_t *written)
+{
+    bool retval = true;
+    ssize_t n;
+
+    *written = 0U;
+
+    while(retval && (*written < size)){
+
+        n = write(fd, &in[*written], size - *written);
+
+        if(n > 0){
+
+            *written += (size_t)n;
+        }
+        else if((n < 0) && (errno == EINTR)){
+
+            /* try again */
+        }
+        else{
+
+            BLINK_ERROR("write()")
+            retval = false;
+        }
+    }
+
+    return retval;
+}
+
+#endif
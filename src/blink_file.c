@@ -0,0 +1,132 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+#ifndef BLINK_NO_FILE
+
+/* posix_madvise() is not declared in strict C99 without this */
+#ifndef _POSIX_C_SOURCE
+    #define _POSIX_C_SOURCE 200112L
+#endif
+
+/* includes ***********************************************************/
+
+#include "blink_file.h"
+#include "blink_debug.h"
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* functions **********************************************************/
+
+bool BLINK_File_map(struct blink_file *self, const char *path)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(path != NULL)
+
+    bool retval = false;
+    struct stat st;
+    void *data;
+    int fd;
+
+    (void)memset(self, 0, sizeof(*self));
+
+    fd = open(path, O_RDONLY);
+
+    if(fd >= 0){
+
+        if((fstat(fd, &st) == 0) && S_ISREG(st.st_mode)){
+
+            if(st.st_size == 0){
+
+                /* zero length mappings are not allowed */
+                retval = true;
+            }
+            else if((uint64_t)st.st_size <= (uint64_t)SIZE_MAX){
+
+                data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+                if(data != MAP_FAILED){
+
+                    /* a failed hint is not an error */
+                    (void)posix_madvise(data, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+
+                    self->data = (const uint8_t *)data;
+                    self->size = (uint64_t)st.st_size;
+                    retval = true;
+                }
+                else{
+
+                    BLINK_ERROR("mmap()")
+                }
+            }
+            else{
+
+                BLINK_ERROR("file is too large to map")
+            }
+        }
+        else{
+
+            BLINK_ERROR("not a regular file")
+        }
+
+        /* the mapping remains valid after the descriptor is closed */
+        (void)close(fd);
+    }
+    else{
+
+        BLINK_ERROR("open()")
+    }
+
+    return retval;
+}
+
+void BLINK_File_unmap(struct blink_file *self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    if(self->data != NULL){
+
+        (void)munmap((void *)self->data, (size_t)self->size);
+    }
+
+    (void)memset(self, 0, sizeof(*self));
+}
+
+blink_stream_t BLINK_File_initStream(const struct blink_file *self, struct blink_stream *stream, uint64_t offset)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(stream != NULL)
+
+    blink_stream_t retval = NULL;
+
+    if(offset < self->size){
+
+        retval = BLINK_Stream_initBufferReadOnly(stream, &self->data[offset], self->size - offset);
+    }
+
+    return retval;
+}
+
+#endif
@@ -0,0 +1,218 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+/* includes ***********************************************************/
+
+#include "blink_frame.h"
+#include "blink_compact.h"
+#include "blink_debug.h"
+
+#include <string.h>
+
+/* functions **********************************************************/
+
+void BLINK_Frame_init(struct blink_frame_reader *self, void *buffer, size_t size, blink_schema_t schema)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT((size == 0U) || (buffer != NULL))
+
+    (void)memset(self, 0, sizeof(*self));
+
+    self->buf = (uint8_t *)buffer;
+    self->size = size;
+    self->need = 1U;
+    self->schema = schema;
+}
+
+enum blink_frame_status BLINK_Frame_next(struct blink_frame_reader *self, struct blink_frame *frame)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(frame != NULL)
+
+    enum blink_frame_status retval = BLINK_FRAME_PARTIAL;
+    struct blink_stream stream;
+    const uint8_t *in;
+    size_t avail;
+    size_t preambleLen;
+    size_t idLen;
+    uint64_t len;
+    uint32_t size;
+    uint64_t id;
+    bool isNull;
+    bool more = true;
+
+    while(more){
+
+        in = &self->buf[self->start];
+        avail = self->end - self->start;
+
+        if(self->discard > 0U){
+
+            len = (self->discard < (uint64_t)avail) ? self->discard : (uint64_t)avail;
+
+            self->start += (size_t)len;
+            self->discard -= len;
+            self->need = (self->discard > 0U) ? self->discard : 1U;
+
+            more = (self->discard == 0U);
+        }
+        else if(avail == 0U){
+
+            self->need = 1U;
+            more = false;
+        }
+        else{
+
+            more = false;
+            preambleLen = BLINK_Compact_sizeofVLC(in[0]);
+
+            /* size is a u32 */
+            if((preambleLen == 0U) || (preambleLen > 5U)){
+
+                BLINK_ERROR("invalid size preamble")
+                retval = BLINK_FRAME_ERROR;
+            }
+            else if(avail < preambleLen){
+
+                self->need = preambleLen - avail;
+            }
+            else if(!BLINK_Compact_decodeU32(BLINK_Stream_initBufferReadOnly(&stream, in, preambleLen), &size, &isNull) || isNull || (size == 0U)){
+
+                BLINK_ERROR("invalid size preamble")
+                retval = BLINK_FRAME_ERROR;
+            }
+            else if(avail == preambleLen){
+
+                self->need = 1U;
+            }
+            else{
+
+                idLen = BLINK_Compact_sizeofVLC(in[preambleLen]);
+                len = (uint64_t)preambleLen + (uint64_t)size;
+
+                if(idLen == 0U){
+
+                    BLINK_ERROR("invalid group ID")
+                    retval = BLINK_FRAME_ERROR;
+                }
+                else if(idLen > size){
+
+                    BLINK_ERROR("group ID overruns frame")
+                    retval = BLINK_FRAME_ERROR;
+                }
+                else if((avail - preambleLen) < idLen){
+
+                    self->need = idLen - (avail - preambleLen);
+                }
+                else if(!BLINK_Compact_decodeU64(BLINK_Stream_initBufferReadOnly(&stream, &in[preambleLen], idLen), &id, &isNull) || isNull){
+
+                    BLINK_ERROR("invalid group ID")
+                    retval = BLINK_FRAME_ERROR;
+                }
+                /* drop frames the schema cannot decode without buffering them */
+                else if((self->schema != NULL) && (BLINK_Schema_getGroupByID(self->schema, id) == NULL)){
+
+                    self->discard = len;
+                    self->skipped++;
+                    more = true;
+                }
+                else if(len > (uint64_t)self->size){
+
+                    BLINK_ERROR("frame is larger than buffer")
+                    retval = BLINK_FRAME_ERROR;
+                }
+                else if((uint64_t)avail < len){
+
+                    self->need = len - (uint64_t)avail;
+                }
+                else{
+
+                    frame->data = in;
+                    frame->len = (size_t)len;
+                    frame->size = size;
+                    frame->id = id;
+                    frame->body = &in[preambleLen + idLen];
+                    frame->bodyLen = (size_t)size - idLen;
+
+                    self->start += (size_t)len;
+
+                    retval = BLINK_FRAME_OK;
+                }
+            }
+        }
+    }
+
+    return retval;
+}
+
+uint8_t *BLINK_Frame_reserve(struct blink_frame_reader *self, size_t *space)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(space != NULL)
+
+    /* only the unread part of a partial frame is moved */
+    if(self->start > 0U){
+
+        (void)memmove(self->buf, &self->buf[self->start], self->end - self->start);
+        self->end -= self->start;
+        self->start = 0U;
+    }
+
+    *space = self->size - self->end;
+
+    return &self->buf[self->end];
+}
+
+void BLINK_Frame_commit(struct blink_frame_reader *self, size_t nbyte)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(nbyte <= (self->size - self->end))
+
+    self->end += nbyte;
+}
+
+bool BLINK_Frame_fill(struct blink_frame_reader *self, blink_stream_t in)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(in != NULL)
+
+    bool retval = false;
+    size_t space;
+    uint8_t *ptr = BLINK_Frame_reserve(self, &space);
+    uint64_t max = BLINK_Stream_max(in);
+    uint64_t n = (max > 0U) ? (max - BLINK_Stream_tell(in)) : self->need;
+
+    n = (n < (uint64_t)space) ? n : (uint64_t)space;
+
+    if(n > 0U){
+
+        retval = BLINK_Stream_read(in, ptr, (size_t)n);
+
+        if(retval){
+
+            BLINK_Frame_commit(self, (size_t)n);
+        }
+    }
+
+    return retval;
+}
+
@@ -0,0 +1,249 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+#ifndef BLINK_NO_FILE
+
+/* includes ***********************************************************/
+
+#include "blink_iovec.h"
+#include "blink_debug.h"
+
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+
+/* defines ************************************************************/
+
+#ifndef IOV_MAX
+    /* POSIX minimum */
+    #define IOV_MAX 16
+#endif
+
+/* static function prototypes *****************************************/
+
+static bool iovWrite(void *state, const void *in, size_t bytesToWrite);
+static bool iovWriteRef(void *state, const void *in, size_t bytesToWrite);
+static uint64_t iovTell(void *state);
+static void append(struct blink_iovec *self, const void *in, size_t size);
+
+/* functions **********************************************************/
+
+blink_stream_t BLINK_IOVec_initStream(struct blink_iovec *self, struct blink_stream *stream, int fd, struct iovec *iov, size_t iovMax, void *buffer, size_t bufferSize, size_t threshold)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(stream != NULL)
+    BLINK_ASSERT(iov != NULL)
+    BLINK_ASSERT(iovMax > 0U)
+    BLINK_ASSERT((bufferSize == 0U) || (buffer != NULL))
+
+    static const struct blink_stream_user fn = {
+        .write = iovWrite,
+        .writeRef = iovWriteRef,
+        .tell = iovTell
+    };
+
+    (void)memset(self, 0, sizeof(*self));
+
+    self->fd = fd;
+    self->iov = iov;
+    self->iovMax = iovMax;
+    self->buf = (uint8_t *)buffer;
+    self->bufSize = (buffer != NULL) ? bufferSize : 0U;
+    self->threshold = threshold;
+
+    return BLINK_Stream_initUser(stream, self, fn);
+}
+
+bool BLINK_IOVec_flush(struct blink_iovec *self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    bool retval = true;
+    size_t i = 0U;
+    size_t count;
+    ssize_t n;
+
+    while(retval && (i < self->iovCount)){
+
+        count = self->iovCount - i;
+        count = (count < (size_t)IOV_MAX) ? count : (size_t)IOV_MAX;
+
+        n = writev(self->fd, &self->iov[i], (int)count);
+
+        if(n > 0){
+
+            self->sent += (uint64_t)n;
+
+            /* consume whole segments and then part of the next */
+            while((n > 0) && ((size_t)n >= self->iov[i].iov_len)){
+
+                n -= (ssize_t)self->iov[i].iov_len;
+                i++;
+            }
+
+            if(n > 0){
+
+                self->iov[i].iov_base = &((uint8_t *)self->iov[i].iov_base)[n];
+                self->iov[i].iov_len -= (size_t)n;
+            }
+        }
+        else if((n < 0) && (errno == EINTR)){
+
+            /* try again */
+        }
+        else{
+
+            BLINK_ERROR("writev()")
+            retval = false;
+        }
+    }
+
+    if(retval){
+
+        self->iovCount = 0U;
+        self->bufLen = 0U;
+    }
+    else{
+
+        /* keep what could not be written for the next flush (the
+         * coalescing buffer is reclaimed once everything is written) */
+        (void)memmove(self->iov, &self->iov[i], (self->iovCount - i) * sizeof(*self->iov));
+        self->iovCount -= i;
+    }
+
+    return retval;
+}
+
+/* static functions ***************************************************/
+
+static bool iovWrite(void *state, const void *in, size_t bytesToWrite)
+{
+    struct blink_iovec *self = (struct blink_iovec *)state;
+    bool retval = true;
+    const struct iovec *last;
+
+    if(bytesToWrite > 0U){
+
+        /* too large to copy so reference it and send it now */
+        if(bytesToWrite > self->bufSize){
+
+            retval = BLINK_IOVec_flush(self);
+
+            if(retval){
+
+                append(self, in, bytesToWrite);
+                retval = BLINK_IOVec_flush(self);
+
+                /* the caller's memory must not stay referenced after a
+                 * failed write (a part of it may have been written) */
+                if(!retval && (self->iovCount > 0U)){
+
+                    self->iovCount--;
+                }
+            }
+        }
+        else{
+
+            if((self->bufSize - self->bufLen) < bytesToWrite){
+
+                retval = BLINK_IOVec_flush(self);
+            }
+
+            if(retval){
+
+                last = (self->iovCount > 0U) ? &self->iov[self->iovCount - 1U] : NULL;
+
+                /* extend the last segment if it ends where this copy begins */
+                if((last != NULL) && (&((uint8_t *)last->iov_base)[last->iov_len] == &self->buf[self->bufLen])){
+
+                    self->iov[self->iovCount - 1U].iov_len += bytesToWrite;
+                }
+                else{
+
+                    if(self->iovCount == self->iovMax){
+
+                        retval = BLINK_IOVec_flush(self);
+                    }
+
+                    if(retval){
+
+                        append(self, &self->buf[self->bufLen], bytesToWrite);
+                    }
+                }
+
+                if(retval){
+
+                    (void)memcpy(&self->buf[self->bufLen], in, bytesToWrite);
+                    self->bufLen += bytesToWrite;
+                }
+            }
+        }
+
+        if(retval){
+
+            self->pos += bytesToWrite;
+        }
+    }
+
+    return retval;
+}
+
+static bool iovWriteRef(void *state, const void *in, size_t bytesToWrite)
+{
+    struct blink_iovec *self = (struct blink_iovec *)state;
+    bool retval = true;
+
+    if((bytesToWrite == 0U) || (bytesToWrite < self->threshold)){
+
+        retval = iovWrite(state, in, bytesToWrite);
+    }
+    else{
+
+        if(self->iovCount == self->iovMax){
+
+            retval = BLINK_IOVec_flush(self);
+        }
+
+        if(retval){
+
+            append(self, in, bytesToWrite);
+            self->pos += bytesToWrite;
+        }
+    }
+
+    return retval;
+}
+
+static uint64_t iovTell(void *state)
+{
+    return ((const struct blink_iovec *)state)->pos;
+}
+
+static void append(struct blink_iovec *self, const void *in, size_t size)
+{
+    self->iov[self->iovCount].iov_base = (void *)in;
+    self->iov[self->iovCount].iov_len = size;
+    self->iovCount++;
+}
+
+#endif
@@ -177,7 +177,7 @@ enum blink_token BLINK_Lexer_getToken(blink_stream_t in, char *buffer, size_t ma
             }
         }
             
-        (void)BLINK_Stream_seekCur(in, (int32_t)sizeof(c));
+        (void)BLINK_Stream_seekCur(in, (int64_t)sizeof(c));
     }
 
     /* skip comment */
@@ -185,7 +185,7 @@ enum blink_token BLINK_Lexer_getToken(blink_stream_t in, char *buffer, size_t ma
 
         while(BLINK_Stream_peek(in, &c)){
 
-            (void)BLINK_Stream_seekCur(in, (int32_t)sizeof(c));
+            (void)BLINK_Stream_seekCur(in, (int64_t)sizeof(c));
 
             if(c == '\n'){
 
@@ -199,14 +199,14 @@ enum blink_token BLINK_Lexer_getToken(blink_stream_t in, char *buffer, size_t ma
         }
     }
 
-    size_t pos = BLINK_Stream_tell(in);
+    uint64_t pos = BLINK_Stream_tell(in);
 
     if(!BLINK_Stream_read(in, &c, sizeof(c)) || (c == '\0')){
 
         return TOK_EOF;
     }
 
-    (void)BLINK_Stream_seekSet(in, (uint32_t)pos);
+    (void)BLINK_Stream_seekSet(in, pos);
 
     if(isCName(in, &enomem, buffer, max, &value->literal.len)){
 
@@ -220,14 +220,14 @@ enum blink_token BLINK_Lexer_getToken(blink_stream_t in, char *buffer, size_t ma
         return TOK_ENOMEM;
     }
 
-    (void)BLINK_Stream_seekSet(in, (uint32_t)pos);
+    (void)BLINK_Stream_seekSet(in, pos);
         
     if(stringToToken(in, &retval)){
 
         return retval;
     }
 
-    (void)BLINK_Stream_seekSet(in, (uint32_t)pos);
+    (void)BLINK_Stream_seekSet(in, pos);
 
     if(isLiteral(in, &enomem, buffer, max, &value->literal.len)){
 
@@ -241,7 +241,7 @@ enum blink_token BLINK_Lexer_getToken(blink_stream_t in, char *buffer, size_t ma
         return TOK_ENOMEM;
     }
                 
-    (void)BLINK_Stream_seekSet(in, (uint32_t)pos);
+    (void)BLINK_Stream_seekSet(in, pos);
 
     if(isName(in, &enomem, buffer, max, &value->literal.len)){
 
@@ -255,21 +255,21 @@ enum blink_token BLINK_Lexer_getToken(blink_stream_t in, char *buffer, size_t ma
         return TOK_ENOMEM;
     }
                     
-    (void)BLINK_Stream_seekSet(in, (uint32_t)pos);
+    (void)BLINK_Stream_seekSet(in, pos);
                         
     if(isHexNumber(in, &value->number)){
 
         return TOK_UINT;                            
     }
                         
-    (void)BLINK_Stream_seekSet(in, (uint32_t)pos);
+    (void)BLINK_Stream_seekSet(in, pos);
 
     if(isUnsignedNumber(in, &value->number)){
 
         return TOK_UINT;
     }
 
-    (void)BLINK_Stream_seekSet(in, (uint32_t)pos);
+    (void)BLINK_Stream_seekSet(in, pos);
               
     if(isSignedNumber(in, &value->signedNumber)){
 
@@ -308,11 +308,11 @@ static bool stringToToken(blink_stream_t in, enum blink_token *token)
     size_t i;
     char buf[20U];
     bool retval = false;
-    size_t pos = BLINK_Stream_tell(in);
+    uint64_t pos = BLINK_Stream_tell(in);
 
     for(i=0; i < (sizeof(tokenTable)/sizeof(*tokenTable)); i++){
 
-        (void)BLINK_Stream_seekSet(in, (uint32_t)pos);
+        (void)BLINK_Stream_seekSet(in, pos);
 
         BLINK_ASSERT(sizeof(buf) > tokenTable[i].size)
 
@@ -436,7 +436,7 @@ static bool isName(blink_stream_t in, bool *enomem, char *out, size_t outMax, si
 
                     if(isNameChar(c)){
 
-                        (void)BLINK_Stream_seekCur(in, (int32_t)sizeof(c));
+                        (void)BLINK_Stream_seekCur(in, (int64_t)sizeof(c));
 
                         if(pos < outMax){
 
@@ -511,7 +511,7 @@ static bool isCName(blink_stream_t in, bool *enomem, char *out, size_t outMax, s
                             
                             while(BLINK_Stream_peek(in, &c) && isNameChar(c)){
 
-                                (void)BLINK_Stream_seekCur(in, (int32_t)sizeof(c));
+                                (void)BLINK_Stream_seekCur(in, (int64_t)sizeof(c));
 
                                 if(pos < outMax){
 
@@ -574,7 +574,7 @@ static bool isUnsignedNumber(blink_stream_t in, uint64_t *out)
                     /* todo: overflow protect */
                     *out *= 10;                
                     *out += digit;
-                    (void)BLINK_Stream_seekCur(in, (int32_t)sizeof(c));
+                    (void)BLINK_Stream_seekCur(in, (int64_t)sizeof(c));
                 }
                 else{
 
@@ -609,7 +609,7 @@ static bool isSignedNumber(blink_stream_t in, int64_t *out)
                     if(isInteger(c, &digit)){
 
                         *out = (int64_t)digit;
-                        (void)BLINK_Stream_seekCur(in, (int32_t)sizeof(c));
+                        (void)BLINK_Stream_seekCur(in, (int64_t)sizeof(c));
                         retval = true;
                     }
                 }                
@@ -629,7 +629,7 @@ static bool isSignedNumber(blink_stream_t in, int64_t *out)
                         /* todo: overflow protect */
                         *out *= 10;                
                         *out += digit;
-                        (void)BLINK_Stream_seekCur(in, (int32_t)sizeof(c));
+                        (void)BLINK_Stream_seekCur(in, (int64_t)sizeof(c));
                     }
                     else{
 
@@ -671,7 +671,7 @@ static bool isHexNumber(blink_stream_t in, uint64_t *out)
 
                         if(isHexInteger(c, &digit)){
 
-                            (void)BLINK_Stream_seekCur(in, (int32_t)sizeof(c));
+                            (void)BLINK_Stream_seekCur(in, (int64_t)sizeof(c));
 
                             if(digits <= 16U){
 
@@ -26,6 +26,7 @@
 #include "blink_compact.h"
 #include "blink_stream.h"
 #include "blink_schema.h"
+#include "blink_arena.h"
 #include "blink_debug.h"
 
 #include <stddef.h>
@@ -59,19 +60,20 @@ union blink_object_value {
 
 struct sequence_elem {
     union blink_object_value value;
-    struct sequence_elem *next;
+    uint32_t capacity;              /**< bytes allocated at value.string.data (zero if not owned) */
 };
 
 struct blink_object_field {
-    blink_schema_t definition;           /**< field definition */
+    const struct blink_field_desc *desc;    /**< field descriptor */
     union {
         union blink_object_value value;
         struct sequence_type {
-            struct sequence_elem *head;
-            struct sequence_elem *tail;
-            uint32_t size;
+            struct sequence_elem *elems;    /**< contiguous array of elements */
+            uint32_t size;                  /**< number of elements in use */
+            uint32_t capacity;              /**< number of elements allocated (elements beyond `size` are retained for reuse) */
         } sequence;
     } data;                         /**< field data may be singular or sequence */
+    uint32_t capacity;              /**< bytes allocated at data.value.string.data (zero if not owned) */
     bool initialised;               /**< true if data has been initialised */
 };
 
@@ -88,11 +90,13 @@ struct decode_state {
 
     struct stack_element {
 
-        uint32_t i;
+        const struct blink_decode_op *pc;   /**< next operation in decode program of `g` */
         uint32_t j;
+        uint32_t count;             /**< number of elements in the sequence being decoded */
         uint32_t max;
         blink_object_t g;
         struct blink_object_field *f;
+        bool isDynamic;             /**< group was encoded as a dynamic group */
 
     } stack[BLINK_OBJECT_NEST_DEPTH];
 
@@ -101,7 +105,11 @@ struct decode_state {
     blink_schema_t schema;
     const struct blink_allocator *alloc;
     union blink_object_value *value;
+    uint32_t *capacity;
     bool *initialised;
+    bool zeroCopy;                  /**< borrow string data from the input stream */
+    blink_object_t target;          /**< existing group to decode into (NULL to create a new group) */
+    const struct blink_field_mask *mask;    /**< top level fields to decode (NULL for all) */
     
     #if BLINK_OBJECT_NEST_DEPTH > UINT8_MAX
     #error "BLINK_OBJECT_NEST_DEPTH will overflow depth index"
@@ -109,41 +117,75 @@ struct decode_state {
     uint8_t depth;
 };
 
-struct field_init_user_data {
-    struct blink_object *self;
-    size_t i;
-};
+typedef bool (* handler)(struct decode_state *, const struct blink_decode_op *);
 
-typedef bool (* handler)(struct decode_state *);
+/* used to share scope while measuring an encoded group */
+struct measure_state {
+    struct blink_stream bounded;
+    blink_schema_t schema;
+    bool zeroCopy;
+    size_t size;                    /**< bytes the decoder would allocate so far */
+    uint8_t depth;
+};
 
 /* static function prototypes *****************************************/
 
+static blink_object_t decodeGroup(blink_stream_t in, struct decode_state *self);
 static bool decodeCompact_groupHeader(blink_stream_t in, struct decode_state *self);
-static bool decodeCompact_bool(struct decode_state *self);
-static bool decodeCompact_i8(struct decode_state *self);
-static bool decodeCompact_i16(struct decode_state *self);
-static bool decodeCompact_i32(struct decode_state *self);
-static bool decodeCompact_i64(struct decode_state *self);
-static bool decodeCompact_u8(struct decode_state *self);
-static bool decodeCompact_u16(struct decode_state *self);
-static bool decodeCompact_u32(struct decode_state *self);
-static bool decodeCompact_u64(struct decode_state *self);
-static bool decodeCompact_decimal(struct decode_state *self);
-static bool decodeCompact_f64(struct decode_state *self);
-static bool decodeCompact_string(struct decode_state *self);
-static bool decodeCompact_fixed(struct decode_state *self);
-static bool decodeCompact_enum(struct decode_state *self);
-static bool decodeCompact_staticGroup(struct decode_state *self);
-static bool decodeCompact_dynamicGroup(struct decode_state *self);
-
-static bool BLINK_Object_set(blink_object_t group, const char *fieldName, const union blink_object_value *value);
-static union blink_object_value BLINK_Object_get(blink_object_t group, const char *fieldName);
-
-static struct blink_object_field *lookupField(struct blink_object *group, const char *name, size_t nameLen);
+static bool decodeCompact_bool(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_i8(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_i16(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_i32(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_i64(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_u8(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_u16(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_u32(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_u64(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_decimal(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_f64(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_string(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_fixed(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_enum(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_staticGroup(struct decode_state *self, const struct blink_decode_op *op);
+static bool decodeCompact_dynamicGroup(struct decode_state *self, const struct blink_decode_op *op);
+static bool readString(struct decode_state *self, uint32_t size);
+static bool isSelected(const struct blink_field_mask *mask, uint32_t field);
+static bool decodeIntegerSequence(struct decode_state *self, enum blink_type_tag type);
+static struct sequence_elem *appendElem(struct blink_object_field *field, const struct blink_allocator *alloc);
+static bool reserveElems(struct blink_object_field *field, const struct blink_allocator *alloc, uint32_t capacity);
+static bool growElems(struct blink_object_field *field, const struct blink_allocator *alloc, uint32_t size);
+static void clearElems(struct blink_object_field *field);
+static blink_object_t acquireGroup(struct decode_state *self, blink_schema_t group);
+
+static bool reserveString(const struct blink_allocator *alloc, union blink_object_value *value, uint32_t *capacity, uint32_t size);
+static void releaseString(const struct blink_allocator *alloc, union blink_object_value *value, uint32_t *capacity);
+static void destroyValue(blink_object_t group, enum blink_type_tag type, union blink_object_value *value, uint32_t *capacity);
+static void destroyElems(blink_object_t group, struct blink_object_field *field);
+static void resetValue(enum blink_type_tag type, union blink_object_value *value, const uint32_t *capacity);
+
+static bool setValue(blink_object_t group, const struct blink_field_desc *desc, union blink_object_value *to, uint32_t *capacity, const union blink_object_value *value);
+static bool setField(blink_object_t group, struct blink_object_field *field, const union blink_object_value *value);
+static union blink_object_value getField(const struct blink_object_field *field);
+static bool appendField(blink_object_t group, struct blink_object_field *field, const union blink_object_value *value);
+static bool setElem(blink_object_t group, struct blink_object_field *field, uint32_t index, const union blink_object_value *value);
+static union blink_object_value getElem(const struct blink_object_field *field, uint32_t index);
+static bool appendElems(blink_object_t group, struct blink_object_field *field, enum blink_type_tag base, uint32_t n, struct sequence_elem **first);
+static enum blink_type_tag baseType(enum blink_type_tag type);
+
+static blink_schema_t lookupDefinition(const struct blink_object *group, const char *name);
+static struct blink_object_field *lookupField(struct blink_object *group, blink_schema_t field);
 static bool encodeBody(const blink_object_t g, blink_stream_t out);
+static bool encodeGroup(const blink_object_t g, blink_stream_t out);
 static bool cacheSize(blink_object_t group);
-
-static bool initFieldsHandler(blink_schema_t group, blink_schema_t field, void *user);
+static size_t alignedSize(size_t size);
+static void addSize(size_t *size, size_t n);
+static size_t sizeofNewGroup(blink_schema_t group);
+static bool boundGroup(blink_schema_t group, uint8_t depth, size_t *size);
+static bool measureGroup(struct measure_state *self, blink_schema_t group);
+static bool measureSequence(struct measure_state *self, const struct blink_field_desc *desc);
+static bool measureValue(struct measure_state *self, const struct blink_field_desc *desc);
+static bool measureString(struct measure_state *self, uint32_t size);
+static bool measureDynamicGroup(struct measure_state *self, const struct blink_field_desc *desc);
 
 /* functions **********************************************************/
 
@@ -157,55 +199,47 @@ void BLINK_Object_destroyGroup(blink_object_t *group)
     
         for(i=0U; i < (*group)->numberOfFields; i++){
             
-            enum blink_type_tag type = BLINK_Field_getType((*group)->fields[i].definition);
             struct blink_object_field *f = &(*group)->fields[i];
-            bool isSequence = BLINK_Field_isSequence(f->definition);
-            struct sequence_elem *elem = (isSequence) ? f->data.sequence.head : NULL;
-            
-            if(!isSequence || (elem != NULL)){
+            enum blink_type_tag type = f->desc->type;
 
-                do{
+            if(f->desc->isSequence){
 
-                    union blink_object_value *value = (isSequence) ? &elem->value : &f->data.value;
+                destroyElems(*group, f);
+            }
+            else{
 
-                    switch(type){
-                    case BLINK_TYPE_STRING:            
-                    case BLINK_TYPE_BINARY:
-                    case BLINK_TYPE_FIXED:
-                        if((*group)->alloc.free != NULL){                
-                            (*group)->alloc.free((void *)value->string.data);
-                            value->string.data = NULL;
-                        }
-                        break;
-                    case BLINK_TYPE_DYNAMIC_GROUP:
-                    case BLINK_TYPE_STATIC_GROUP:
-                        BLINK_Object_destroyGroup(&value->group);
-                        break;
-                    default:
-                        break;
-                    }
+                destroyValue(*group, type, &f->data.value, &f->capacity);
+            }
+        }
+
+        BLINK_Allocator_free(&(*group)->alloc, (*group)->fields);
+        BLINK_Allocator_free(&(*group)->alloc, *group);
+                    
+        *group = NULL;
+    }
+}
 
-                    if(isSequence){
+void BLINK_Object_reset(blink_object_t group)
+{
+    BLINK_ASSERT(group != NULL)
 
-                        struct sequence_elem *cur = elem;
-                        elem = elem->next;
+    uint32_t i;
 
-                        if((*group)->alloc.free != NULL){                
+    for(i=0U; i < group->numberOfFields; i++){
 
-                            (*group)->alloc.free(cur);
-                        }
-                    }
-                }
-                while(elem != NULL);
-            }                        
+        struct blink_object_field *f = &group->fields[i];
+        enum blink_type_tag type = f->desc->type;
+
+        f->initialised = false;
+
+        if(f->desc->isSequence){
+
+            clearElems(f);
         }
+        else{
 
-        if((*group)->alloc.free != NULL){
-            
-            (*group)->alloc.free(*group);
+            resetValue(type, &f->data.value, &f->capacity);
         }
-                    
-        *group = NULL;
     }
 }
 
@@ -216,9 +250,9 @@ blink_object_t BLINK_Object_newGroup(const struct blink_allocator *alloc, blink_
 
     blink_object_t retval = NULL;
 
-    if(alloc->calloc != NULL){
+    if(BLINK_Allocator_isValid(alloc)){
 
-        struct blink_object *self = alloc->calloc(1U, sizeof(struct blink_object));
+        struct blink_object *self = BLINK_Allocator_calloc(alloc, 1U, sizeof(struct blink_object));
 
         if(self != NULL){
 
@@ -229,26 +263,25 @@ blink_object_t BLINK_Object_newGroup(const struct blink_allocator *alloc, blink_
 
             if(self->numberOfFields > 0U){
 
-                self->fields = self->alloc.calloc(self->numberOfFields, sizeof(struct blink_object_field));
+                self->fields = BLINK_Allocator_calloc(&self->alloc, self->numberOfFields, sizeof(struct blink_object_field));
 
                 if(self->fields != NULL){
 
-                    struct field_init_user_data user = {
-                        .self = self,
-                        .i = 0U
-                    };
+                    const struct blink_field_desc *desc = BLINK_Group_getFieldDescs(group);
+                    size_t i;
+
+                    for(i=0U; i < self->numberOfFields; i++){
+
+                        self->fields[i].desc = &desc[i];
+                    }
 
-                    BLINK_Group_eachField(group, initFieldsHandler, &user);
                     retval = (blink_object_t)self;
                 }
                 else{
 
                     BLINK_ERROR("calloc()")
 
-                    if(alloc->free != NULL){
-
-                        alloc->free(self);
-                    }
+                    BLINK_Allocator_free(alloc, self);
                 }
             }
             else{
@@ -271,189 +304,186 @@ blink_object_t BLINK_Object_newGroup(const struct blink_allocator *alloc, blink_
 
 blink_object_t BLINK_Object_decodeCompact(blink_stream_t in, blink_schema_t schema, const struct blink_allocator *alloc)
 {
-    const static handler decoder[] = {
-        decodeCompact_string,       /* BLINK_TYPE_STRING */
-        decodeCompact_string,       /* BLINK_TYPE_BINARY */
-        decodeCompact_fixed,        /* BLINK_TYPE_FIXED */
-        decodeCompact_bool,         /* BLINK_TYPE_BOOL */
-        decodeCompact_u8,           /* BLINK_TYPE_U8 */
-        decodeCompact_u16,          /* BLINK_TYPE_U16 */
-        decodeCompact_u32,          /* BLINK_TYPE_U32 */
-        decodeCompact_u64,          /* BLINK_TYPE_U64 */
-        decodeCompact_i8,           /* BLINK_TYPE_I8 */
-        decodeCompact_i16,          /* BLINK_TYPE_I16 */
-        decodeCompact_i32,          /* BLINK_TYPE_I32 */
-        decodeCompact_i64,          /* BLINK_TYPE_I64 */
-        decodeCompact_f64,          /* BLINK_TYPE_F64 */
-        decodeCompact_i32,          /* BLINK_TYPE_DATE */
-        decodeCompact_u32,          /* BLINK_TYPE_TIME_OF_DAY_MILLI */
-        decodeCompact_u64,          /* BLINK_TYPE_TIME_OF_DAY_NANO */
-        decodeCompact_i64,          /* BLINK_TYPE_NANO_TIME */
-        decodeCompact_i64,          /* BLINK_TYPE_MILLI_TIME */
-        decodeCompact_decimal,      /* BLINK_TYPE_DECIMAL */
-        decodeCompact_dynamicGroup, /* BLINK_TYPE_OBJECT */
-        decodeCompact_enum,         /* BLINK_TYPE_ENUM */
-        decodeCompact_staticGroup,   /* BLINK_TYPE_STATIC_GROUP */
-        decodeCompact_dynamicGroup  /* BLINK_TYPE_DYNAMIC_GROUP */
-    };
+    return BLINK_Object_decodeCompactWithOptions(in, schema, alloc, NULL);
+}
 
-    blink_object_t retval = NULL;    
+blink_object_t BLINK_Object_decodeCompactWithOptions(blink_stream_t in, blink_schema_t schema, const struct blink_allocator *alloc, const struct blink_decode_options *options)
+{
     struct decode_state self;
-    bool isNull;
-    bool error = false;
     
     (void)memset(&self, 0, sizeof(self));
 
     self.top = self.stack;
     self.alloc = alloc;
     self.schema = schema;
+    self.zeroCopy = (options != NULL) && options->zeroCopy && BLINK_Stream_canBorrow(in);
+    self.mask = (options != NULL) ? options->mask : NULL;
+
+    return decodeGroup(in, &self);
+}
+
+bool BLINK_Object_decodeCompactInto(blink_stream_t in, blink_schema_t schema, blink_object_t group, const struct blink_decode_options *options)
+{
+    BLINK_ASSERT(group != NULL)
+
+    struct decode_state self;
+    
+    (void)memset(&self, 0, sizeof(self));
+
+    self.top = self.stack;
+    self.alloc = &group->alloc;
+    self.schema = schema;
+    self.target = group;
+    self.zeroCopy = (options != NULL) && options->zeroCopy && BLINK_Stream_canBorrow(in);
+    self.mask = (options != NULL) ? options->mask : NULL;
+
+    return (decodeGroup(in, &self) != NULL);
+}
 
-    if(decodeCompact_groupHeader(in, &self)){
+bool BLINK_Object_initMask(struct blink_field_mask *mask, blink_schema_t group)
+{
+    BLINK_ASSERT(mask != NULL)
+    BLINK_ASSERT(group != NULL)
 
-        while(!error){
+    bool retval = false;
 
-            if(self.top->i < self.top->g->numberOfFields){
+    (void)memset(mask, 0, sizeof(*mask));
 
-                self.top->f = &self.top->g->fields[self.top->i];
+    if(BLINK_Group_numberOfFields(group) <= BLINK_OBJECT_MASK_FIELDS){
 
-                enum blink_type_tag type = BLINK_Field_getType(self.top->f->definition);
+        mask->group = group;
+        retval = true;
+    }
+    else{
 
-                if(BLINK_Field_isSequence(self.top->f->definition)){
+        BLINK_ERROR("group has more than BLINK_OBJECT_MASK_FIELDS fields")
+    }
 
-                    if(self.top->j == 0){
+    return retval;
+}
 
-                        if(BLINK_Compact_decodeU32(&self.bounded, &self.top->f->data.sequence.size, &isNull)){
+bool BLINK_Object_maskSelect(struct blink_field_mask *mask, const char *fieldName)
+{
+    BLINK_ASSERT(mask != NULL)
+    BLINK_ASSERT(fieldName != NULL)
 
-                            self.top->j++;
+    return BLINK_Object_maskSelectByField(mask, BLINK_Group_getFieldByName(mask->group, fieldName));
+}
 
-                            if(isNull){
+bool BLINK_Object_maskSelectByField(struct blink_field_mask *mask, blink_schema_t field)
+{
+    BLINK_ASSERT(mask != NULL)
 
-                                if(BLINK_Field_isOptional(self.top->f->definition)){
+    bool retval = false;
+    uint32_t i;
 
-                                    self.top->j = 0U;
-                                    self.top->i++;
-                                }
-                                else{
+    if((field != NULL) && (mask->group != NULL)){
 
-                                    BLINK_ERROR("cannot be NULL")
-                                    error = true;
-                                }             
-                            }
-                        }
-                        else{
+        i = BLINK_Field_getIndex(field);
 
-                            error = true;
-                        }
-                    }
-                    else{
+        /* a field handle from another group will not match */
+        if((i < BLINK_Group_numberOfFields(mask->group)) && (BLINK_Group_getFieldDescs(mask->group)[i].field == field)){
 
-                        if(self.top->j <= self.top->f->data.sequence.size){
-                        
-                            struct sequence_elem *elem = alloc->calloc(1, sizeof(struct sequence_elem));
+            mask->selected[i / 8U] |= (uint8_t)(1U << (i % 8U));
+            retval = true;
+        }
+    }
 
-                            if(elem == NULL){
+    return retval;
+}
 
-                                BLINK_ERROR("calloc()")
-                                error = true;
-                            }
-                            else{
+bool BLINK_Object_getDecodeBound(blink_schema_t group, size_t *size)
+{
+    BLINK_ASSERT(group != NULL)
+    BLINK_ASSERT(size != NULL)
 
-                                if(self.top->f->data.sequence.tail == NULL){
+    *size = alignedSize(sizeof(struct blink_arena));
 
-                                    self.top->f->data.sequence.head = elem;
-                                    self.top->f->data.sequence.tail = elem;
-                                }
-                                else{
+    return boundGroup(group, 0U, size);
+}
 
-                                    self.top->f->data.sequence.tail->next = elem;
-                                    self.top->f->data.sequence.tail = elem;                            
-                                }
+bool BLINK_Object_sizeofDecodeCompact(const uint8_t *in, uint32_t inLen, blink_schema_t schema, const struct blink_decode_options *options, size_t *size)
+{
+    BLINK_ASSERT(in != NULL)
+    BLINK_ASSERT(schema != NULL)
+    BLINK_ASSERT(size != NULL)
 
-                                self.value = &elem->value;
-                                self.top->j++;
-                                self.initialised = NULL;
-                                
-                                //callout
-                                error = (decoder[type](&self)) ? false : true;
-                            }
-                        }
-                        else{
+    struct measure_state self;
+    struct blink_stream stream;
+    bool retval = false;
+    bool isNull;
+    uint32_t max;
+    uint64_t id;
 
-                            self.top->j = 0U;
-                            self.top->i++;
-                        }
-                    }
+    (void)memset(&self, 0, sizeof(self));
+
+    self.schema = schema;
+    self.zeroCopy = (options != NULL) && options->zeroCopy;
+    self.size = alignedSize(sizeof(struct blink_arena));
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, in, inLen);
+
+    if(BLINK_Compact_decodeU32(&stream, &max, &isNull)){
+
+        if(isNull || (max == 0U)){
+
+            BLINK_ERROR("W1: Top level group size is NULL or zero")
+        }
+        else{
+
+            (void)BLINK_Stream_initBounded(&self.bounded, &stream, max);
+
+            if(BLINK_Compact_decodeU64(&self.bounded, &id, &isNull)){
+
+                blink_schema_t groupDef = (isNull) ? NULL : BLINK_Schema_getGroupByID(schema, id);
+
+                if(groupDef == NULL){
+
+                    BLINK_ERROR("W1: unknown group ID")
                 }
-                else{
+                else if(measureGroup(&self, groupDef)){
 
-                    //callout
-                    self.value = &self.top->f->data.value;
-                    self.initialised = &self.top->f->initialised;
-                    self.top->i++;
-                    error = (decoder[type](&self)) ? false : true;                                
-                }          
-            }
+                    if(BLINK_Stream_tell(&self.bounded) < BLINK_Stream_max(&self.bounded)){
 
-            if(!error){
-                
-                if(self.top->i == self.top->g->numberOfFields){
-
-                    if(
-                        (
-                            (self.top == self.stack)
-                            ||
-                            (
-                                (BLINK_Field_getType(self.top[-1].f->definition) == BLINK_TYPE_DYNAMIC_GROUP)
-                                ||
-                                (BLINK_Field_getType(self.top[-1].f->definition) == BLINK_TYPE_OBJECT)
-                            )
-                        )
-                        &&
-                        (BLINK_Stream_tell(&self.bounded) < BLINK_Stream_max(&self.bounded))
-                    ){
-                                
                         BLINK_ERROR("additional bytes at end of group are not allowed...for now")
-                        error = true;                        
                     }
-                    /* unwind */
                     else{
 
-                        if(self.top == self.stack){
-
-                            /* finished */
-                            retval = self.stack->g;
-                            break;
-                        }
-                        else{
-
-                            self.top = &self.top[-1];
-                            (void)BLINK_Stream_setMax(&self.bounded, self.top->max);
-                        }
+                        *size = self.size;
+                        retval = true;
                     }
                 }
-            }            
+                else{
+
+                    /* measureGroup() reports the error */
+                }
+            }
         }
     }
-    else{
 
-        error = true;
-    }
+    return retval;
+}
 
-    if(error){
+blink_object_t BLINK_Object_decodeCompactInBuffer(blink_stream_t in, blink_schema_t schema, void *buffer, size_t size, const struct blink_decode_options *options)
+{
+    BLINK_ASSERT(buffer != NULL)
+    BLINK_ASSERT(((size_t)buffer % BLINK_ARENA_ALIGN) == 0U)
 
-        if(BLINK_Stream_eof(in)){
+    blink_object_t retval = NULL;
+    size_t header = alignedSize(sizeof(struct blink_arena));
 
-            BLINK_ERROR("S1: group ended prematurely")
-        }
-        else{
+    if(size > header){
 
-            if(BLINK_Stream_eof(&self.bounded)){
+        /* arena lives at the front of the buffer so the decoded group
+         * (which refers to it) stays valid for as long as the buffer does */
+        blink_arena_t arena = BLINK_Arena_init((struct blink_arena *)buffer, &((uint8_t *)buffer)[header], size - header, NULL);
+        struct blink_allocator alloc = BLINK_Arena_getAllocator(arena);
 
-                BLINK_ERROR("S1: nested group ended prematurely")
-            }            
-        }
+        retval = BLINK_Object_decodeCompactWithOptions(in, schema, &alloc, options);
+    }
+    else{
 
-        BLINK_Object_destroyGroup(&self.stack->g);        
+        BLINK_ERROR("buffer is too small")
     }
 
     return retval;
@@ -465,15 +495,23 @@ bool BLINK_Object_encodeCompact(blink_object_t group, blink_stream_t out)
 
     if(BLINK_Group_hasID(group->definition)){
 
-        uint64_t id = BLINK_Group_getID(group->definition);
+        if(BLINK_Stream_canReserve(out)){
+
+            retval = encodeGroup(group, out);
+        }
+        else{
+
+            /* size preamble cannot be back-patched so must be known in advance */
+            uint64_t id = BLINK_Group_getID(group->definition);
 
-        if(cacheSize(group)){
+            if(cacheSize(group)){
 
-            if(BLINK_Compact_encodeU32(group->size + BLINK_Compact_sizeofUnsigned(id), out)){
+                if(BLINK_Compact_encodeU32(group->size + BLINK_Compact_sizeofUnsigned(id), out)){
 
-                if(BLINK_Compact_encodeU64(id, out)){
+                    if(BLINK_Compact_encodeU64(id, out)){
 
-                    retval = encodeBody(group, out);
+                        retval = encodeBody(group, out);
+                    }
                 }
             }
         }
@@ -490,43 +528,23 @@ bool BLINK_Object_append(blink_object_t group, const char *fieldName, const unio
 {
     BLINK_ASSERT(group != NULL)
 
-    bool retval = false;
-    struct blink_object_field *field = lookupField(group, fieldName, strlen(fieldName));
-
-    if(field != NULL){
-
-        if(BLINK_Field_isSequence(field->definition)){
-
-
-        }
-        else{
-
-            BLINK_ERROR("cannot append to a field which is not a sequence")
-        }
-    }
-    
-    return retval;
+    return appendField(group, lookupField(group, lookupDefinition(group, fieldName)), value);
 }
 
 void BLINK_Object_iterate(blink_object_t group, const char *fieldName, void *user, bool (*each)(void *user, const char *fieldName, const union blink_object_value *value))
 {
     BLINK_ASSERT(group != NULL)
 
-    struct sequence_elem *seq;
-    struct blink_object_field *field = lookupField(group, fieldName, strlen(fieldName));
-
-    if(field != NULL){
-
-        if(BLINK_Field_isSequence(field->definition)){
+    uint32_t i;
+    struct blink_object_field *field = lookupField(group, lookupDefinition(group, fieldName));
 
-            seq = field->data.sequence.head;
+    if((field != NULL) && field->desc->isSequence && field->initialised){
 
-            while(seq != NULL){
+        for(i=0U; i < field->data.sequence.size; i++){
 
-                if(!each(user, fieldName, &seq->value)){
+            if(!each(user, fieldName, &field->data.sequence.elems[i].value)){
 
-                    break;
-                }            
+                break;
             }
         }
     }
@@ -536,1288 +554,2774 @@ bool BLINK_Object_clear(blink_object_t group, const char *fieldName)
 {
     BLINK_ASSERT(group != NULL)
 
+    return BLINK_Object_clearByField(group, lookupDefinition(group, fieldName));
+}
+
+bool BLINK_Object_setEnum(blink_object_t group, const char *fieldName, const char *symbol)
+{
+    BLINK_ASSERT(group != NULL)
+    BLINK_ASSERT(symbol != NULL)
+
     bool retval = false;
-    struct blink_object_field *field = lookupField(group, fieldName, strlen(fieldName));
+    blink_schema_t field = lookupDefinition(group, fieldName);
 
     if(field != NULL){
 
-        field->initialised = false;
-        retval = true;
-    }
+        if(BLINK_Field_getType(field) == BLINK_TYPE_ENUM){
 
-    return retval;
-}
+            blink_schema_t s = BLINK_Enum_getSymbolByName(BLINK_Field_getEnum(field), symbol);
 
-bool BLINK_Object_setEnum(blink_object_t group, const char *fieldName, const char *symbol)
-{
-    union blink_object_value value = {.string = {.data = (uint8_t *)symbol}};
+            if(s != NULL){
+
+                retval = BLINK_Object_setEnumByField(group, field, s);
+            }
+            else{
+
+                BLINK_ERROR("enum symbol \"%s\" is undefined", symbol)
+            }
+        }
+        else{
+
+            BLINK_ERROR("field is not an enum")
+        }
+    }
 
-    return BLINK_Object_set(group, fieldName, &value);
+    return retval;
 }
 
 bool BLINK_Object_setBool(blink_object_t group, const char *fieldName, bool value)
 {
-    return BLINK_Object_set(group, fieldName, (union blink_object_value *)value);    
+    return BLINK_Object_setBoolByField(group, lookupDefinition(group, fieldName), value);
 }
 
 bool BLINK_Object_setDecimal(blink_object_t group, const char *fieldName, int64_t mantissa, int8_t exponent)
 {
-    union blink_object_value value = {.decimal = {.mantissa = mantissa, .exponent = exponent}};
-
-    return BLINK_Object_set(group, fieldName, &value);    
+    return BLINK_Object_setDecimalByField(group, lookupDefinition(group, fieldName), mantissa, exponent);
 }
 
 bool BLINK_Object_setUint(blink_object_t group, const char *fieldName, uint64_t value)
 {
-    return BLINK_Object_set(group, fieldName, (union blink_object_value *)&value);    
+    return BLINK_Object_setUintByField(group, lookupDefinition(group, fieldName), value);
 }
 
 bool BLINK_Object_setInt(blink_object_t group, const char *fieldName, int64_t value)
 {
-    return BLINK_Object_set(group, fieldName, (union blink_object_value *)&value);    
+    return BLINK_Object_setIntByField(group, lookupDefinition(group, fieldName), value);
 }
 
 bool BLINK_Object_setF64(blink_object_t group, const char *fieldName, double value)
 {
-    return BLINK_Object_set(group, fieldName, (union blink_object_value *)&value);    
+    return BLINK_Object_setF64ByField(group, lookupDefinition(group, fieldName), value);
 }
 
 bool BLINK_Object_setString(blink_object_t group, const char *fieldName, const char *str, uint32_t len)
 {
-    union blink_object_value value = {.string = {.data = (uint8_t *)str, .len = len}};
-
-    return BLINK_Object_set(group, fieldName, &value);        
+    return BLINK_Object_setStringByField(group, lookupDefinition(group, fieldName), str, len);
 }
 
 bool BLINK_Object_setString2(blink_object_t group, const char *fieldName, const char *str)
 {
-    union blink_object_value value = {.string = {.data = (uint8_t *)str, .len = (uint32_t)strlen(str)}};
-    
-    return BLINK_Object_set(group, fieldName, &value);        
+    return BLINK_Object_setStringByField(group, lookupDefinition(group, fieldName), str, (uint32_t)strlen(str));
 }
 
 bool BLINK_Object_setBinary(blink_object_t group, const char *fieldName, const uint8_t *data, uint32_t len)
 {
-    union blink_object_value value = {.string = {.data = data, .len = len}};
-    
-    return BLINK_Object_set(group, fieldName, &value);        
+    return BLINK_Object_setBinaryByField(group, lookupDefinition(group, fieldName), data, len);
 }
 
 bool BLINK_Object_setFixed(blink_object_t group, const char *fieldName, const uint8_t *data, uint32_t len)
 {
-    union blink_object_value value = {.string = {.data = data, .len = len}};
-    
-    return BLINK_Object_set(group, fieldName, &value);        
+    return BLINK_Object_setFixedByField(group, lookupDefinition(group, fieldName), data, len);
 }
 
 bool BLINK_Object_setGroup(blink_object_t group, const char *fieldName, blink_object_t value)
 {
-    return BLINK_Object_set(group, fieldName, (union blink_object_value *)value);        
+    return BLINK_Object_setGroupByField(group, lookupDefinition(group, fieldName), value);
 }
 
 bool BLINK_Object_fieldIsNull(blink_object_t group, const char *fieldName)
 {
-    BLINK_ASSERT(group != NULL)
-
-    bool retval = false;
-    struct blink_object_field *field = lookupField(group, fieldName, strlen(fieldName));
-
-    if(field != NULL){
-
-        retval = (false == field->initialised);
-    }
-
-    return retval;
+    return BLINK_Object_fieldIsNullByField(group, lookupDefinition(group, fieldName));
 }
 
 const char *BLINK_Object_getEnum(blink_object_t group, const char *fieldName)
 {
-    return (const char *)BLINK_Object_get(group, fieldName).string.data;
+    return BLINK_Object_getEnumByField(group, lookupDefinition(group, fieldName));
 }
 
 bool BLINK_Object_getBool(blink_object_t group, const char *fieldName)
 {
-    return BLINK_Object_get(group, fieldName).boolean;
+    return BLINK_Object_getBoolByField(group, lookupDefinition(group, fieldName));
 }
 
 void BLINK_Object_getDecimal(blink_object_t group, const char *fieldName, int64_t *mantissa, int8_t *exponent)
 {
-    union blink_object_value value = BLINK_Object_get(group, fieldName);
-
-    *mantissa = value.decimal.mantissa;
-    *exponent = value.decimal.exponent;
+    BLINK_Object_getDecimalByField(group, lookupDefinition(group, fieldName), mantissa, exponent);
 }
 
 uint64_t BLINK_Object_getUint(blink_object_t group, const char *fieldName)
 {
-    return BLINK_Object_get(group, fieldName).u64;
+    return BLINK_Object_getUintByField(group, lookupDefinition(group, fieldName));
 }
 
 int64_t BLINK_Object_getInt(blink_object_t group, const char *fieldName)
 {
-    return BLINK_Object_get(group, fieldName).i64;
+    return BLINK_Object_getIntByField(group, lookupDefinition(group, fieldName));
 }
 
 double BLINK_Object_getF64(blink_object_t group, const char *fieldName)
 {
-    return BLINK_Object_get(group, fieldName).f64;
+    return BLINK_Object_getF64ByField(group, lookupDefinition(group, fieldName));
 }
 
 void BLINK_Object_getString(blink_object_t group, const char *fieldName, const char **str, uint32_t *len)
 {
-    union blink_object_value value = BLINK_Object_get(group, fieldName);
-
-    *str = (char *)value.string.data;
-    *len = value.string.len;    
+    BLINK_Object_getStringByField(group, lookupDefinition(group, fieldName), str, len);
 }
 
 void BLINK_Object_getBinary(blink_object_t group, const char *fieldName, const uint8_t **data, uint32_t *len)
 {
-    union blink_object_value value = BLINK_Object_get(group, fieldName);
-
-    *data = value.string.data;
-    *len = value.string.len;
+    BLINK_Object_getBinaryByField(group, lookupDefinition(group, fieldName), data, len);
 }
 
 void BLINK_Object_getFixed(blink_object_t group, const char *fieldName, const uint8_t **data, uint32_t *len)
 {
-    union blink_object_value value = BLINK_Object_get(group, fieldName);
-
-    *data = value.string.data;
-    *len = value.string.len;
+    BLINK_Object_getFixedByField(group, lookupDefinition(group, fieldName), data, len);
 }   
 
 blink_object_t BLINK_Object_getGroup(blink_object_t group, const char *fieldName)
 {
-    return BLINK_Object_get(group, fieldName).group;
+    return BLINK_Object_getGroupByField(group, lookupDefinition(group, fieldName));
 }
 
-/* static functions ***************************************************/
-
-static bool decodeCompact_groupHeader(blink_stream_t in, struct decode_state *self)
+bool BLINK_Object_clearByField(blink_object_t group, blink_schema_t field)
 {
+    BLINK_ASSERT(group != NULL)
+
     bool retval = false;
-    bool isNull;
-    uint64_t id;    
-    
-    if(BLINK_Compact_decodeU32(in, &self->top->max, &isNull)){
-    
-        if(isNull || (self->top->max == 0U)){
+    struct blink_object_field *f = lookupField(group, field);
 
-            BLINK_ERROR("W1: Top level group size is NULL or zero")
-        }
-        else{
+    if(f != NULL){
 
-            (void)BLINK_Stream_initBounded(&self->bounded, in, self->top->max);
+        f->initialised = false;
+        retval = true;
+    }
 
-            if(BLINK_Compact_decodeU64(&self->bounded, &id, &isNull)){
+    return retval;
+}
 
-                if(isNull){
+bool BLINK_Object_fieldIsNullByField(blink_object_t group, blink_schema_t field)
+{
+    BLINK_ASSERT(group != NULL)
 
-                    BLINK_ERROR("W1: unknown group ID")                
-                }
-                else{
+    bool retval = false;
+    struct blink_object_field *f = lookupField(group, field);
 
-                    blink_schema_t groupDef = BLINK_Schema_getGroupByID(self->schema, id);
+    if(f != NULL){
 
-                    if(groupDef == NULL){
+        retval = (false == f->initialised);
+    }
 
-                        BLINK_ERROR("W1: unknown group ID")
-                    }
-                    else{
+    return retval;
+}
 
-                        self->top->g = BLINK_Object_newGroup(self->alloc, groupDef);
+bool BLINK_Object_setEnumByField(blink_object_t group, blink_schema_t field, blink_schema_t symbol)
+{
+    BLINK_ASSERT(symbol != NULL)
 
-                        if(self->top->g != NULL){
+    bool retval = false;
+    union blink_object_value value = {.i64 = (int64_t)BLINK_Symbol_getValue(symbol)};
+    blink_schema_t e = (field != NULL) ? BLINK_Field_getEnum(field) : NULL;
 
-                            retval = true;
-                        }                        
-                    }
-                }
-            }
-        }
+    if(e == NULL){
+
+        BLINK_ERROR("field is not an enum")
+    }
+    /* symbol values are unique within an enum */
+    else if(BLINK_Enum_getSymbolByValue(e, BLINK_Symbol_getValue(symbol)) != symbol){
+
+        BLINK_ERROR("enum symbol \"%s\" is undefined", BLINK_Symbol_getName(symbol))
+    }
+    else{
+
+        retval = setField(group, lookupField(group, field), &value);
     }
 
     return retval;
 }
 
-static bool decodeCompact_fixed(struct decode_state *self)
+bool BLINK_Object_setBoolByField(blink_object_t group, blink_schema_t field, bool value)
 {
-    bool retval = true;
-    bool isPresent = true;
-    struct stack_element *top = self->top;
-                
-    if(BLINK_Field_isOptional(top->f->definition)){
+    union blink_object_value v = {.boolean = value};
 
-        if(!BLINK_Compact_decodePresent(&self->bounded, &isPresent)){
+    return setField(group, lookupField(group, field), &v);
+}
 
-            retval = false;
-        }
-    }
+bool BLINK_Object_setDecimalByField(blink_object_t group, blink_schema_t field, int64_t mantissa, int8_t exponent)
+{
+    union blink_object_value value = {.decimal = {.mantissa = mantissa, .exponent = exponent}};
 
-    if(retval && isPresent){
+    return setField(group, lookupField(group, field), &value);
+}
 
-        retval = false;
-        
-        uint32_t size = BLINK_Field_getSize(top->f->definition);        
-        uint8_t *data = self->alloc->calloc(1, size);
+bool BLINK_Object_setUintByField(blink_object_t group, blink_schema_t field, uint64_t value)
+{
+    union blink_object_value v = {.u64 = value};
 
-        if(data != NULL){
+    return setField(group, lookupField(group, field), &v);
+}
 
-            self->value->string.data = data;
-            self->value->string.len = size;
+bool BLINK_Object_setIntByField(blink_object_t group, blink_schema_t field, int64_t value)
+{
+    union blink_object_value v = {.i64 = value};
 
-            if(BLINK_Stream_read(&self->bounded, data, size)){
+    return setField(group, lookupField(group, field), &v);
+}
 
-               retval = true;
+bool BLINK_Object_setF64ByField(blink_object_t group, blink_schema_t field, double value)
+{
+    union blink_object_value v = {.f64 = value};
 
-               if(self->initialised != NULL){
+    return setField(group, lookupField(group, field), &v);
+}
 
-                    *self->initialised = true;
-               }               
-            }
-        }
-        else{
+bool BLINK_Object_setStringByField(blink_object_t group, blink_schema_t field, const char *str, uint32_t len)
+{
+    union blink_object_value value = {.string = {.data = (const uint8_t *)str, .len = len}};
 
-            BLINK_ERROR("calloc()")
-        }        
-    }
-    
-    return retval;
+    return setField(group, lookupField(group, field), &value);
 }
 
-static bool decodeCompact_string(struct decode_state *self)
+bool BLINK_Object_setBinaryByField(blink_object_t group, blink_schema_t field, const uint8_t *data, uint32_t len)
 {
-    bool retval = false;
-    uint32_t size;
-    bool isNull;
-    struct stack_element *top = self->top;
+    union blink_object_value value = {.string = {.data = data, .len = len}};
 
-    if(BLINK_Compact_decodeU32(&self->bounded, &size, &isNull)){
+    return setField(group, lookupField(group, field), &value);
+}
 
-        if(isNull){
+bool BLINK_Object_setFixedByField(blink_object_t group, blink_schema_t field, const uint8_t *data, uint32_t len)
+{
+    union blink_object_value value = {.string = {.data = data, .len = len}};
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
-            }            
-        }
-        else{
-            
-            if(size > 0U){
+    return setField(group, lookupField(group, field), &value);
+}
 
-                uint8_t *data = self->alloc->calloc(1U, size);
+bool BLINK_Object_setGroupByField(blink_object_t group, blink_schema_t field, blink_object_t value)
+{
+    union blink_object_value v = {.group = value};
 
-                if(data != NULL){
+    return setField(group, lookupField(group, field), &v);
+}
 
-                    self->value->string.data = data;                        
-                    self->value->string.len = size;        
-                
-                    if(BLINK_Stream_read(&self->bounded, data, size)){
+const char *BLINK_Object_getEnumByField(blink_object_t group, blink_schema_t field)
+{
+    BLINK_ASSERT(group != NULL)
 
-                        retval = true;
+    const char *retval = NULL;
+    struct blink_object_field *f = lookupField(group, field);
 
-                        if(self->initialised != NULL){
+    if((f != NULL) && f->initialised && (f->desc->type == BLINK_TYPE_ENUM)){
 
-                            *self->initialised = true;
-                       }               
-                    }
-                }
-                else{
+        blink_schema_t s = BLINK_Enum_getSymbolByValue(f->desc->ref, (int32_t)f->data.value.i64);
 
-                    BLINK_ERROR("calloc()")
-                }
-            }
-            else{
+        if(s != NULL){
 
-                retval = true;
-            }
+            retval = BLINK_Symbol_getName(s);
         }
     }
-    
+
     return retval;
 }
 
-static bool decodeCompact_bool(struct decode_state *self)
+bool BLINK_Object_getBoolByField(blink_object_t group, blink_schema_t field)
 {
-    bool retval = false;
-    bool isNull;
-    bool value;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeBool(&self->bounded, &value, &isNull)){
+    return getField(lookupField(group, field)).boolean;
+}
 
-        if(isNull){
+void BLINK_Object_getDecimalByField(blink_object_t group, blink_schema_t field, int64_t *mantissa, int8_t *exponent)
+{
+    union blink_object_value value = getField(lookupField(group, field));
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
-            }            
-        }
-        else{
-        
-            self->value->boolean = value;
-            if(self->initialised != NULL){
+    *mantissa = value.decimal.mantissa;
+    *exponent = value.decimal.exponent;
+}
 
-                *self->initialised = true;
-            }
-            retval = true;
-        }                                                        
-    }
-    
-    return retval;
+uint64_t BLINK_Object_getUintByField(blink_object_t group, blink_schema_t field)
+{
+    return getField(lookupField(group, field)).u64;
 }
 
-static bool decodeCompact_u8(struct decode_state *self)
+int64_t BLINK_Object_getIntByField(blink_object_t group, blink_schema_t field)
 {
-    bool retval = false;
-    bool isNull;
-    uint8_t value;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeU8(&self->bounded, &value, &isNull)){
+    return getField(lookupField(group, field)).i64;
+}
 
-        if(isNull){
+double BLINK_Object_getF64ByField(blink_object_t group, blink_schema_t field)
+{
+    return getField(lookupField(group, field)).f64;
+}
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
-            }            
-        }
-        else{
+void BLINK_Object_getStringByField(blink_object_t group, blink_schema_t field, const char **str, uint32_t *len)
+{
+    union blink_object_value value = getField(lookupField(group, field));
 
-            self->value->u64 = (uint64_t)value;
-            if(self->initialised != NULL){
+    *str = (const char *)value.string.data;
+    *len = value.string.len;
+}
 
-                *self->initialised = true;
-            }
-            retval = true;
-        }                    
-    }
+void BLINK_Object_getBinaryByField(blink_object_t group, blink_schema_t field, const uint8_t **data, uint32_t *len)
+{
+    union blink_object_value value = getField(lookupField(group, field));
 
-    return retval;
+    *data = value.string.data;
+    *len = value.string.len;
 }
 
-static bool decodeCompact_u16(struct decode_state *self)
+void BLINK_Object_getFixedByField(blink_object_t group, blink_schema_t field, const uint8_t **data, uint32_t *len)
 {
-    bool retval = false;
-    bool isNull;
-    uint16_t value;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeU16(&self->bounded, &value, &isNull)){
+    union blink_object_value value = getField(lookupField(group, field));
 
-        if(isNull){
+    *data = value.string.data;
+    *len = value.string.len;
+}
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
-            }            
-        }
-        else{
+blink_object_t BLINK_Object_getGroupByField(blink_object_t group, blink_schema_t field)
+{
+    return getField(lookupField(group, field)).group;
+}
 
-            self->value->u64 = (uint64_t)value;
-            retval = true;
-        }                    
+uint32_t BLINK_Object_getSequenceSizeByField(blink_object_t group, blink_schema_t field)
+{
+    BLINK_ASSERT(group != NULL)
+
+    uint32_t retval = 0U;
+    struct blink_object_field *f = lookupField(group, field);
+
+    if((f != NULL) && f->desc->isSequence && f->initialised){
+
+        retval = f->data.sequence.size;
     }
 
     return retval;
 }
-static bool decodeCompact_u32(struct decode_state *self)
+
+bool BLINK_Object_reserveByField(blink_object_t group, blink_schema_t field, uint32_t capacity)
 {
+    BLINK_ASSERT(group != NULL)
+
     bool retval = false;
-    bool isNull;
-    uint32_t value;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeU32(&self->bounded, &value, &isNull)){
+    struct blink_object_field *f = lookupField(group, field);
 
-        if(isNull){
+    if(f != NULL){
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
-            }            
+        if(f->desc->isSequence){
+
+            retval = reserveElems(f, &group->alloc, capacity);
         }
         else{
 
-            if(self->initialised != NULL){
-
-                *self->initialised = true;
-            }
-            self->value->u64 = (uint64_t)value;
-            retval = true;
-        }                    
+            BLINK_ERROR("field is not a sequence")
+        }
     }
 
     return retval;
 }
-static bool decodeCompact_u64(struct decode_state *self)
+
+bool BLINK_Object_clearSequenceByField(blink_object_t group, blink_schema_t field)
 {
+    BLINK_ASSERT(group != NULL)
+
     bool retval = false;
-    bool isNull;
-    uint64_t value;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeU64(&self->bounded, &value, &isNull)){
+    struct blink_object_field *f = lookupField(group, field);
 
-        if(isNull){
+    if(f != NULL){
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
-            }            
+        if(f->desc->isSequence){
+
+            clearElems(f);
+            f->initialised = true;
+            retval = true;
         }
         else{
 
-            if(self->initialised != NULL){
-
-                *self->initialised = true;
-            }
-            self->value->u64 = value;
-            retval = true;
-        }                    
+            BLINK_ERROR("field is not a sequence")
+        }
     }
 
     return retval;
 }
-static bool decodeCompact_i8(struct decode_state *self)
+
+bool BLINK_Object_appendBoolsByField(blink_object_t group, blink_schema_t field, const bool *values, uint32_t n)
 {
-    bool retval = false;
-    bool isNull;
-    int8_t value;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeI8(&self->bounded, &value, &isNull)){
+    bool retval;
+    struct sequence_elem *elems;
+    uint32_t i;
 
-        if(isNull){
+    retval = appendElems(group, lookupField(group, field), BLINK_TYPE_BOOL, n, &elems);
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
-            }            
-        }
-        else{
+    if(retval){
 
-            if(self->initialised != NULL){
+        for(i=0U; i < n; i++){
 
-                *self->initialised = true;
-            }
-            self->value->i64 = (int64_t)value;
-            retval = true;
-        }                    
+            elems[i].value.boolean = values[i];
+        }
     }
 
     return retval;
 }
-static bool decodeCompact_i16(struct decode_state *self)
+
+bool BLINK_Object_appendUintsByField(blink_object_t group, blink_schema_t field, const uint64_t *values, uint32_t n)
 {
-    bool retval = false;
-    bool isNull;
-    int16_t value;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeI16(&self->bounded, &value, &isNull)){
+    bool retval;
+    struct sequence_elem *elems;
+    uint32_t i;
 
-        if(isNull){
+    retval = appendElems(group, lookupField(group, field), BLINK_TYPE_U64, n, &elems);
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
-            }            
+    if(retval){
+
+        for(i=0U; i < n; i++){
+
+            elems[i].value.u64 = values[i];
         }
-        else{
+    }
 
-            if(self->initialised != NULL){
+    return retval;
+}
+
+bool BLINK_Object_appendIntsByField(blink_object_t group, blink_schema_t field, const int64_t *values, uint32_t n)
+{
+    bool retval;
+    struct sequence_elem *elems;
+    uint32_t i;
+
+    retval = appendElems(group, lookupField(group, field), BLINK_TYPE_I64, n, &elems);
+
+    if(retval){
+
+        for(i=0U; i < n; i++){
+
+            elems[i].value.i64 = values[i];
+        }
+    }
+
+    return retval;
+}
+
+bool BLINK_Object_appendF64sByField(blink_object_t group, blink_schema_t field, const double *values, uint32_t n)
+{
+    bool retval;
+    struct sequence_elem *elems;
+    uint32_t i;
+
+    retval = appendElems(group, lookupField(group, field), BLINK_TYPE_F64, n, &elems);
+
+    if(retval){
+
+        for(i=0U; i < n; i++){
+
+            elems[i].value.f64 = values[i];
+        }
+    }
+
+    return retval;
+}
+
+bool BLINK_Object_appendBoolByField(blink_object_t group, blink_schema_t field, bool value)
+{
+    union blink_object_value v = {.boolean = value};
+
+    return appendField(group, lookupField(group, field), &v);
+}
+
+bool BLINK_Object_appendDecimalByField(blink_object_t group, blink_schema_t field, int64_t mantissa, int8_t exponent)
+{
+    union blink_object_value value = {.decimal = {.mantissa = mantissa, .exponent = exponent}};
+
+    return appendField(group, lookupField(group, field), &value);
+}
+
+bool BLINK_Object_appendUintByField(blink_object_t group, blink_schema_t field, uint64_t value)
+{
+    union blink_object_value v = {.u64 = value};
+
+    return appendField(group, lookupField(group, field), &v);
+}
+
+bool BLINK_Object_appendIntByField(blink_object_t group, blink_schema_t field, int64_t value)
+{
+    union blink_object_value v = {.i64 = value};
+
+    return appendField(group, lookupField(group, field), &v);
+}
+
+bool BLINK_Object_appendF64ByField(blink_object_t group, blink_schema_t field, double value)
+{
+    union blink_object_value v = {.f64 = value};
+
+    return appendField(group, lookupField(group, field), &v);
+}
+
+bool BLINK_Object_appendStringByField(blink_object_t group, blink_schema_t field, const char *str, uint32_t len)
+{
+    union blink_object_value value = {.string = {.data = (const uint8_t *)str, .len = len}};
+
+    return appendField(group, lookupField(group, field), &value);
+}
+
+bool BLINK_Object_appendBinaryByField(blink_object_t group, blink_schema_t field, const uint8_t *data, uint32_t len)
+{
+    union blink_object_value value = {.string = {.data = data, .len = len}};
+
+    return appendField(group, lookupField(group, field), &value);
+}
+
+bool BLINK_Object_appendFixedByField(blink_object_t group, blink_schema_t field, const uint8_t *data, uint32_t len)
+{
+    union blink_object_value value = {.string = {.data = data, .len = len}};
+
+    return appendField(group, lookupField(group, field), &value);
+}
+
+bool BLINK_Object_appendGroupByField(blink_object_t group, blink_schema_t field, blink_object_t value)
+{
+    union blink_object_value v = {.group = value};
+
+    return appendField(group, lookupField(group, field), &v);
+}
+
+bool BLINK_Object_setBoolAtByField(blink_object_t group, blink_schema_t field, uint32_t index, bool value)
+{
+    union blink_object_value v = {.boolean = value};
+
+    return setElem(group, lookupField(group, field), index, &v);
+}
+
+bool BLINK_Object_setDecimalAtByField(blink_object_t group, blink_schema_t field, uint32_t index, int64_t mantissa, int8_t exponent)
+{
+    union blink_object_value value = {.decimal = {.mantissa = mantissa, .exponent = exponent}};
+
+    return setElem(group, lookupField(group, field), index, &value);
+}
+
+bool BLINK_Object_setUintAtByField(blink_object_t group, blink_schema_t field, uint32_t index, uint64_t value)
+{
+    union blink_object_value v = {.u64 = value};
+
+    return setElem(group, lookupField(group, field), index, &v);
+}
+
+bool BLINK_Object_setIntAtByField(blink_object_t group, blink_schema_t field, uint32_t index, int64_t value)
+{
+    union blink_object_value v = {.i64 = value};
+
+    return setElem(group, lookupField(group, field), index, &v);
+}
+
+bool BLINK_Object_setF64AtByField(blink_object_t group, blink_schema_t field, uint32_t index, double value)
+{
+    union blink_object_value v = {.f64 = value};
+
+    return setElem(group, lookupField(group, field), index, &v);
+}
+
+bool BLINK_Object_setStringAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const char *str, uint32_t len)
+{
+    union blink_object_value value = {.string = {.data = (const uint8_t *)str, .len = len}};
+
+    return setElem(group, lookupField(group, field), index, &value);
+}
+
+bool BLINK_Object_setBinaryAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const uint8_t *data, uint32_t len)
+{
+    union blink_object_value value = {.string = {.data = data, .len = len}};
+
+    return setElem(group, lookupField(group, field), index, &value);
+}
+
+bool BLINK_Object_setFixedAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const uint8_t *data, uint32_t len)
+{
+    union blink_object_value value = {.string = {.data = data, .len = len}};
+
+    return setElem(group, lookupField(group, field), index, &value);
+}
+
+bool BLINK_Object_setGroupAtByField(blink_object_t group, blink_schema_t field, uint32_t index, blink_object_t value)
+{
+    union blink_object_value v = {.group = value};
+
+    return setElem(group, lookupField(group, field), index, &v);
+}
+
+bool BLINK_Object_getBoolAtByField(blink_object_t group, blink_schema_t field, uint32_t index)
+{
+    return getElem(lookupField(group, field), index).boolean;
+}
+
+void BLINK_Object_getDecimalAtByField(blink_object_t group, blink_schema_t field, uint32_t index, int64_t *mantissa, int8_t *exponent)
+{
+    union blink_object_value value = getElem(lookupField(group, field), index);
+
+    *mantissa = value.decimal.mantissa;
+    *exponent = value.decimal.exponent;
+}
+
+uint64_t BLINK_Object_getUintAtByField(blink_object_t group, blink_schema_t field, uint32_t index)
+{
+    return getElem(lookupField(group, field), index).u64;
+}
+
+int64_t BLINK_Object_getIntAtByField(blink_object_t group, blink_schema_t field, uint32_t index)
+{
+    return getElem(lookupField(group, field), index).i64;
+}
+
+double BLINK_Object_getF64AtByField(blink_object_t group, blink_schema_t field, uint32_t index)
+{
+    return getElem(lookupField(group, field), index).f64;
+}
+
+void BLINK_Object_getStringAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const char **str, uint32_t *len)
+{
+    union blink_object_value value = getElem(lookupField(group, field), index);
+
+    *str = (const char *)value.string.data;
+    *len = value.string.len;
+}
+
+void BLINK_Object_getBinaryAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const uint8_t **data, uint32_t *len)
+{
+    union blink_object_value value = getElem(lookupField(group, field), index);
+
+    *data = value.string.data;
+    *len = value.string.len;
+}
+
+void BLINK_Object_getFixedAtByField(blink_object_t group, blink_schema_t field, uint32_t index, const uint8_t **data, uint32_t *len)
+{
+    union blink_object_value value = getElem(lookupField(group, field), index);
+
+    *data = value.string.data;
+    *len = value.string.len;
+}
+
+blink_object_t BLINK_Object_getGroupAtByField(blink_object_t group, blink_schema_t field, uint32_t index)
+{
+    return getElem(lookupField(group, field), index).group;
+}
+
+/* static functions ***************************************************/
+
+static blink_object_t decodeGroup(blink_stream_t in, struct decode_state *self)
+{
+    const static handler decoder[] = {
+        NULL,                       /* BLINK_OP_END */
+        decodeCompact_string,       /* BLINK_OP_STRING */
+        decodeCompact_fixed,        /* BLINK_OP_FIXED */
+        decodeCompact_bool,         /* BLINK_OP_BOOL */
+        decodeCompact_u8,           /* BLINK_OP_U8 */
+        decodeCompact_u16,          /* BLINK_OP_U16 */
+        decodeCompact_u32,          /* BLINK_OP_U32 */
+        decodeCompact_u64,          /* BLINK_OP_U64 */
+        decodeCompact_i8,           /* BLINK_OP_I8 */
+        decodeCompact_i16,          /* BLINK_OP_I16 */
+        decodeCompact_i32,          /* BLINK_OP_I32 */
+        decodeCompact_i64,          /* BLINK_OP_I64 */
+        decodeCompact_f64,          /* BLINK_OP_F64 */
+        decodeCompact_decimal,      /* BLINK_OP_DECIMAL */
+        decodeCompact_enum,         /* BLINK_OP_ENUM */
+        decodeCompact_staticGroup,  /* BLINK_OP_STATIC_GROUP */
+        decodeCompact_dynamicGroup, /* BLINK_OP_DYNAMIC_GROUP */
+        decodeCompact_dynamicGroup  /* BLINK_OP_OBJECT */
+    };
+
+    blink_object_t retval = NULL;    
+    bool isNull;
+    bool error = false;
+    struct stack_element *top;
+    const struct blink_decode_op *op;
+
+    if(decodeCompact_groupHeader(in, self)){
+
+        while(!error){
+
+            top = self->top;
+            op = top->pc;
+
+            /* unselected top level fields are skipped without being decoded */
+            if((self->mask != NULL) && (top == self->stack) && (op->code != BLINK_OP_END) && (top->j == 0U) && !isSelected(self->mask, op->field)){
+
+                error = (BLINK_Compact_skipField(&self->bounded, top->g->fields[op->field].desc)) ? false : true;
+
+                /* the element operation follows the sequence operation */
+                top->pc = (op->code == BLINK_OP_SEQUENCE) ? &op[2] : &op[1];
+            }
+            else{
+
+                switch(op->code){
+                case BLINK_OP_END:
+
+                    if((top->isDynamic || (top == self->stack)) && (BLINK_Stream_tell(&self->bounded) < BLINK_Stream_max(&self->bounded))){
+
+                        BLINK_ERROR("additional bytes at end of group are not allowed...for now")
+                        error = true;
+                    }
+                    /* unwind */
+                    else if(top == self->stack){
+
+                        /* finished */
+                        retval = self->stack->g;
+                    }
+                    else{
+
+                        self->top = &top[-1];
+                        (void)BLINK_Stream_setMax(&self->bounded, self->top->max);
+                    }
+                    break;
+
+                case BLINK_OP_INTEGER_SEQUENCE:
+                case BLINK_OP_SEQUENCE:
+
+                    if(top->j == 0U){
+
+                        top->f = &top->g->fields[op->field];
+
+                        if(BLINK_Compact_decodeU32(&self->bounded, &top->count, &isNull)){
+
+                            if(!isNull){
+
+                                uint64_t remaining = BLINK_Stream_max(&self->bounded) - BLINK_Stream_tell(&self->bounded);
+
+                                top->f->initialised = true;
+
+                                /* one allocation sized from the length prefix (limited by
+                                 * what could possibly remain in the group) */
+                                if(!reserveElems(top->f, self->alloc, ((uint64_t)top->count < remaining) ? top->count : (uint32_t)remaining)){
+
+                                    error = true;
+                                }
+                                else if(op->code == BLINK_OP_INTEGER_SEQUENCE){
+
+                                    /* decode all elements in one go */
+                                    error = (decodeIntegerSequence(self, op->type)) ? false : true;
+                                    top->pc = &op[1];
+                                }
+                                else{
+
+                                    top->j++;
+                                }
+                            }
+                            else if(op->isOptional){
+
+                                top->pc = (op->code == BLINK_OP_SEQUENCE) ? &op[2] : &op[1];
+                            }
+                            else{
+
+                                BLINK_ERROR("cannot be NULL")
+                                error = true;
+                            }
+                        }
+                        else{
+
+                            error = true;
+                        }
+                    }
+                    else if(top->j <= top->count){
+
+                        struct sequence_elem *elem = appendElem(top->f, self->alloc);
+
+                        if(elem == NULL){
+
+                            error = true;
+                        }
+                        else{
+
+                            self->value = &elem->value;
+                            self->capacity = &elem->capacity;
+                            self->initialised = NULL;
+                            top->j++;
+
+                            /* the element operation follows the sequence operation */
+                            error = (decoder[op[1].code](self, &op[1])) ? false : true;
+                        }
+                    }
+                    else{
+
+                        top->j = 0U;
+                        top->pc = &op[2];
+                    }
+                    break;
+
+                default:
+
+                    top->f = &top->g->fields[op->field];
+                    self->value = &top->f->data.value;
+                    self->capacity = &top->f->capacity;
+                    self->initialised = &top->f->initialised;
+                    top->pc = &op[1];
+                    error = (decoder[op->code](self, op)) ? false : true;
+                    break;
+                }
+            }
+
+            if(retval != NULL){
+
+                break;
+            }
+        }
+    }
+    else{
+
+        error = true;
+    }
+
+    if(error){
+
+        if(BLINK_Stream_eof(in)){
+
+            BLINK_ERROR("S1: group ended prematurely")
+        }
+        else{
+
+            if(BLINK_Stream_eof(&self->bounded)){
+
+                BLINK_ERROR("S1: nested group ended prematurely")
+            }            
+        }
+
+        if(self->target != NULL){
+
+            BLINK_Object_reset(self->target);
+        }
+        else{
+
+            BLINK_Object_destroyGroup(&self->stack->g);
+        }
+    }
+
+    return retval;
+}
+
+static bool decodeCompact_groupHeader(blink_stream_t in, struct decode_state *self)
+{
+    bool retval = false;
+    bool isNull;
+    uint64_t id;    
+    
+    if(BLINK_Compact_decodeU32(in, &self->top->max, &isNull)){
+    
+        if(isNull || (self->top->max == 0U)){
+
+            BLINK_ERROR("W1: Top level group size is NULL or zero")
+        }
+        else{
+
+            (void)BLINK_Stream_initBounded(&self->bounded, in, self->top->max);
+
+            if(BLINK_Compact_decodeU64(&self->bounded, &id, &isNull)){
+
+                if(isNull){
+
+                    BLINK_ERROR("W1: unknown group ID")                
+                }
+                else{
+
+                    blink_schema_t groupDef = BLINK_Schema_getGroupByID(self->schema, id);
+
+                    if(groupDef == NULL){
+
+                        BLINK_ERROR("W1: unknown group ID")
+                    }
+                    else{
+
+                        self->top->pc = BLINK_Group_getDecodeProgram(groupDef);
+
+                        if((self->mask != NULL) && (self->mask->group != groupDef)){
+
+                            self->mask = NULL;
+                        }
+
+                        if(self->target != NULL){
+
+                            if(self->target->definition == groupDef){
+
+                                BLINK_Object_reset(self->target);
+                                self->top->g = self->target;
+                                retval = true;
+                            }
+                            else{
+
+                                BLINK_ERROR("group does not match decode target")
+                            }
+                        }
+                        else{
+
+                            self->top->g = BLINK_Object_newGroup(self->alloc, groupDef);
+
+                            if(self->top->g != NULL){
+
+                                retval = true;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return retval;
+}
+
+static bool decodeCompact_fixed(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = true;
+    bool isPresent = true;
+                
+    if(op->isOptional){
+
+        if(!BLINK_Compact_decodePresent(&self->bounded, &isPresent)){
+
+            retval = false;
+        }
+    }
+
+    if(retval && isPresent){
+
+        retval = readString(self, op->size);
+    }
+    
+    return retval;
+}
+
+static bool decodeCompact_string(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    uint32_t size;
+    bool isNull;
+
+    if(BLINK_Compact_decodeU32(&self->bounded, &size, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            retval = readString(self, size);
+        }
+    }
+    
+    return retval;
+}
+
+static bool decodeCompact_bool(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    bool value;
+    
+    if(BLINK_Compact_decodeBool(&self->bounded, &value, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+        
+            self->value->boolean = value;
+            if(self->initialised != NULL){
+
+                *self->initialised = true;
+            }
+            retval = true;
+        }                                                        
+    }
+    
+    return retval;
+}
+
+static bool decodeCompact_u8(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    uint8_t value;
+    
+    if(BLINK_Compact_decodeU8(&self->bounded, &value, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            self->value->u64 = (uint64_t)value;
+            if(self->initialised != NULL){
+
+                *self->initialised = true;
+            }
+            retval = true;
+        }                    
+    }
+
+    return retval;
+}
+
+static bool decodeCompact_u16(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    uint16_t value;
+    
+    if(BLINK_Compact_decodeU16(&self->bounded, &value, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            self->value->u64 = (uint64_t)value;
+            retval = true;
+        }                    
+    }
+
+    return retval;
+}
+static bool decodeCompact_u32(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    uint32_t value;
+    
+    if(BLINK_Compact_decodeU32(&self->bounded, &value, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            if(self->initialised != NULL){
+
+                *self->initialised = true;
+            }
+            self->value->u64 = (uint64_t)value;
+            retval = true;
+        }                    
+    }
+
+    return retval;
+}
+static bool decodeCompact_u64(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    uint64_t value;
+    
+    if(BLINK_Compact_decodeU64(&self->bounded, &value, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            if(self->initialised != NULL){
+
+                *self->initialised = true;
+            }
+            self->value->u64 = value;
+            retval = true;
+        }                    
+    }
+
+    return retval;
+}
+static bool decodeCompact_i8(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    int8_t value;
+    
+    if(BLINK_Compact_decodeI8(&self->bounded, &value, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            if(self->initialised != NULL){
+
+                *self->initialised = true;
+            }
+            self->value->i64 = (int64_t)value;
+            retval = true;
+        }                    
+    }
+
+    return retval;
+}
+static bool decodeCompact_i16(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    int16_t value;
+    
+    if(BLINK_Compact_decodeI16(&self->bounded, &value, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            if(self->initialised != NULL){
+
+                *self->initialised = true;
+            }
+            self->value->i64 = (int64_t)value;
+            retval = true;        
+        }                    
+    }
+
+    return retval;
+}
+static bool decodeCompact_i32(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    int32_t value;
+    
+    if(BLINK_Compact_decodeI32(&self->bounded, &value, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            if(self->initialised != NULL){
+
+                *self->initialised = true;
+            }
+            self->value->i64 = (int64_t)value;
+            retval = true;
+        }                    
+    }
+
+    return retval;
+}
+static bool decodeCompact_i64(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    int64_t value;
+    
+    if(BLINK_Compact_decodeI64(&self->bounded, &value, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            if(self->initialised != NULL){
+
+                *self->initialised = true;
+            }
+            self->value->i64 = value;
+            retval = true;
+        }                    
+    }
+
+    return retval;
+}
+
+static bool decodeCompact_enum(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    int32_t value;
+    
+    if(BLINK_Compact_decodeI32(&self->bounded, &value, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            if(BLINK_Enum_getSymbolByValue(op->ref, value) != NULL){
+
+                if(self->initialised != NULL){
+
+                    *self->initialised = true;
+                }
+                self->value->i64 = (int64_t)value;            
+                retval = true;
+            }
+            else{
+
+                BLINK_ERROR("symbol not found in enum")
+            }                        
+        }                    
+    }
+
+    return retval;
+}
+
+static bool decodeCompact_f64(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    double value;
+    
+    if(BLINK_Compact_decodeF64(&self->bounded, &value, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            if(self->initialised != NULL){
+
+                *self->initialised = true;
+            }
+            self->value->f64 = value;
+            retval = true;
+        }
+    }
+
+    return retval;
+}
+
+static bool decodeCompact_decimal(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    int64_t mantissa;
+    int8_t exponent;
+    
+    if(BLINK_Compact_decodeDecimal(&self->bounded, &mantissa, &exponent, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+    
+                retval = true;
+            }            
+        }
+        else{
+
+            if(self->initialised != NULL){
 
                 *self->initialised = true;
             }
-            self->value->i64 = (int64_t)value;
-            retval = true;        
-        }                    
+            self->value->decimal.mantissa = mantissa;
+            self->value->decimal.exponent = exponent;
+            retval = true;
+        }
+    }
+
+    return retval;
+}
+
+static bool decodeCompact_staticGroup(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = true;
+    bool isPresent = true;
+    struct stack_element *top = self->top;
+                
+    if(op->isOptional){
+
+        if(!BLINK_Compact_decodePresent(&self->bounded, &isPresent)){
+
+            retval = false;
+        }
+    }
+
+    if(retval && isPresent){
+
+        retval = false;
+
+        if(top == &self->stack[(BLINK_OBJECT_NEST_DEPTH-1U)]){
+
+            BLINK_ERROR("too much nesting")
+        }
+        else{
+
+            (void)memset(&top[1], 0, sizeof(*self->stack));
+
+            top[1].max = top->max;
+            top[1].pc = BLINK_Group_getDecodeProgram(op->ref);
+            top[1].g = acquireGroup(self, op->ref);
+
+            if(top[1].g != NULL){
+
+                self->top = &top[1];
+                retval = true;
+            }
+        }
+    }
+
+    return retval;
+}
+
+static bool decodeCompact_dynamicGroup(struct decode_state *self, const struct blink_decode_op *op)
+{
+    bool retval = false;
+    bool isNull;
+    uint32_t size;
+    uint64_t id;
+    blink_schema_t groupDef;
+    struct stack_element *top = self->top;
+    
+    if(BLINK_Compact_decodeU32(&self->bounded, &size, &isNull)){
+
+        if(isNull){
+
+            if(op->isOptional){
+
+                retval = true;
+            }            
+        }
+        else if(size == 0U){
+
+            BLINK_ERROR("W1: Group cannot have size of zero")
+        }
+        else if((BLINK_Stream_max(&self->bounded) - BLINK_Stream_tell(&self->bounded)) < size){
+
+            BLINK_ERROR("S1: nested group will overrun parent group")
+        }
+        else{
+
+            if(top == &self->stack[(BLINK_OBJECT_NEST_DEPTH-1U)]){
+
+                BLINK_ERROR("too much nesting")
+            }
+            else{
+
+                (void)memset(&top[1], 0, sizeof(*self->stack));
+
+                top[1].max = BLINK_Stream_tell(&self->bounded) + size;
+                (void)BLINK_Stream_setMax(&self->bounded, top[1].max);
+                        
+                if(BLINK_Compact_decodeU64(&self->bounded, &id, &isNull)){
+
+                    if(!isNull){
+
+                        groupDef = BLINK_Schema_getGroupByID(self->schema, id);
+                    }
+
+                    if(isNull || (groupDef == NULL)){
+
+                        BLINK_ERROR("W14: Group is unknown")
+                    }
+                    else{
+
+                        if((op->code == BLINK_OP_OBJECT) || BLINK_Group_isKindOf(groupDef, op->ref)){
+
+                            top[1].pc = BLINK_Group_getDecodeProgram(groupDef);
+                            top[1].isDynamic = true;
+                            top[1].g = acquireGroup(self, groupDef);
+
+                            if(top[1].g != NULL){
+
+                                self->top = &top[1];
+                                retval = true;
+                            }
+                        }
+                        else{
+
+                            BLINK_ERROR("not what we expect")
+                        }
+                    }
+                }
+            }
+        }
+    }
+     
+    return retval;
+}
+
+static bool readString(struct decode_state *self, uint32_t size)
+{
+    bool retval = false;
+
+    if(self->zeroCopy){
+
+        const uint8_t *data = BLINK_Stream_borrow(&self->bounded, size);
+
+        if(data != NULL){
+
+            releaseString(self->alloc, self->value, self->capacity);
+            self->value->string.data = data;
+            self->value->string.len = size;
+            retval = true;
+        }
+    }
+    else{
+
+        if(reserveString(self->alloc, self->value, self->capacity, size)){
+
+            retval = BLINK_Stream_read(&self->bounded, (uint8_t *)self->value->string.data, size);
+        }
+    }
+
+    if(retval && (self->initialised != NULL)){
+
+        *self->initialised = true;
+    }
+
+    return retval;
+}
+
+/* integer sequences are batch decoded into a chunk, range checked, and then
+ * copied into the element array */
+static bool decodeIntegerSequence(struct decode_state *self, enum blink_type_tag type)
+{
+    uint64_t chunk[64U];
+    uint32_t remaining = self->top->count;
+    bool retval = true;
+    bool isSigned;
+    uint64_t bias;
+    uint64_t max;
+    uint32_t n;
+    uint32_t i;
+
+    switch(type){
+    case BLINK_TYPE_U8:
+        isSigned = false;
+        max = UINT8_MAX;
+        break;
+    case BLINK_TYPE_U16:
+        isSigned = false;
+        max = UINT16_MAX;
+        break;
+    case BLINK_TYPE_U32:
+    case BLINK_TYPE_TIME_OF_DAY_MILLI:
+        isSigned = false;
+        max = UINT32_MAX;
+        break;
+    case BLINK_TYPE_I8:
+        isSigned = true;
+        max = (uint64_t)INT8_MAX;
+        break;
+    case BLINK_TYPE_I16:
+        isSigned = true;
+        max = (uint64_t)INT16_MAX;
+        break;
+    case BLINK_TYPE_I32:
+    case BLINK_TYPE_DATE:
+        isSigned = true;
+        max = (uint64_t)INT32_MAX;
+        break;
+    case BLINK_TYPE_I64:
+    case BLINK_TYPE_NANO_TIME:
+    case BLINK_TYPE_MILLI_TIME:
+        isSigned = true;
+        max = (uint64_t)INT64_MAX;
+        break;
+    case BLINK_TYPE_U64:
+    case BLINK_TYPE_TIME_OF_DAY_NANO:
+    default:
+        isSigned = false;
+        max = UINT64_MAX;
+        break;
+    }
+
+    /* bias signed values so that one unsigned comparison checks the range */
+    bias = (isSigned) ? (max + 1U) : 0U;
+
+    while(retval && (remaining > 0U)){
+
+        n = (remaining < (uint32_t)(sizeof(chunk)/sizeof(*chunk))) ? remaining : (uint32_t)(sizeof(chunk)/sizeof(*chunk));
+
+        retval = (isSigned) ? BLINK_Compact_decodeI64Array(&self->bounded, (int64_t *)chunk, n) : BLINK_Compact_decodeU64Array(&self->bounded, chunk, n);
+
+        for(i=0U; retval && (i < n); i++){
+
+            if((chunk[i] + bias) <= (max + bias)){
+
+                struct sequence_elem *elem = appendElem(self->top->f, self->alloc);
+
+                if(elem != NULL){
+
+                    elem->value.u64 = chunk[i];
+                }
+                else{
+
+                    retval = false;
+                }
+            }
+            else{
+
+                BLINK_ERROR("W3: out of range")
+                retval = false;
+            }
+        }
+
+        remaining -= n;
+    }
+
+    return retval;
+}
+
+/* append an element to a sequence, growing the element array if it is full
+ *
+ * The element may hold a string buffer or group retained from before the
+ * sequence was cleared. */
+static struct sequence_elem *appendElem(struct blink_object_field *field, const struct blink_allocator *alloc)
+{
+    struct sequence_elem *retval = NULL;
+    struct sequence_type *seq = &field->data.sequence;
+
+    if(seq->size == UINT32_MAX){
+
+        BLINK_ERROR("sequence is too large")
+    }
+    else if(growElems(field, alloc, seq->size + 1U)){
+
+        retval = &seq->elems[seq->size];
+        seq->size++;
+    }
+
+    return retval;
+}
+
+/* ensure the element array has room for at least size elements, at
+ * least doubling the capacity each time it grows so that appending is
+ * amortised constant time */
+static bool growElems(struct blink_object_field *field, const struct blink_allocator *alloc, uint32_t size)
+{
+    bool retval = true;
+    uint32_t capacity = field->data.sequence.capacity;
+
+    if(capacity < size){
+
+        capacity = (capacity < (UINT32_MAX / 2U)) ? (capacity * 2U) : UINT32_MAX;
+        capacity = (capacity < 4U) ? 4U : capacity;
+        capacity = (capacity < size) ? size : capacity;
+
+        retval = reserveElems(field, alloc, capacity);
+    }
+
+    return retval;
+}
+
+/* ensure the element array has room for at least capacity elements */
+static bool reserveElems(struct blink_object_field *field, const struct blink_allocator *alloc, uint32_t capacity)
+{
+    bool retval = true;
+    struct sequence_type *seq = &field->data.sequence;
+
+    if(seq->capacity < capacity){
+
+        struct sequence_elem *elems = BLINK_Allocator_calloc(alloc, capacity, sizeof(struct sequence_elem));
+
+        if(elems != NULL){
+
+            if(seq->elems != NULL){
+
+                (void)memcpy(elems, seq->elems, seq->capacity * sizeof(struct sequence_elem));
+
+                BLINK_Allocator_free(alloc, seq->elems);
+            }
+
+            seq->elems = elems;
+            seq->capacity = capacity;
+        }
+        else{
+
+            BLINK_ERROR("calloc()")
+            retval = false;
+        }
+    }
+
+    return retval;
+}
+
+/* empty a sequence but retain the element array (and any string buffers
+ * or groups held by elements) for reuse */
+static void clearElems(struct blink_object_field *field)
+{
+    uint32_t i;
+    struct sequence_type *seq = &field->data.sequence;
+
+    for(i=0U; i < seq->size; i++){
+
+        resetValue(field->desc->type, &seq->elems[i].value, &seq->elems[i].capacity);
+    }
+
+    seq->size = 0U;
+}
+
+/* reuse the group already held by the value if it has the same
+ * definition, otherwise replace it with a new group */
+static blink_object_t acquireGroup(struct decode_state *self, blink_schema_t group)
+{
+    blink_object_t retval = self->value->group;
+
+    if((retval != NULL) && (retval->definition == group)){
+
+        BLINK_Object_reset(retval);
+    }
+    else{
+
+        BLINK_Object_destroyGroup(&self->value->group);
+        retval = BLINK_Object_newGroup(self->alloc, group);
+        self->value->group = retval;
+    }
+
+    if(retval != NULL){
+
+        if(self->initialised != NULL){
+
+            *self->initialised = true;
+        }
+    }
+    else{
+
+        BLINK_ERROR("calloc()")
+    }
+
+    return retval;
+}
+
+/* ensure value owns a string buffer of at least size bytes */
+static bool reserveString(const struct blink_allocator *alloc, union blink_object_value *value, uint32_t *capacity, uint32_t size)
+{
+    bool retval = true;
+
+    if(*capacity < size){
+
+        uint8_t *data = BLINK_Allocator_calloc(alloc, 1U, size);
+
+        if(data != NULL){
+
+            releaseString(alloc, value, capacity);
+            value->string.data = data;
+            *capacity = size;
+        }
+        else{
+
+            BLINK_ERROR("calloc()")
+            retval = false;
+        }
+    }
+    else if(*capacity == 0U){
+
+        /* zero length and nothing owned; drop any borrowed reference */
+        value->string.data = NULL;
+    }
+    else{
+
+        /* reuse existing buffer */
+    }
+
+    if(retval){
+
+        value->string.len = size;
     }
 
     return retval;
 }
-static bool decodeCompact_i32(struct decode_state *self)
+
+static void releaseString(const struct blink_allocator *alloc, union blink_object_value *value, uint32_t *capacity)
+{
+    if(*capacity > 0U){
+
+        BLINK_Allocator_free(alloc, (void *)value->string.data);
+    }
+
+    value->string.data = NULL;
+    *capacity = 0U;
+}
+
+static void destroyValue(blink_object_t group, enum blink_type_tag type, union blink_object_value *value, uint32_t *capacity)
+{
+    switch(type){
+    case BLINK_TYPE_STRING:            
+    case BLINK_TYPE_BINARY:
+    case BLINK_TYPE_FIXED:
+        releaseString(&group->alloc, value, capacity);
+        break;
+    case BLINK_TYPE_OBJECT:
+    case BLINK_TYPE_DYNAMIC_GROUP:
+    case BLINK_TYPE_STATIC_GROUP:
+        BLINK_Object_destroyGroup(&value->group);
+        break;
+    default:
+        break;
+    }
+}
+
+static void destroyElems(blink_object_t group, struct blink_object_field *field)
+{
+    uint32_t i;
+    struct sequence_type *seq = &field->data.sequence;
+
+    for(i=0U; i < seq->capacity; i++){
+
+        destroyValue(group, field->desc->type, &seq->elems[i].value, &seq->elems[i].capacity);
+    }
+
+    if(seq->elems != NULL){
+
+        BLINK_Allocator_free(&group->alloc, seq->elems);
+    }
+
+    seq->elems = NULL;
+    seq->size = 0U;
+    seq->capacity = 0U;
+}
+
+/* owned string buffers and nested groups are retained for reuse */
+static void resetValue(enum blink_type_tag type, union blink_object_value *value, const uint32_t *capacity)
+{
+    switch(type){
+    case BLINK_TYPE_STRING:            
+    case BLINK_TYPE_BINARY:
+    case BLINK_TYPE_FIXED:
+        if(*capacity == 0U){
+
+            value->string.data = NULL;
+        }
+        value->string.len = 0U;
+        break;
+    default:
+        break;
+    }
+}
+
+/* write value to a field or sequence element, copying string data
+ * into the buffer at `to` */
+static bool setValue(blink_object_t group, const struct blink_field_desc *desc, union blink_object_value *to, uint32_t *capacity, const union blink_object_value *value)
 {
     bool retval = false;
-    bool isNull;
-    int32_t value;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeI32(&self->bounded, &value, &isNull)){
 
-        if(isNull){
+    switch(desc->type){
+    case BLINK_TYPE_STRING:            
+    case BLINK_TYPE_BINARY:         
+
+        if(value->string.len <= desc->size){
+
+            if(reserveString(&group->alloc, to, capacity, value->string.len)){
+
+                if(value->string.len > 0U){
+
+                    (void)memcpy((uint8_t *)to->string.data, value->string.data, value->string.len);
+                }
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
                 retval = true;
-            }            
+            }
         }
         else{
 
-            if(self->initialised != NULL){
+            BLINK_ERROR("string too large for definition")
+        }
+        break;
+    case BLINK_TYPE_FIXED:
+        if(value->string.len == desc->size){
 
-                *self->initialised = true;
+            if(reserveString(&group->alloc, to, capacity, value->string.len)){
+
+                (void)memcpy((uint8_t *)to->string.data, value->string.data, value->string.len);
+                retval = true;
             }
-            self->value->i64 = (int64_t)value;
+        }
+        else{
+
+            BLINK_ERROR("wrong size fixed field")
+        }
+        break;
+    case BLINK_TYPE_BOOL:
+        to->boolean = value->boolean;
+        retval = true;
+        break;
+    case BLINK_TYPE_U8:
+    case BLINK_TYPE_U16:
+    case BLINK_TYPE_U32:
+    case BLINK_TYPE_U64:
+    case BLINK_TYPE_TIME_OF_DAY_MILLI:
+    case BLINK_TYPE_TIME_OF_DAY_NANO:
+        to->u64 = value->u64;
+        retval = true;
+        break;        
+    case BLINK_TYPE_I8:        
+    case BLINK_TYPE_I16:
+    case BLINK_TYPE_I32:
+    case BLINK_TYPE_DATE:
+    case BLINK_TYPE_NANO_TIME:
+    case BLINK_TYPE_MILLI_TIME:
+    case BLINK_TYPE_I64:
+        to->i64 = value->i64;
+        retval = true;
+        break;        
+    case BLINK_TYPE_ENUM:
+        to->i64 = value->i64;
+        retval = true;
+        break;            
+    case BLINK_TYPE_F64:
+        to->f64 = value->f64;
+        retval = true;
+        break;                
+    case BLINK_TYPE_DECIMAL:
+        to->decimal = value->decimal;
+        retval = true;
+        break;        
+    case BLINK_TYPE_DYNAMIC_GROUP:
+        if(BLINK_Group_hasID(value->group->definition)){
+
+            to->group = value->group;
             retval = true;
-        }                    
+        }
+        else{
+
+            BLINK_ERROR("expecting a Group that can be encoded dynamically")                
+        }
+        break;
+    case BLINK_TYPE_STATIC_GROUP:
+        to->group = value->group;
+        retval = true;
+        break;        
+    default:
+        break;
+    }
+
+    return retval;    
+}
+
+static bool setField(blink_object_t group, struct blink_object_field *field, const union blink_object_value *value)
+{
+    BLINK_ASSERT(group != NULL)
+
+    bool retval = false;
+
+    if(field != NULL){
+
+        if(field->desc->isSequence){
+
+            BLINK_ERROR("field is a sequence")
+        }
+        else if(setValue(group, field->desc, &field->data.value, &field->capacity, value)){
+
+            field->initialised = true;
+            retval = true;
+        }
+    }
+
+    return retval;    
+}
+
+static union blink_object_value getField(const struct blink_object_field *field)
+{
+    union blink_object_value retval;
+    (void)memset(&retval, 0, sizeof(retval));
+
+    if((field != NULL) && field->initialised && !field->desc->isSequence){
+
+        retval = field->data.value;
+    }
+
+    return retval;    
+}
+
+static bool appendField(blink_object_t group, struct blink_object_field *field, const union blink_object_value *value)
+{
+    BLINK_ASSERT(group != NULL)
+
+    bool retval = false;
+
+    if(field != NULL){
+
+        if(field->desc->isSequence){
+
+            struct sequence_elem *elem;
+            enum blink_type_tag type = field->desc->type;
+
+            /* a NULL sequence becomes an empty sequence */
+            if(!field->initialised){
+
+                clearElems(field);
+            }
+
+            elem = appendElem(field, &group->alloc);
+
+            if(elem != NULL){
+
+                /* a group retained for reuse is released when replaced */
+                if(((type == BLINK_TYPE_STATIC_GROUP) || (type == BLINK_TYPE_DYNAMIC_GROUP)) && (elem->value.group != value->group)){
+
+                    BLINK_Object_destroyGroup(&elem->value.group);
+                }
+
+                if(setValue(group, field->desc, &elem->value, &elem->capacity, value)){
+
+                    field->initialised = true;
+                    retval = true;
+                }
+                else{
+
+                    field->data.sequence.size--;
+                }
+            }
+        }
+        else{
+
+            BLINK_ERROR("cannot append to a field which is not a sequence")
+        }
+    }
+
+    return retval;
+}
+
+static bool setElem(blink_object_t group, struct blink_object_field *field, uint32_t index, const union blink_object_value *value)
+{
+    BLINK_ASSERT(group != NULL)
+
+    bool retval = false;
+
+    if(field != NULL){
+
+        if(field->desc->isSequence && field->initialised && (index < field->data.sequence.size)){
+
+            struct sequence_elem *elem = &field->data.sequence.elems[index];
+
+            retval = setValue(group, field->desc, &elem->value, &elem->capacity, value);
+        }
+        else{
+
+            BLINK_ERROR("index %u is out of range", index)
+        }
     }
 
     return retval;
 }
-static bool decodeCompact_i64(struct decode_state *self)
+
+/* make room for n elements of a scalar sequence in one step
+ *
+ * `base` is the type the caller will write (see baseType()). On success
+ * `first` points to the first of n new elements. */
+static bool appendElems(blink_object_t group, struct blink_object_field *field, enum blink_type_tag base, uint32_t n, struct sequence_elem **first)
 {
     bool retval = false;
-    bool isNull;
-    int64_t value;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeI64(&self->bounded, &value, &isNull)){
 
-        if(isNull){
+    if(field != NULL){
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
-            }            
+        if(!field->desc->isSequence){
+
+            BLINK_ERROR("cannot append to a field which is not a sequence")
+        }
+        else if(baseType(field->desc->type) != base){
+
+            BLINK_ERROR("cannot append values of this type to field %s", BLINK_Field_getName(field->desc->field))
         }
         else{
 
-            if(self->initialised != NULL){
+            struct sequence_type *seq = &field->data.sequence;
 
-                *self->initialised = true;
+            /* a NULL sequence becomes an empty sequence */
+            if(!field->initialised){
+
+                clearElems(field);
             }
-            self->value->i64 = value;
-            retval = true;
-        }                    
+
+            if(n > (UINT32_MAX - seq->size)){
+
+                BLINK_ERROR("sequence is too large")
+            }
+            else if(growElems(field, &group->alloc, seq->size + n)){
+
+                *first = &seq->elems[seq->size];
+                seq->size += n;
+                field->initialised = true;
+                retval = true;
+            }
+        }
     }
 
     return retval;
 }
 
-static bool decodeCompact_enum(struct decode_state *self)
+/* the value union member a type is stored in */
+static enum blink_type_tag baseType(enum blink_type_tag type)
 {
-    bool retval = false;
-    bool isNull;
-    int32_t value;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeI32(&self->bounded, &value, &isNull)){
+    enum blink_type_tag retval;
+
+    switch(type){
+    case BLINK_TYPE_U8:
+    case BLINK_TYPE_U16:
+    case BLINK_TYPE_U32:
+    case BLINK_TYPE_U64:
+    case BLINK_TYPE_TIME_OF_DAY_MILLI:
+    case BLINK_TYPE_TIME_OF_DAY_NANO:
+        retval = BLINK_TYPE_U64;
+        break;
+    case BLINK_TYPE_I8:
+    case BLINK_TYPE_I16:
+    case BLINK_TYPE_I32:
+    case BLINK_TYPE_I64:
+    case BLINK_TYPE_DATE:
+    case BLINK_TYPE_NANO_TIME:
+    case BLINK_TYPE_MILLI_TIME:
+    case BLINK_TYPE_ENUM:
+        retval = BLINK_TYPE_I64;
+        break;
+    default:
+        retval = type;
+        break;
+    }
 
-        if(isNull){
+    return retval;
+}
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
-            }            
-        }
-        else{
+static union blink_object_value getElem(const struct blink_object_field *field, uint32_t index)
+{
+    union blink_object_value retval;
+    (void)memset(&retval, 0, sizeof(retval));
 
-            if(BLINK_Enum_getSymbolByValue(top->f->definition, value) != NULL){
+    if((field != NULL) && field->desc->isSequence && field->initialised && (index < field->data.sequence.size)){
 
-                if(self->initialised != NULL){
+        retval = field->data.sequence.elems[index].value;
+    }
 
-                    *self->initialised = true;
-                }
-                self->value->i64 = (int64_t)value;            
-                retval = true;
-            }
-            else{
+    return retval;
+}
 
-                BLINK_ERROR("symbol not found in enum")
-            }                        
-        }                    
+static blink_schema_t lookupDefinition(const struct blink_object *group, const char *name)
+{
+    BLINK_ASSERT(group != NULL)
+    BLINK_ASSERT(name != NULL)
+
+    blink_schema_t retval = BLINK_Group_getFieldByName(group->definition, name);
+
+    if(retval == NULL){
+
+        /* field not found */
+        BLINK_DEBUG("field name %s does not exist for group %s", name, BLINK_Group_getName(group->definition))
     }
 
     return retval;
 }
 
-static bool decodeCompact_f64(struct decode_state *self)
+static struct blink_object_field *lookupField(struct blink_object *group, blink_schema_t field)
 {
-    bool retval = false;
-    bool isNull;
-    double value;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeF64(&self->bounded, &value, &isNull)){
+    BLINK_ASSERT(group != NULL)
 
-        if(isNull){
+    struct blink_object_field *retval = NULL;
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
-            }            
+    if(field != NULL){
+
+        uint32_t i = BLINK_Field_getIndex(field);
+
+        /* a field handle from another group will not match */
+        if((i < group->numberOfFields) && (group->fields[i].desc->field == field)){
+
+            retval = &group->fields[i];
         }
         else{
 
-            if(self->initialised != NULL){
-
-                *self->initialised = true;
-            }
-            self->value->f64 = value;
-            retval = true;
+            BLINK_ERROR("field %s does not belong to group %s", BLINK_Field_getName(field), BLINK_Group_getName(group->definition))
         }
     }
 
     return retval;
 }
 
-static bool decodeCompact_decimal(struct decode_state *self)
+/* recursively walks group and calculates encoded size and determines
+ * if all mandatory fields have been initialised */
+static bool cacheSize(blink_object_t group)
 {
-    bool retval = false;
-    bool isNull;
-    int64_t mantissa;
-    int8_t exponent;
-    struct stack_element *top = self->top;
+    uint32_t i;
+    uint32_t j;
+    uint32_t n;
+    group->size = 0U;
     
-    if(BLINK_Compact_decodeDecimal(&self->bounded, &mantissa, &exponent, &isNull)){
+    for(i=0U; i < group->numberOfFields; i++){
 
-        if(isNull){
+        struct blink_object_field *f = &group->fields[i];
+        enum blink_type_tag type = f->desc->type;
+        bool isSequence = f->desc->isSequence;
 
-            if(BLINK_Field_isOptional(top->f->definition)){
-    
-                retval = true;
+        if(f->initialised){
+
+            if(isSequence){
+
+                group->size += BLINK_Compact_sizeofUnsigned(f->data.sequence.size);
+                n = f->data.sequence.size;
+            }
+            else{
+
+                n = 1U;
+            }
+
+            for(j=0U; j < n; j++){
+
+                union blink_object_value *value = (isSequence) ? &f->data.sequence.elems[j].value : &f->data.value;
+                
+                switch(type){
+                case BLINK_TYPE_STRING:            
+                case BLINK_TYPE_BINARY:
+                    group->size += BLINK_Compact_sizeofUnsigned(value->string.len);
+                    group->size += value->string.len;
+                    break;            
+                case BLINK_TYPE_FIXED:
+                    group->size += value->string.len;
+                    group->size += (f->desc->isOptional && !isSequence) ? 1U : 0U;   /* presence */
+                    break;            
+                case BLINK_TYPE_BOOL:
+                    group->size += 1U;            
+                    break;
+                case BLINK_TYPE_U8:
+                case BLINK_TYPE_U16:
+                case BLINK_TYPE_U32:
+                case BLINK_TYPE_U64:
+                case BLINK_TYPE_TIME_OF_DAY_MILLI:
+                case BLINK_TYPE_TIME_OF_DAY_NANO:
+                case BLINK_TYPE_F64:
+                    group->size += BLINK_Compact_sizeofUnsigned(value->u64);                
+                    break;        
+                case BLINK_TYPE_I8:        
+                case BLINK_TYPE_I16:
+                case BLINK_TYPE_I32:
+                case BLINK_TYPE_DATE:
+                case BLINK_TYPE_NANO_TIME:
+                case BLINK_TYPE_MILLI_TIME:
+                case BLINK_TYPE_I64:
+                case BLINK_TYPE_ENUM:
+                    group->size += BLINK_Compact_sizeofSigned(value->i64);                
+                    break;        
+                case BLINK_TYPE_DECIMAL:
+                    group->size += BLINK_Compact_sizeofSigned(value->decimal.exponent);
+                    group->size += BLINK_Compact_sizeofSigned(value->decimal.mantissa);
+                    break;        
+                case BLINK_TYPE_OBJECT:
+                case BLINK_TYPE_DYNAMIC_GROUP:
+                case BLINK_TYPE_STATIC_GROUP:
+                    if(cacheSize(value->group)){
+
+                        group->size += value->group->size;
+
+                        if(type == BLINK_TYPE_STATIC_GROUP){
+
+                            group->size += (f->desc->isOptional && !isSequence) ? 1U : 0U;   /* presence */
+                        }
+                        else{
+
+                            uint32_t sizeID = BLINK_Compact_sizeofUnsigned(BLINK_Group_getID(value->group->definition));
+                            group->size += sizeID;
+                            group->size += BLINK_Compact_sizeofUnsigned(sizeID + value->group->size);
+                            //extensions go here
+                        }                    
+                    }
+                    else{
+
+                        return false;
+                    }
+                    break;        
+                default:
+                    /* impossible */
+                    break;
+                }
             }            
         }
+        else if(f->desc->isOptional){
+            
+            group->size += 1U;
+        }
         else{
 
-            if(self->initialised != NULL){
-
-                *self->initialised = true;
-            }
-            self->value->decimal.mantissa = mantissa;
-            self->value->decimal.exponent = exponent;
-            retval = true;
+            BLINK_ERROR("uninitialised field")
+            return false;
         }
     }
 
-    return retval;
+    return true;
 }
 
-static bool decodeCompact_staticGroup(struct decode_state *self)
+static bool encodeBody(const blink_object_t g, blink_stream_t out)
 {
-    bool retval = true;
-    bool isPresent = true;
-    struct stack_element *top = self->top;
+    uint32_t i;
+    uint32_t j;
+    uint32_t n;
+    
+    for(i=0U; i < g->numberOfFields; i++){
+
+        struct blink_object_field *f = &g->fields[i];
+
+        if(f->initialised){
+
+            bool isSequence = f->desc->isSequence;
+            
+            if(isSequence){
+
+                if(!BLINK_Compact_encodeU32(f->data.sequence.size, out)){
+
+                return false;
+                }
+
+                n = f->data.sequence.size;
+            }
+            else{
+
+                n = 1U;
+            }
+
+            for(j=0U; j < n; j++){
+
+                union blink_object_value *value = (isSequence) ? &f->data.sequence.elems[j].value : &f->data.value;
+
+                bool isOptional = f->desc->isOptional && !isSequence;
+                enum blink_type_tag type = f->desc->type;
                 
-    if(BLINK_Field_isOptional(top->f->definition)){
+                switch(type){
+                case BLINK_TYPE_STRING:            
+                case BLINK_TYPE_BINARY:
+                case BLINK_TYPE_FIXED:
 
-        if(!BLINK_Compact_decodePresent(&self->bounded, &isPresent)){
+                    if(type == BLINK_TYPE_FIXED){
 
-            retval = false;
-        }
-    }
+                        if(isOptional){
 
-    if(retval && isPresent){
+                            if(!BLINK_Compact_encodePresent(out)){
 
-        retval = false;
+                                return false;
+                            }
+                        }
+                    }
+                    else{
 
-        if(top == &self->stack[(BLINK_OBJECT_NEST_DEPTH-1U)]){
+                        if(!BLINK_Compact_encodeU32(value->string.len, out)){
 
-            BLINK_ERROR("too much nesting")
-        }
-        else{
+                            return false;
+                        }
+                    }
 
-            (void)memset(&top[1], 0, sizeof(*self->stack));
+                    if(!BLINK_Stream_writeRef(out, value->string.data, value->string.len)){
 
-            top[1].g = BLINK_Object_newGroup(self->alloc, BLINK_Field_getGroup(top->f->definition));
+                        return false;
+                    }                    
+                    break;
+        
+                case BLINK_TYPE_BOOL:
 
-            if(top[1].g != NULL){
+                    if(!BLINK_Compact_encodeBool(value->boolean, out)){
 
-                top = &top[1];
-                retval = true;
-            }
-            else{
+                        return false;
+                    }
+                    break;
 
-                BLINK_ERROR("calloc()")
-            }            
-        }
-    }
+                case BLINK_TYPE_U8:
+                case BLINK_TYPE_U16:
+                case BLINK_TYPE_U32:
+                case BLINK_TYPE_TIME_OF_DAY_MILLI:
+                case BLINK_TYPE_U64:            
+                case BLINK_TYPE_TIME_OF_DAY_NANO:
 
-    return retval;
-}
+                    if(!BLINK_Compact_encodeU64(value->u64, out)){
 
-static bool decodeCompact_dynamicGroup(struct decode_state *self)
-{
-    bool retval = false;
-    bool isNull;
-    uint32_t size;
-    uint64_t id;
-    blink_schema_t groupDef;
-    struct stack_element *top = self->top;
-    
-    if(BLINK_Compact_decodeU32(&self->bounded, &size, &isNull)){
+                        return false;
+                    }
+                    break;
+                    
+                case BLINK_TYPE_I8:        
+                case BLINK_TYPE_I16:
+                case BLINK_TYPE_I32:
+                case BLINK_TYPE_DATE:
+                case BLINK_TYPE_NANO_TIME:
+                case BLINK_TYPE_MILLI_TIME:
+                case BLINK_TYPE_I64:
+                case BLINK_TYPE_ENUM:
+                
+                    if(!BLINK_Compact_encodeI64(value->i64, out)){
 
-        if(isNull){
+                        return false;
+                    }
+                    break;
 
-            if(BLINK_Field_isOptional(top->f->definition)){
+                case BLINK_TYPE_F64:
 
-                retval = true;
-            }            
-        }
-        else if(size == 0U){
+                    if(!BLINK_Compact_encodeF64(value->f64, out)){
 
-            BLINK_ERROR("W1: Group cannot have size of zero")
-        }
-        else if((BLINK_Stream_max(&self->bounded) - BLINK_Stream_tell(&self->bounded)) < size){
+                        return false;
+                    }
+                    break;
 
-            BLINK_ERROR("S1: nested group will overrun parent group")
-        }
-        else{
+                case BLINK_TYPE_DECIMAL:
 
-            if(top == &self->stack[(BLINK_OBJECT_NEST_DEPTH-1U)]){
+                    if(!BLINK_Compact_encodeDecimal(value->decimal.mantissa, value->decimal.exponent, out)){
 
-                BLINK_ERROR("too much nesting")
-            }
-            else{
+                        return false;
+                    }
+                    break;
 
-                (void)memset(&top[1], 0, sizeof(*self->stack));
+                case BLINK_TYPE_STATIC_GROUP:
 
-                BLINK_Stream_setMax(&self->bounded, top->max);
-                        
-                if(BLINK_Compact_decodeU64(&self->bounded, &id, &isNull)){
+                    if(isOptional){
 
-                    if(!isNull){
+                        if(!BLINK_Compact_encodePresent(out)){
 
-                        groupDef = BLINK_Schema_getGroupByID(self->schema, id);
+                            return false;
+                        }
                     }
+                
+                    if(!encodeBody(value->group, out)){
 
-                    if(isNull || (groupDef == NULL)){
+                        return false;
+                    }
+                    break;
+                
+                case BLINK_TYPE_OBJECT:
+                case BLINK_TYPE_DYNAMIC_GROUP:
 
-                        BLINK_ERROR("W14: Group is unknown")
+                    if(BLINK_Stream_canReserve(out)){
+
+                        if(!encodeGroup(value->group, out)){
+
+                            return false;
+                        }
                     }
                     else{
 
-                        if((BLINK_Field_getType(top->f->definition) == BLINK_TYPE_OBJECT) || BLINK_Group_isKindOf(groupDef, BLINK_Field_getGroup(top->f->definition))){
-
-                            top = &top[1];
-                            top->max = size;
+                        uint64_t id = BLINK_Group_getID(value->group->definition);
 
-                            top->g = BLINK_Object_newGroup(self->alloc, groupDef);
+                        /* size cached by cacheSize() */
+                        if(!BLINK_Compact_encodeU32(value->group->size + BLINK_Compact_sizeofUnsigned(id), out)){
 
-                            if(top->g != NULL){
+                            return false;
+                        }
 
-                                retval = true;
-                            }
-                            else{
+                        if(!BLINK_Compact_encodeU64(id, out)){
 
-                                BLINK_ERROR("calloc()")
-                            }
+                            return false;
                         }
-                        else{
 
-                            BLINK_ERROR("not what we expect")
+                        if(!encodeBody(value->group, out)){
+
+                            return false;
                         }
                     }
+
+                    //we aren't doing extensions
+                    break;
+                
+                default:
+                    /* impossible */
+                    break;
                 }
             }
         }
+        else if(f->desc->isOptional){
+
+            if(!BLINK_Compact_encodeNull(out)){
+
+                return false;
+            }
+        }
+        else{
+
+            BLINK_ERROR("uninitialised field")
+            return false;
+        }
     }
-     
-    return retval;
+
+    return true;
 }
 
-static bool BLINK_Object_set(blink_object_t group, const char *fieldName, const union blink_object_value *value)
+/* encode size preamble, ID, and body in a single pass
+ *
+ * One byte is reserved for the size preamble (enough for groups of
+ * less than 128 bytes) and back-patched once the body has been encoded.
+ * If the preamble turns out to be wider the body is shifted along to
+ * make room. */
+static bool encodeGroup(const blink_object_t g, blink_stream_t out)
 {
-    BLINK_ASSERT(group != NULL)
-
     bool retval = false;
-    struct blink_object_field *field = lookupField(group, fieldName, strlen(fieldName));
-
-    if(field != NULL){
-    
-        enum blink_type_tag type = BLINK_Field_getType(field->definition);
+    uint8_t *preamble = BLINK_Stream_reserve(out, 1U);
 
-        switch(type){
-        case BLINK_TYPE_STRING:            
-        case BLINK_TYPE_BINARY:         
+    if(preamble != NULL){
 
-            if(value->string.len <= BLINK_Field_getSize(field->definition)){
+        uint64_t start = BLINK_Stream_tell(out);
 
-                uint8_t *data = group->alloc.calloc(1, value->string.len);
+        if(BLINK_Compact_encodeU64(BLINK_Group_getID(g->definition), out) && encodeBody(g, out)){
 
-                if(data != NULL){
-
-                    (void)memcpy(data, value->string.data, value->string.len);
-                    field->data.value.string.data = data;
-                    field->data.value.string.len = value->string.len;
-                    retval = true;                    
-                }
-                else{
+            uint64_t length = BLINK_Stream_tell(out) - start;
+            uint32_t size = (uint32_t)length;
+            uint8_t width = BLINK_Compact_sizeofUnsigned(size);
 
-                    BLINK_ERROR("calloc()");
-                }        
-            }
-            else{
+            /* the size preamble is a u32 */
+            if(length > (uint64_t)UINT32_MAX){
 
-                BLINK_ERROR("string too large for definition")
+                BLINK_ERROR("group is too large to encode")
             }
-            break;
-        case BLINK_TYPE_FIXED:
-            if(value->string.len == BLINK_Field_getSize(field->definition)){
-
-                uint8_t *data = group->alloc.calloc(1, value->string.len);
+            else if(width > 1U){
 
-                if(data != NULL){
+                if(BLINK_Stream_reserve(out, width - 1U) != NULL){
 
-                    (void)memcpy(data, value->string.data, value->string.len);
-                    field->data.value.string.data = data;
-                    field->data.value.string.len = value->string.len;
+                    (void)memmove(&preamble[width], &preamble[1], size);
                     retval = true;
                 }
-                else{
-
-                    BLINK_ERROR("calloc()");
-                }            
             }
             else{
 
-                BLINK_ERROR("wrong size fixed field")
+                retval = true;
             }
-            break;
-        case BLINK_TYPE_BOOL:
-            field->data.value.boolean = value->boolean;
-            retval = true;
-            break;
-        case BLINK_TYPE_U8:
-        case BLINK_TYPE_U16:
-        case BLINK_TYPE_U32:
-        case BLINK_TYPE_U64:
-        case BLINK_TYPE_TIME_OF_DAY_MILLI:
-        case BLINK_TYPE_TIME_OF_DAY_NANO:
-            field->data.value.u64 = value->u64;
-            retval = true;
-            break;        
-        case BLINK_TYPE_I8:        
-        case BLINK_TYPE_I16:
-        case BLINK_TYPE_I32:
-        case BLINK_TYPE_DATE:
-        case BLINK_TYPE_NANO_TIME:
-        case BLINK_TYPE_MILLI_TIME:
-        case BLINK_TYPE_I64:
-            field->data.value.i64 = value->i64;
-            retval = true;
-            break;        
-        case BLINK_TYPE_ENUM:
-        {
-            blink_schema_t s = BLINK_Enum_getSymbolByName(field->definition, (char *)value->string.data);
 
-            if(s != NULL){
+            if(retval){
 
-                field->data.value.i64 = (int64_t)BLINK_Symbol_getValue(s);
-                retval = true;
-            }
-            else{
+                struct blink_stream patch;
 
-                BLINK_ERROR("enum symbol \"%s\" is undefined", value->string.data)
+                (void)BLINK_Stream_initBuffer(&patch, preamble, width);
+                retval = BLINK_Compact_encodeU32(size, &patch);
             }
         }
-            break;            
-        case BLINK_TYPE_F64:
-            field->data.value.f64 = value->f64;
-            retval = true;
-            break;                
-        case BLINK_TYPE_DECIMAL:
-            field->data.value.decimal = value->decimal;
-            retval = true;
-            break;        
-        case BLINK_TYPE_DYNAMIC_GROUP:
-            if(BLINK_Group_hasID(value->group->definition)){
+    }
 
-                field->data.value.group = value->group;
-                retval = true;
-            }
-            else{
+    return retval;
+}
 
-                BLINK_ERROR("expecting a Group that can be encoded dynamically")                
-            }
-            break;
-        case BLINK_TYPE_STATIC_GROUP:
-            field->data.value.group = value->group;
-            retval = true;
-            break;        
-        default:
-            break;
-        }
+/* size of an arena allocation */
+static size_t alignedSize(size_t size)
+{
+    return (size + (BLINK_ARENA_ALIGN - 1U)) & ~((size_t)BLINK_ARENA_ALIGN - 1U);
+}
+
+/* saturating accumulate */
+static void addSize(size_t *size, size_t n)
+{
+    *size = ((SIZE_MAX - *size) < n) ? SIZE_MAX : (*size + n);
+}
 
-        if(retval == true){
+/* size of what BLINK_Object_newGroup() allocates */
+static size_t sizeofNewGroup(blink_schema_t group)
+{
+    size_t retval = alignedSize(sizeof(struct blink_object));
+    size_t n = BLINK_Group_numberOfFields(group);
 
-            field->initialised = true;
-        }
+    if(n > 0U){
+
+        addSize(&retval, alignedSize(n * sizeof(struct blink_object_field)));
     }
 
-    return retval;    
+    return retval;
 }
 
-static union blink_object_value BLINK_Object_get(blink_object_t group, const char *fieldName)
+/* upper bound from the definition alone
+ *
+ * A static group that would nest too deeply cannot be decoded and so
+ * adds nothing. */
+static bool boundGroup(blink_schema_t group, uint8_t depth, size_t *size)
 {
-    BLINK_ASSERT(group != NULL)
+    bool retval = true;
+    const struct blink_field_desc *desc = BLINK_Group_getFieldDescs(group);
+    size_t n = BLINK_Group_numberOfFields(group);
+    size_t i;
 
-    union blink_object_value retval;
-    (void)memset(&retval, 0, sizeof(retval));
-    struct blink_object_field *field = lookupField(group, fieldName, strlen(fieldName));
+    addSize(size, sizeofNewGroup(group));
 
-    if(field != NULL){
-    
-        enum blink_type_tag type = BLINK_Field_getType(field->definition);
+    for(i=0U; retval && (i < n); i++){
 
-        if(field->initialised){
+        if(desc[i].isSequence){
 
-            if(type == BLINK_TYPE_ENUM){
+            retval = false;
+        }
+        else{
 
-                blink_schema_t s = BLINK_Enum_getSymbolByValue(field->definition, (int32_t)field->data.value.i64);
+            switch(desc[i].type){
+            case BLINK_TYPE_STRING:
+            case BLINK_TYPE_BINARY:
+            case BLINK_TYPE_FIXED:
+                if(desc[i].size == UINT32_MAX){
 
-                if(s != NULL){
+                    retval = false;
+                }
+                else{
 
-                    retval.string.data = (uint8_t *)BLINK_Symbol_getName(s);                    
-                }                            
-            }
-            else{
+                    addSize(size, alignedSize(desc[i].size));
+                }
+                break;
+            case BLINK_TYPE_STATIC_GROUP:
+                if((depth + 1U) < BLINK_OBJECT_NEST_DEPTH){
 
-                retval = field->data.value;
+                    retval = boundGroup(desc[i].ref, depth + 1U, size);
+                }
+                break;
+            case BLINK_TYPE_DYNAMIC_GROUP:
+            case BLINK_TYPE_OBJECT:
+                retval = false;
+                break;
+            default:
+                break;
             }
         }
     }
 
-    return retval;    
+    return retval;
 }
 
-static struct blink_object_field *lookupField(struct blink_object *group, const char *name, size_t nameLen)
+/* walk the fields of an encoded group, adding up what the decoder would
+ * allocate */
+static bool measureGroup(struct measure_state *self, blink_schema_t group)
 {
+    bool retval = true;
+    const struct blink_field_desc *desc = BLINK_Group_getFieldDescs(group);
+    size_t n = BLINK_Group_numberOfFields(group);
     size_t i;
-    struct blink_object_field *retval = NULL;
-
-    for(i=0; i < group->numberOfFields; i++){
 
-        const char *fname = BLINK_Field_getName(group->fields[i].definition);
-        if(strcmp(fname, name) == 0){
-
-            retval = &group->fields[i];
-            break;
-        }
-    }
+    addSize(&self->size, sizeofNewGroup(group));
 
-    if(i == group->numberOfFields){
+    for(i=0U; retval && (i < n); i++){
 
-        /* field not found */
-        BLINK_DEBUG("field name %s does not exist for group %s", name, BLINK_Group_getName(group->definition))
+        retval = (desc[i].isSequence) ? measureSequence(self, &desc[i]) : measureValue(self, &desc[i]);
     }
 
     return retval;
 }
 
-/* recursively walks group and calculates encoded size and determines
- * if all mandatory fields have been initialised */
-static bool cacheSize(blink_object_t group)
+static bool measureSequence(struct measure_state *self, const struct blink_field_desc *desc)
 {
-    struct sequence_elem *seq;
-    uint32_t i;
-    group->size = 0U;
-    
-    for(i=0U; i < group->numberOfFields; i++){
+    bool retval = false;
+    bool isNull;
+    uint32_t count;
 
-        enum blink_type_tag type = BLINK_Field_getType(group->fields[i].definition);
+    if(BLINK_Compact_decodeU32(&self->bounded, &count, &isNull)){
 
-        struct blink_object_field *f = &group->fields[i];
+        if(isNull){
 
-        bool isSequence = BLINK_Field_isSequence(f->definition);
+            retval = true;
+        }
+        else{
 
-        if(f->initialised){
+            uint64_t remaining = BLINK_Stream_max(&self->bounded) - BLINK_Stream_tell(&self->bounded);
+            uint32_t capacity = ((uint64_t)count < remaining) ? count : (uint32_t)remaining;
+            uint32_t i;
+            struct blink_field_desc elem = *desc;
 
-            if(isSequence){
+            /* elements never have a presence flag */
+            elem.isOptional = false;
 
-                group->size += BLINK_Compact_sizeofUnsigned(f->data.sequence.size);
-                seq = f->data.sequence.head;
-            }
-            else{
+            /* mirror reserveElems() followed by growElems() */
+            if(capacity > 0U){
 
-                seq = NULL;
+                addSize(&self->size, alignedSize((size_t)capacity * sizeof(struct sequence_elem)));
             }
 
-            if(!isSequence || (seq != NULL)){
-
-                do{
+            while(capacity < count){
 
-                    union blink_object_value *value;
+                uint32_t size = capacity + 1U;
 
-                    if(isSequence){
+                capacity = (capacity < (UINT32_MAX / 2U)) ? (capacity * 2U) : UINT32_MAX;
+                capacity = (capacity < 4U) ? 4U : capacity;
+                capacity = (capacity < size) ? size : capacity;
 
-                        value = &seq->value;
-                        seq = seq->next;
-                    }
-                    else{
+                addSize(&self->size, alignedSize((size_t)capacity * sizeof(struct sequence_elem)));
+            }
 
-                        value = &f->data.value;
-                    }
-                
-                    switch(type){
-                    case BLINK_TYPE_STRING:            
-                    case BLINK_TYPE_BINARY:
-                        group->size += BLINK_Compact_sizeofUnsigned(value->string.len);
-                        group->size += value->string.len;
-                        break;            
-                    case BLINK_TYPE_FIXED:
-                        group->size += value->string.len;
-                        break;            
-                    case BLINK_TYPE_BOOL:
-                        group->size += 1U;            
-                        break;
-                    case BLINK_TYPE_U8:
-                    case BLINK_TYPE_U16:
-                    case BLINK_TYPE_U32:
-                    case BLINK_TYPE_U64:
-                    case BLINK_TYPE_TIME_OF_DAY_MILLI:
-                    case BLINK_TYPE_TIME_OF_DAY_NANO:
-                    case BLINK_TYPE_F64:
-                        group->size += BLINK_Compact_sizeofUnsigned(value->u64);                
-                        break;        
-                    case BLINK_TYPE_I8:        
-                    case BLINK_TYPE_I16:
-                    case BLINK_TYPE_I32:
-                    case BLINK_TYPE_DATE:
-                    case BLINK_TYPE_NANO_TIME:
-                    case BLINK_TYPE_MILLI_TIME:
-                    case BLINK_TYPE_I64:
-                    case BLINK_TYPE_ENUM:
-                        group->size += BLINK_Compact_sizeofSigned(value->i64);                
-                        break;        
-                    case BLINK_TYPE_DECIMAL:
-                        group->size += BLINK_Compact_sizeofSigned(value->decimal.exponent);
-                        group->size += BLINK_Compact_sizeofSigned(value->decimal.mantissa);
-                        break;        
-                    case BLINK_TYPE_DYNAMIC_GROUP:
-                    case BLINK_TYPE_STATIC_GROUP:
-                        if(cacheSize(value->group)){
-
-                            group->size += value->group->size;
-
-                            if(type == BLINK_TYPE_DYNAMIC_GROUP){
-
-                                uint32_t sizeID = BLINK_Compact_sizeofUnsigned(BLINK_Group_getID(value->group->definition));
-                                group->size += sizeID;
-                                group->size += BLINK_Compact_sizeofUnsigned(sizeID + value->group->size);
-                                //extensions go here
-                            }                    
-                        }
-                        else{
+            retval = true;
 
-                            return false;
-                        }
-                        break;        
-                    default:
-                        /* impossible */
-                        break;
-                    }
-                }
-                while(seq != NULL);
-            }            
-        }
-        else if(BLINK_Field_isOptional(f->definition)){
-            
-            group->size += 1U;
-        }
-        else{
+            for(i=0U; retval && (i < count); i++){
 
-            BLINK_ERROR("uninitialised field")
-            return false;
+                retval = measureValue(self, &elem);
+            }
         }
     }
 
-    return true;
+    return retval;
 }
 
-static bool encodeBody(const blink_object_t g, blink_stream_t out)
+static bool measureValue(struct measure_state *self, const struct blink_field_desc *desc)
 {
-    struct sequence_elem *seq;
     bool retval = false;
-    uint32_t i;
-    
-    for(i=0U; i < g->numberOfFields; i++){
-
-        struct blink_object_field *f = &g->fields[i];
-
-        if(f->initialised){
+    bool isNull;
+    bool isPresent = true;
+    uint32_t size;
+    uint64_t u64;
+    int64_t i64;
+    int8_t exponent;
+    double f64;
+    bool boolean;
 
-            bool isSequence = BLINK_Field_isSequence(f->definition);
-            
-            if(isSequence){
+    switch(desc->type){
+    case BLINK_TYPE_STRING:
+    case BLINK_TYPE_BINARY:
+        if(BLINK_Compact_decodeU32(&self->bounded, &size, &isNull)){
 
-                if(!BLINK_Compact_encodeU32(f->data.sequence.size, out)){
+            retval = (isNull) ? true : measureString(self, size);
+        }
+        break;
+    case BLINK_TYPE_FIXED:
+        retval = (desc->isOptional) ? BLINK_Compact_decodePresent(&self->bounded, &isPresent) : true;
 
-                    break;
-                }
+        if(retval && isPresent){
 
-                seq = f->data.sequence.head;
+            retval = measureString(self, desc->size);
+        }
+        break;
+    case BLINK_TYPE_BOOL:
+        retval = BLINK_Compact_decodeBool(&self->bounded, &boolean, &isNull);
+        break;
+    case BLINK_TYPE_U8:
+    case BLINK_TYPE_U16:
+    case BLINK_TYPE_U32:
+    case BLINK_TYPE_U64:
+    case BLINK_TYPE_TIME_OF_DAY_MILLI:
+    case BLINK_TYPE_TIME_OF_DAY_NANO:
+        retval = BLINK_Compact_decodeU64(&self->bounded, &u64, &isNull);
+        break;
+    case BLINK_TYPE_F64:
+        retval = BLINK_Compact_decodeF64(&self->bounded, &f64, &isNull);
+        break;
+    case BLINK_TYPE_DECIMAL:
+        retval = BLINK_Compact_decodeDecimal(&self->bounded, &i64, &exponent, &isNull);
+        break;
+    case BLINK_TYPE_STATIC_GROUP:
+        retval = (desc->isOptional) ? BLINK_Compact_decodePresent(&self->bounded, &isPresent) : true;
+
+        if(retval && isPresent){
+
+            if((self->depth + 1U) < BLINK_OBJECT_NEST_DEPTH){
+
+                self->depth++;
+                retval = measureGroup(self, desc->ref);
+                self->depth--;
             }
             else{
 
-                seq = NULL;
+                BLINK_ERROR("too much nesting")
+                retval = false;
             }
+        }
+        break;
+    case BLINK_TYPE_DYNAMIC_GROUP:
+    case BLINK_TYPE_OBJECT:
+        retval = measureDynamicGroup(self, desc);
+        break;
+    default:
+        /* signed integers, times, dates, and enums */
+        retval = BLINK_Compact_decodeI64(&self->bounded, &i64, &isNull);
+        break;
+    }
 
-            if(!isSequence || (seq != NULL)){
-
-                do{                
-
-                    union blink_object_value *value;
-
-                    if(isSequence){
-
-                        value = &seq->value;
-                        seq = seq->next;
-                    }
-                    else{
-
-                        value = &f->data.value;
-                    }
-
-                    bool isOptional = BLINK_Field_isOptional(f->definition);
-                    enum blink_type_tag type = BLINK_Field_getType(f->definition);
-                    
-                    switch(type){
-                    case BLINK_TYPE_STRING:            
-                    case BLINK_TYPE_BINARY:
-                    case BLINK_TYPE_FIXED:
-
-                        if(type == BLINK_TYPE_FIXED){
-
-                            if(isOptional){
-
-                                if(!BLINK_Compact_encodePresent(out)){
-
-                                    return NULL;
-                                }
-                            }
-                        }
-                        else{
-
-                            if(!BLINK_Compact_encodeU32(value->string.len, out)){
-
-                                return NULL;
-                            }
-                        }
-
-                        if(!BLINK_Stream_write(out, value->string.data, value->string.len)){
-
-                            return NULL;
-                        }                    
-                        break;
-        
-                    case BLINK_TYPE_BOOL:
-
-                        if(!BLINK_Compact_encodeBool(value->boolean, out)){
-
-                            return NULL;
-                        }
-                        break;
-
-                    case BLINK_TYPE_U8:
-                    case BLINK_TYPE_U16:
-                    case BLINK_TYPE_U32:
-                    case BLINK_TYPE_TIME_OF_DAY_MILLI:
-                    case BLINK_TYPE_U64:            
-                    case BLINK_TYPE_TIME_OF_DAY_NANO:
+    return retval;
+}
 
-                        if(!BLINK_Compact_encodeU64(value->u64, out)){
+/* skip string data, counting the copy made by readString() */
+static bool measureString(struct measure_state *self, uint32_t size)
+{
+    bool retval = (BLINK_Stream_borrow(&self->bounded, size) != NULL);
 
-                            return NULL;
-                        }
-                        break;
-                        
-                    case BLINK_TYPE_I8:        
-                    case BLINK_TYPE_I16:
-                    case BLINK_TYPE_I32:
-                    case BLINK_TYPE_DATE:
-                    case BLINK_TYPE_NANO_TIME:
-                    case BLINK_TYPE_MILLI_TIME:
-                    case BLINK_TYPE_I64:
-                    case BLINK_TYPE_ENUM:
-                
-                        if(!BLINK_Compact_encodeI64(value->i64, out)){
+    if(retval && !self->zeroCopy && (size > 0U)){
 
-                            return NULL;
-                        }
-                        break;
+        addSize(&self->size, alignedSize(size));
+    }
 
-                    case BLINK_TYPE_F64:
+    return retval;
+}
 
-                        if(!BLINK_Compact_encodeF64(value->f64, out)){
+static bool measureDynamicGroup(struct measure_state *self, const struct blink_field_desc *desc)
+{
+    bool retval = false;
+    bool isNull;
+    uint32_t size;
+    uint64_t max;
+    uint64_t id;
 
-                            return NULL;
-                        }
-                        break;
+    if(BLINK_Compact_decodeU32(&self->bounded, &size, &isNull)){
 
-                    case BLINK_TYPE_DECIMAL:
+        if(isNull){
 
-                        if(!BLINK_Compact_encodeDecimal(value->decimal.mantissa, value->decimal.exponent, out)){
+            retval = true;
+        }
+        else if(size == 0U){
 
-                            return NULL;
-                        }
-                        break;
+            BLINK_ERROR("W1: Group cannot have size of zero")
+        }
+        else if((BLINK_Stream_max(&self->bounded) - BLINK_Stream_tell(&self->bounded)) < size){
 
-                    case BLINK_TYPE_STATIC_GROUP:
+            BLINK_ERROR("S1: nested group will overrun parent group")
+        }
+        else if((self->depth + 1U) >= BLINK_OBJECT_NEST_DEPTH){
 
-                        if(isOptional){
+            BLINK_ERROR("too much nesting")
+        }
+        else{
 
-                            if(!BLINK_Compact_encodePresent(out)){
+            max = BLINK_Stream_max(&self->bounded);
+            (void)BLINK_Stream_setMax(&self->bounded, BLINK_Stream_tell(&self->bounded) + size);
 
-                                return NULL;
-                            }
-                        }
-                    
-                        if(!encodeBody(value->group, out)){
+            if(BLINK_Compact_decodeU64(&self->bounded, &id, &isNull)){
 
-                            return NULL;
-                        }
-                        break;
-                    
-                    case BLINK_TYPE_DYNAMIC_GROUP:
-                    
-                        if(!BLINK_Compact_encodeU32(value->group->size, out)){
+                blink_schema_t groupDef = (isNull) ? NULL : BLINK_Schema_getGroupByID(self->schema, id);
 
-                            return NULL;
-                        }
+                if(groupDef == NULL){
 
-                        if(!BLINK_Compact_encodeU64(BLINK_Group_getID(value->group->definition), out)){
+                    BLINK_ERROR("W14: Group is unknown")
+                }
+                else if((desc->type != BLINK_TYPE_OBJECT) && !BLINK_Group_isKindOf(groupDef, desc->ref)){
 
-                            return NULL;
-                        }
+                    BLINK_ERROR("not what we expect")
+                }
+                else{
 
-                        if(!encodeBody(value->group, out)){
+                    self->depth++;
+                    retval = measureGroup(self, groupDef);
+                    self->depth--;
 
-                            return NULL;
-                        }
+                    if(retval && (BLINK_Stream_tell(&self->bounded) < BLINK_Stream_max(&self->bounded))){
 
-                        //we aren't doing extensions
-                        break;
-                    
-                    default:
-                        /* impossible */
-                        break;
+                        BLINK_ERROR("additional bytes at end of group are not allowed...for now")
+                        retval = false;
                     }
                 }
-                while(seq != NULL);
             }
-        }
-        else{
-
-            if(!BLINK_Compact_encodeNull(out)){
 
-                break;
-            }
+            (void)BLINK_Stream_setMax(&self->bounded, max);
         }
     }
 
     return retval;
 }
 
-static bool initFieldsHandler(blink_schema_t group, blink_schema_t field, void *user)
+static bool isSelected(const struct blink_field_mask *mask, uint32_t field)
 {
-    struct field_init_user_data *data = (struct field_init_user_data *)user;
-
-    data->self->fields[data->i].definition = field;
-    data->i++;    
-    return true;    
+    return ((mask->selected[field / 8U] & (1U << (field % 8U))) != 0U);
 }
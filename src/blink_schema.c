@@ -56,12 +56,29 @@ static void splitCName(const char *in, size_t inLen, const char **nsName, size_t
 static bool resolveDefinitions(struct blink_schema_base *self);
 static struct blink_schema *resolve(struct blink_schema_base *self, const char *cName);
 
+static bool indexGroupsByID(struct blink_schema_base *self);
+static size_t hashID(uint64_t id, size_t mask);
+
+static bool indexNames(struct blink_schema_base *self);
+static bool flattenFields(struct blink_schema_base *self);
+static bool compilePrograms(struct blink_schema_base *self);
+static uint8_t opcode(enum blink_type_tag type);
+static bool isIntegerOp(uint8_t code);
+static void initFieldDesc(struct blink_field_desc *desc, struct blink_schema *field);
+static bool indexList(const struct blink_allocator *alloc, struct blink_schema_table *table, struct blink_schema *head);
+static bool initTable(const struct blink_allocator *alloc, struct blink_schema_table *table, size_t numberOfElements);
+static void insertTable(struct blink_schema_table *table, struct blink_schema *element);
+static struct blink_schema *searchTable(const struct blink_schema_table *table, const char *name, size_t nameLen, uint32_t hash);
+static uint32_t hashName(const char *name, size_t nameLen);
+static bool nameEquals(const char *name, const char *other, size_t otherLen);
+
 static bool testConstraints(struct blink_schema_base *self);
 static bool testReferenceConstraint(struct blink_schema_base *self, struct blink_schema *reference);
 static bool testSuperGroupReferenceConstraint(struct blink_schema_base *self, struct blink_schema_group *group);
 static bool testSuperGroupShadowConstraint(struct blink_schema_base *self, struct blink_schema_group *group);
 
 static struct blink_schema *getTerminal(struct blink_schema *element, bool *dynamic, bool *sequence);
+static bool isTypeDefRef(const struct blink_schema_type_def *self);
 
 static struct blink_group_iterator initDefinitionIterator(struct blink_schema *ns);
 static struct blink_schema *nextDefinition(struct blink_group_iterator *iter);
@@ -86,7 +103,7 @@ static blink_schema_t takeAnnotes(blink_schema_t *annotes);
 blink_schema_t BLINK_Schema_new(const struct blink_allocator *alloc, blink_stream_t in)
 {
     blink_schema_t retval = NULL;    
-    struct blink_schema_base *self = alloc->calloc(1U, sizeof(struct blink_schema_base));
+    struct blink_schema_base *self = BLINK_Allocator_calloc(alloc, 1U, sizeof(struct blink_schema_base));
 
     if(self != NULL){
 
@@ -99,11 +116,23 @@ blink_schema_t BLINK_Schema_new(const struct blink_allocator *alloc, blink_strea
 
         if(parseSchema(self, &ctxt)){
 
-            if(resolveDefinitions(self)){
+            if(indexNames(self)){
+
+                if(resolveDefinitions(self)){
+
+                    if(indexGroupsByID(self)){
+
+                        if(testConstraints(self)){
 
-                if(testConstraints(self)){
+                            if(flattenFields(self)){
 
-                    retval = (blink_schema_t)self;
+                                if(compilePrograms(self)){
+
+                                    retval = (blink_schema_t)self;
+                                }
+                            }
+                        }
+                    }
                 }
             }
         }
@@ -121,38 +150,69 @@ blink_schema_t BLINK_Schema_getGroupByName(blink_schema_t self, const char *name
 {
     BLINK_ASSERT(self != NULL)
     BLINK_ASSERT(name != NULL)
-    
-    const char *lName;
-    size_t lNameLen;
-    const char *nsName;
-    size_t nsNameLen;
 
-    splitCName(name, strlen(name), &nsName, &nsNameLen, &lName, &lNameLen);
+    struct blink_name key = BLINK_Name_init(name);
+
+    return BLINK_Schema_getGroupByKey(self, &key);
+}
+
+blink_schema_t BLINK_Schema_getGroupByKey(blink_schema_t self, const struct blink_name *key)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(key != NULL)
+
+    blink_schema_t retval = NULL;
+    struct blink_schema_namespace *ns = castNamespace(searchTable(&castSchema(self)->nsByName, key->ns, key->nsLen, key->nsHash));
+
+    if(ns != NULL){
+
+        retval = searchTable(&ns->defByName, key->name, key->nameLen, key->nameHash);
+
+        if((retval != NULL) && (retval->type != BLINK_SCHEMA_GROUP)){
+
+            retval = NULL;
+        }
+    }
+
+    return retval;
+}
+
+struct blink_name BLINK_Name_init(const char *name)
+{
+    BLINK_ASSERT(name != NULL)
+
+    struct blink_name retval;
+
+    splitCName(name, strlen(name), &retval.ns, &retval.nsLen, &retval.name, &retval.nameLen);
 
-    struct blink_schema_namespace *ns = castNamespace(searchListByName(castSchema(self)->ns, nsName, nsNameLen));
+    retval.nsHash = hashName(retval.ns, retval.nsLen);
+    retval.nameHash = hashName(retval.name, retval.nameLen);
 
-    return (ns == NULL) ? NULL : (blink_schema_t)castGroup(searchListByName(ns->defs, lName, lNameLen));
+    return retval;
 }
 
 blink_schema_t BLINK_Schema_getGroupByID(blink_schema_t schema, uint64_t id)
 {
     BLINK_ASSERT(schema != NULL)
 
+    struct blink_schema_base *self = castSchema(schema);
     blink_schema_t retval = NULL;
-    struct blink_group_iterator iter = initDefinitionIterator(castSchema(schema)->ns);
-    blink_schema_t defPtr = peekDefinition(&iter);
+    size_t i;
 
-    while((retval == NULL) && (defPtr != NULL)){
+    if(self->groupByIDSize > 0U){
 
-        if(defPtr->type == BLINK_SCHEMA_GROUP){
+        i = hashID(id, self->groupByIDSize - 1U);
+
+        while(self->groupByID[i] != NULL){
 
-            if(castGroup(defPtr)->hasID && (castGroup(defPtr)->id == id)){
+            if(self->groupByID[i]->id == id){
 
-                retval = defPtr;
+                retval = (blink_schema_t)self->groupByID[i];
+                break;
             }
-        }
 
-        defPtr = nextDefinition(&iter);
+            i = (i + 1U) & (self->groupByIDSize - 1U);
+        }
     }
 
     return retval;
@@ -168,12 +228,21 @@ void BLINK_Group_eachField(blink_schema_t group, bool (*handler)(blink_schema_t
       
     size_t i;
     blink_schema_t ptr = group;
+    bool dynamic;
+    bool sequence;
 
     for(i=0U; i < depth; i++){
 
+        stack[i].g = ptr;
         stack[i].f = castGroup(ptr)->f;
+
+        if(castGroup(ptr)->s != NULL){
+
+            ptr = getTerminal(castGroup(ptr)->s, &dynamic, &sequence);
+        }
     }
 
+    /* fields of the root supergroup come first */
     while(i > 0){
 
         if(stack[i-1].f != NULL){
@@ -293,164 +362,108 @@ bool BLINK_Group_hasID(blink_schema_t self)
     return castGroup(self)->hasID;
 }
 
-static bool handlerCountNumberOfFields(blink_schema_t group, blink_schema_t field, void *user)
+size_t BLINK_Group_numberOfFields(blink_schema_t self)
 {
-    (*((size_t *)user))++;
-    return true;
+    BLINK_ASSERT(self != NULL)
+
+    return castGroup(self)->numberOfFields;
 }
 
-size_t BLINK_Group_numberOfFields(blink_schema_t self)
+const struct blink_field_desc *BLINK_Group_getFieldDescs(blink_schema_t self)
 {
     BLINK_ASSERT(self != NULL)
 
-    size_t retval = 0U;
-    
-    BLINK_Group_eachField(self, handlerCountNumberOfFields, &retval);
+    return castGroup(self)->fieldDesc;
+}
 
-    return retval;
+const struct blink_decode_op *BLINK_Group_getDecodeProgram(blink_schema_t self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    return castGroup(self)->program;
 }
 
-const char *BLINK_Field_getName(blink_schema_t self)
+blink_schema_t BLINK_Group_getFieldByName(blink_schema_t self, const char *name)
 {
-    return BLINK_Group_getName(self);
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(name != NULL)
+
+    size_t nameLen = strlen(name);
+
+    return searchTable(&castGroup(self)->fieldByName, name, nameLen, hashName(name, nameLen));
 }
 
-bool BLINK_Field_isOptional(blink_schema_t self)
+blink_schema_t BLINK_Group_getFieldByKey(blink_schema_t self, const struct blink_name *key)
 {
     BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(key != NULL)
 
-    return castField(self)->isOptional;
+    return searchTable(&castGroup(self)->fieldByName, key->name, key->nameLen, key->nameHash);
 }
 
-bool BLINK_Field_isSequence(blink_schema_t self)
+const char *BLINK_Field_getName(blink_schema_t self)
+{
+    return BLINK_Group_getName(self);
+}
+
+uint32_t BLINK_Field_getIndex(blink_schema_t self)
 {
     BLINK_ASSERT(self != NULL)
 
-    return castField(self)->type.isSequence;
+    return castField(self)->index;
 }
 
-enum blink_type_tag BLINK_Field_getType(blink_schema_t self)
+const struct blink_field_desc *BLINK_Field_getDesc(blink_schema_t self)
 {
     BLINK_ASSERT(self != NULL)
 
-    static const enum blink_type_tag translate[] = {
-        BLINK_TYPE_STRING,
-        BLINK_TYPE_BINARY,
-        BLINK_TYPE_FIXED,
-        BLINK_TYPE_BOOL,
-        BLINK_TYPE_U8,
-        BLINK_TYPE_U16,
-        BLINK_TYPE_U32,
-        BLINK_TYPE_U64,
-        BLINK_TYPE_I8,
-        BLINK_TYPE_I16,
-        BLINK_TYPE_I32,
-        BLINK_TYPE_I64,
-        BLINK_TYPE_F64,
-        BLINK_TYPE_DATE,              
-        BLINK_TYPE_TIME_OF_DAY_MILLI,
-        BLINK_TYPE_TIME_OF_DAY_NANO,
-        BLINK_TYPE_NANO_TIME,
-        BLINK_TYPE_MILLI_TIME,        
-        BLINK_TYPE_DECIMAL,
-        BLINK_TYPE_OBJECT            
-    };
+    return castField(self)->desc;
+}
 
-    struct blink_schema_field *field = castField(self);
-    enum blink_type_tag retval;
-    bool dynamic;
-    bool sequence;
+bool BLINK_Field_isOptional(blink_schema_t self)
+{
+    BLINK_ASSERT(self != NULL)
 
-    if(field->type.tag == BLINK_ITYPE_REF){ 
+    return castField(self)->desc->isOptional;
+}
 
-        struct blink_schema *ptr = getTerminal(field->type.attr.resolved, &dynamic, &sequence);
+bool BLINK_Field_isSequence(blink_schema_t self)
+{
+    BLINK_ASSERT(self != NULL)
 
-        switch(ptr->type){
-        case BLINK_SCHEMA_ENUM:
-            retval = BLINK_TYPE_ENUM;
-            break;
-        case BLINK_SCHEMA_GROUP:
-            retval = (dynamic) ? BLINK_TYPE_DYNAMIC_GROUP : BLINK_TYPE_STATIC_GROUP;
-            break;
-        default:
-            BLINK_ASSERT((size_t)castTypeDef(ptr)->type.tag < (sizeof(translate)/sizeof(*translate)))
-            retval = translate[castTypeDef(ptr)->type.tag];
-            break;
-        }        
-    }    
-    else{
+    return castField(self)->desc->isSequence;
+}
 
-        BLINK_ASSERT((size_t)field->type.tag < (sizeof(translate)/sizeof(*translate)))
-        retval = translate[field->type.tag];
-    }
+enum blink_type_tag BLINK_Field_getType(blink_schema_t self)
+{
+    BLINK_ASSERT(self != NULL)
 
-    return retval;
+    return castField(self)->desc->type;
 }
 
 uint32_t BLINK_Field_getSize(blink_schema_t self)
 {
-    uint32_t retval;
-
-    switch(BLINK_Field_getType(self)){
-    case BLINK_TYPE_BINARY:
-    case BLINK_TYPE_STRING:
-    case BLINK_TYPE_FIXED:
-        retval = castField(self)->type.attr.size;
-        break;
-    default:
-        retval = 0U;
-        break;
-    }
+    BLINK_ASSERT(self != NULL)
 
-    return retval;
+    return castField(self)->desc->size;
 }
 
 blink_schema_t BLINK_Field_getGroup(blink_schema_t self)
 {
     BLINK_ASSERT(self != NULL)
 
-    blink_schema_t retval = NULL;
-    struct blink_schema_field *field = castField(self);
-
-    if(field->type.tag == BLINK_ITYPE_REF){
-
-        bool dynamic;
-        bool sequence;
-        struct blink_schema *ref = getTerminal(field->type.attr.resolved, &dynamic, &sequence);
-
-        BLINK_ASSERT(ref != NULL)
-
-        if(ref->type == BLINK_SCHEMA_GROUP){
+    const struct blink_field_desc *desc = castField(self)->desc;
 
-            retval = (blink_schema_t)ref;
-        }
-    }
-
-    return retval;
+    return ((desc->type == BLINK_TYPE_STATIC_GROUP) || (desc->type == BLINK_TYPE_DYNAMIC_GROUP)) ? desc->ref : NULL;
 }
 
 blink_schema_t BLINK_Field_getEnum(blink_schema_t self)
 {
     BLINK_ASSERT(self != NULL)
 
-    blink_schema_t retval = NULL;
-    struct blink_schema_field *field = castField(self);
-
-    if(field->type.tag == BLINK_ITYPE_REF){
-
-        bool dynamic;
-        bool sequence;
-        struct blink_schema *ref = getTerminal(field->type.attr.resolved, &dynamic, &sequence);
-
-        BLINK_ASSERT(ref != NULL)
-
-        if(ref->type == BLINK_SCHEMA_ENUM){
+    const struct blink_field_desc *desc = castField(self)->desc;
 
-            retval = (blink_schema_t)ref;
-        }
-    }
-
-    return retval;
+    return (desc->type == BLINK_TYPE_ENUM) ? desc->ref : NULL;
 }
 
 blink_schema_t BLINK_Enum_getSymbolByName(blink_schema_t self, const char *name)
@@ -458,7 +471,17 @@ blink_schema_t BLINK_Enum_getSymbolByName(blink_schema_t self, const char *name)
     BLINK_ASSERT(self != NULL)
     BLINK_ASSERT(name != NULL)
     
-    return (blink_schema_t)searchListByName(castEnum(self)->s, name, strlen(name));
+    size_t nameLen = strlen(name);
+
+    return searchTable(&castEnum(self)->symbolByName, name, nameLen, hashName(name, nameLen));
+}
+
+blink_schema_t BLINK_Enum_getSymbolByKey(blink_schema_t self, const struct blink_name *key)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(key != NULL)
+
+    return searchTable(&castEnum(self)->symbolByName, key->name, key->nameLen, key->nameHash);
 }
 
 blink_schema_t BLINK_Enum_getSymbolByValue(blink_schema_t self, int32_t value)
@@ -1080,6 +1103,15 @@ static bool parseSchema(struct blink_schema_base *self, const struct blink_synta
                         type->name = laName;
                         state = P_TYPEDEF_TYPE_DYNAMIC;
                         break;
+
+                    case BLINK_ITYPE_STRING:
+                    case BLINK_ITYPE_BINARY:
+                        state = P_TYPEDEF_TYPE_LPAREN_OPTIONAL;
+                        break;
+
+                    case BLINK_ITYPE_FIXED:
+                        state = P_TYPEDEF_TYPE_LPAREN;
+                        break;
                     
                     default:
                         state = P_TYPEDEF_TYPE_LBRACKET;
@@ -1427,7 +1459,7 @@ static bool parseSchema(struct blink_schema_base *self, const struct blink_synta
                     
                     default:
 
-                        state = P_FIELD_NAME_ANNOTES;
+                        state = P_FIELD_TYPE_LBRACKET;
                         break;
                     }
                 }
@@ -1579,10 +1611,10 @@ static bool parseSchema(struct blink_schema_base *self, const struct blink_synta
                     switch(state){
                     default:
                     case P_FIELD_TYPE_LPAREN_OPTIONAL:
-                        state = P_FIELD_NAME_ANNOTES;
+                        state = P_FIELD_TYPE_LBRACKET;
                         break;
                     case P_TYPEDEF_TYPE_LPAREN_OPTIONAL:
-                        state = P_ANY;
+                        state = P_TYPEDEF_TYPE_LBRACKET;
                         break;
                     }
                 }
@@ -1604,10 +1636,10 @@ static bool parseSchema(struct blink_schema_base *self, const struct blink_synta
                         switch(state){
                         default:
                         case P_FIELD_TYPE_SIZE:
-                            state = P_FIELD_NAME_ANNOTES;
+                            state = P_FIELD_TYPE_RPAREN;
                             break;
                         case P_TYPEDEF_TYPE_SIZE:
-                            state = P_ANY;
+                            state = P_TYPEDEF_TYPE_RPAREN;
                             break;
                         }
                     }
@@ -1627,10 +1659,10 @@ static bool parseSchema(struct blink_schema_base *self, const struct blink_synta
                     switch(state){
                     default:
                     case P_FIELD_TYPE_RPAREN:
-                        state = P_FIELD_NAME_ANNOTES;
+                        state = P_FIELD_TYPE_LBRACKET;
                         break;
                     case P_TYPEDEF_TYPE_RPAREN:
-                        state = P_ANY;
+                        state = P_TYPEDEF_TYPE_LBRACKET;
                         break;
                     }
                 }
@@ -1875,9 +1907,505 @@ static struct blink_schema *resolve(struct blink_schema_base *self, const char *
 
     splitCName(cName, cNameLen, &nsName, &nsNameLen, &name, &nameLen);
 
-    nsPtr = searchListByName(self->ns, nsName, nsNameLen);
+    nsPtr = searchTable(&self->nsByName, nsName, nsNameLen, hashName(nsName, nsNameLen));
     
-    return (nsPtr != NULL) ? searchListByName(castNamespace(nsPtr)->defs, name, nameLen) : NULL;
+    return (nsPtr != NULL) ? searchTable(&castNamespace(nsPtr)->defByName, name, nameLen, hashName(name, nameLen)) : NULL;
+}
+
+static bool indexGroupsByID(struct blink_schema_base *self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    bool retval = true;
+    size_t numberOfGroups = 0U;
+    size_t i;
+    struct blink_schema_group *g;
+    struct blink_group_iterator iter = initDefinitionIterator(self->ns);
+    struct blink_schema *defPtr = nextDefinition(&iter);
+
+    while(defPtr != NULL){
+
+        if((defPtr->type == BLINK_SCHEMA_GROUP) && castGroup(defPtr)->hasID){
+
+            numberOfGroups++;
+        }
+
+        defPtr = nextDefinition(&iter);
+    }
+
+    if(numberOfGroups > 0U){
+
+        /* table is kept at most half full so that probe sequences stay short */
+        self->groupByIDSize = 1U;
+
+        while(self->groupByIDSize < (numberOfGroups * 2U)){
+
+            self->groupByIDSize <<= 1;
+        }
+
+        self->groupByID = BLINK_Allocator_calloc(&self->alloc, self->groupByIDSize, sizeof(*self->groupByID));
+
+        if(self->groupByID == NULL){
+
+            BLINK_ERROR("calloc()")
+            self->groupByIDSize = 0U;
+            retval = false;
+        }
+        else{
+
+            iter = initDefinitionIterator(self->ns);
+            defPtr = nextDefinition(&iter);
+
+            while(retval && (defPtr != NULL)){
+
+                if((defPtr->type == BLINK_SCHEMA_GROUP) && castGroup(defPtr)->hasID){
+
+                    g = castGroup(defPtr);
+                    i = hashID(g->id, self->groupByIDSize - 1U);
+
+                    while(self->groupByID[i] != NULL){
+
+                        if(self->groupByID[i]->id == g->id){
+
+                            BLINK_ERROR("duplicate group ID")
+                            retval = false;
+                            break;
+                        }
+
+                        i = (i + 1U) & (self->groupByIDSize - 1U);
+                    }
+
+                    if(retval){
+
+                        self->groupByID[i] = g;
+                    }
+                }
+
+                defPtr = nextDefinition(&iter);
+            }
+        }
+    }
+
+    return retval;
+}
+
+static bool indexNames(struct blink_schema_base *self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    bool retval = indexList(&self->alloc, &self->nsByName, self->ns);
+    struct blink_schema *nsPtr = self->ns;
+    struct blink_schema *defPtr;
+
+    while(retval && (nsPtr != NULL)){
+
+        retval = indexList(&self->alloc, &castNamespace(nsPtr)->defByName, castNamespace(nsPtr)->defs);
+        defPtr = castNamespace(nsPtr)->defs;
+
+        while(retval && (defPtr != NULL)){
+
+            if(defPtr->type == BLINK_SCHEMA_ENUM){
+
+                retval = indexList(&self->alloc, &castEnum(defPtr)->symbolByName, castEnum(defPtr)->s);
+            }
+
+            defPtr = defPtr->next;
+        }
+
+        nsPtr = nsPtr->next;
+    }
+
+    return retval;
+}
+
+static bool flattenFields(struct blink_schema_base *self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    bool retval = true;
+    struct blink_group_iterator iter = initDefinitionIterator(self->ns);
+    struct blink_schema *defPtr = nextDefinition(&iter);
+
+    while(retval && (defPtr != NULL)){
+
+        if(defPtr->type == BLINK_SCHEMA_GROUP){
+
+            struct blink_schema_group *group = castGroup(defPtr);
+            size_t depth = BLINK_Group_numberOfSuperGroup(defPtr) + 1U;
+            blink_schema_t stack[depth];
+            struct blink_field_iterator fi = BLINK_FieldIterator_init(stack, depth, defPtr);
+            size_t i = 0U;
+            blink_schema_t field;
+
+            while(BLINK_FieldIterator_next(&fi) != NULL){
+
+                i++;
+            }
+
+            group->numberOfFields = i;
+
+            if(group->numberOfFields > 0U){
+
+                group->fieldDesc = BLINK_Allocator_calloc(&self->alloc, group->numberOfFields, sizeof(*group->fieldDesc));
+
+                if(group->fieldDesc == NULL){
+
+                    BLINK_ERROR("calloc()")
+                    retval = false;
+                }
+            }
+
+            if(retval){
+
+                retval = initTable(&self->alloc, &group->fieldByName, group->numberOfFields);
+            }
+
+            if(retval){
+
+                fi = BLINK_FieldIterator_init(stack, depth, defPtr);
+                field = BLINK_FieldIterator_next(&fi);
+                i = 0U;
+
+                while(field != NULL){
+
+                    initFieldDesc(&group->fieldDesc[i], field);
+
+                    /* a field has the same position and type information in every group that contains it */
+                    castField(field)->index = (uint32_t)i;
+                    castField(field)->desc = &group->fieldDesc[i];
+
+                    insertTable(&group->fieldByName, field);
+
+                    i++;
+                    field = BLINK_FieldIterator_next(&fi);
+                }
+            }
+        }
+
+        defPtr = nextDefinition(&iter);
+    }
+
+    return retval;
+}
+
+static bool compilePrograms(struct blink_schema_base *self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    bool retval = true;
+    struct blink_group_iterator iter = initDefinitionIterator(self->ns);
+    struct blink_schema *defPtr = nextDefinition(&iter);
+
+    while(retval && (defPtr != NULL)){
+
+        if(defPtr->type == BLINK_SCHEMA_GROUP){
+
+            struct blink_schema_group *group = castGroup(defPtr);
+            size_t size = 1U;
+            size_t i;
+            struct blink_decode_op *op;
+
+            /* a sequence is a sequence operation followed by an element operation */
+            for(i=0U; i < group->numberOfFields; i++){
+
+                size += (group->fieldDesc[i].isSequence && !isIntegerOp(opcode(group->fieldDesc[i].type))) ? 2U : 1U;
+            }
+
+            group->program = BLINK_Allocator_calloc(&self->alloc, size, sizeof(*group->program));
+
+            if(group->program != NULL){
+
+                op = group->program;
+
+                for(i=0U; i < group->numberOfFields; i++){
+
+                    const struct blink_field_desc *desc = &group->fieldDesc[i];
+                    uint8_t code = opcode(desc->type);
+
+                    op->ref = desc->ref;
+                    op->field = (uint32_t)i;
+                    op->size = desc->size;
+                    op->type = desc->type;
+                    op->isOptional = desc->isOptional;
+
+                    if(desc->isSequence){
+
+                        /* integers are batch decoded */
+                        if(isIntegerOp(code)){
+
+                            op->code = BLINK_OP_INTEGER_SEQUENCE;
+                        }
+                        else{
+
+                            op->code = BLINK_OP_SEQUENCE;
+                            op[1] = op[0];
+                            op++;
+                            /* elements are never NULL */
+                            op->isOptional = false;
+                            op->code = code;
+                        }
+                    }
+                    else{
+
+                        op->code = code;
+                    }
+
+                    op++;
+                }
+
+                op->code = BLINK_OP_END;
+            }
+            else{
+
+                BLINK_ERROR("calloc()")
+                retval = false;
+            }
+        }
+
+        defPtr = nextDefinition(&iter);
+    }
+
+    return retval;
+}
+
+static uint8_t opcode(enum blink_type_tag type)
+{
+    static const uint8_t translate[] = {
+        BLINK_OP_STRING,        /* BLINK_TYPE_STRING */
+        BLINK_OP_STRING,        /* BLINK_TYPE_BINARY */
+        BLINK_OP_FIXED,         /* BLINK_TYPE_FIXED */
+        BLINK_OP_BOOL,          /* BLINK_TYPE_BOOL */
+        BLINK_OP_U8,            /* BLINK_TYPE_U8 */
+        BLINK_OP_U16,           /* BLINK_TYPE_U16 */
+        BLINK_OP_U32,           /* BLINK_TYPE_U32 */
+        BLINK_OP_U64,           /* BLINK_TYPE_U64 */
+        BLINK_OP_I8,            /* BLINK_TYPE_I8 */
+        BLINK_OP_I16,           /* BLINK_TYPE_I16 */
+        BLINK_OP_I32,           /* BLINK_TYPE_I32 */
+        BLINK_OP_I64,           /* BLINK_TYPE_I64 */
+        BLINK_OP_F64,           /* BLINK_TYPE_F64 */
+        BLINK_OP_I32,           /* BLINK_TYPE_DATE */
+        BLINK_OP_U32,           /* BLINK_TYPE_TIME_OF_DAY_MILLI */
+        BLINK_OP_U64,           /* BLINK_TYPE_TIME_OF_DAY_NANO */
+        BLINK_OP_I64,           /* BLINK_TYPE_NANO_TIME */
+        BLINK_OP_I64,           /* BLINK_TYPE_MILLI_TIME */
+        BLINK_OP_DECIMAL,       /* BLINK_TYPE_DECIMAL */
+        BLINK_OP_OBJECT,        /* BLINK_TYPE_OBJECT */
+        BLINK_OP_ENUM,          /* BLINK_TYPE_ENUM */
+        BLINK_OP_STATIC_GROUP,  /* BLINK_TYPE_STATIC_GROUP */
+        BLINK_OP_DYNAMIC_GROUP  /* BLINK_TYPE_DYNAMIC_GROUP */
+    };
+
+    BLINK_ASSERT((size_t)type < (sizeof(translate)/sizeof(*translate)))
+
+    return translate[type];
+}
+
+static bool isIntegerOp(uint8_t code)
+{
+    return (code >= BLINK_OP_U8) && (code <= BLINK_OP_I64);
+}
+
+static void initFieldDesc(struct blink_field_desc *desc, struct blink_schema *field)
+{
+    static const enum blink_type_tag translate[] = {
+        BLINK_TYPE_STRING,
+        BLINK_TYPE_BINARY,
+        BLINK_TYPE_FIXED,
+        BLINK_TYPE_BOOL,
+        BLINK_TYPE_U8,
+        BLINK_TYPE_U16,
+        BLINK_TYPE_U32,
+        BLINK_TYPE_U64,
+        BLINK_TYPE_I8,
+        BLINK_TYPE_I16,
+        BLINK_TYPE_I32,
+        BLINK_TYPE_I64,
+        BLINK_TYPE_F64,
+        BLINK_TYPE_DATE,              
+        BLINK_TYPE_TIME_OF_DAY_MILLI,
+        BLINK_TYPE_TIME_OF_DAY_NANO,
+        BLINK_TYPE_NANO_TIME,
+        BLINK_TYPE_MILLI_TIME,        
+        BLINK_TYPE_DECIMAL,
+        BLINK_TYPE_OBJECT            
+    };
+
+    const struct blink_schema_type *type = &castField(field)->type;
+    bool dynamic = false;
+    bool sequence = false;
+
+    desc->field = field;
+    desc->ref = NULL;
+    desc->size = 0U;
+    desc->isOptional = castField(field)->isOptional;
+
+    if(type->tag == BLINK_ITYPE_REF){
+
+        struct blink_schema *ptr = getTerminal(type->attr.resolved, &dynamic, &sequence);
+
+        BLINK_ASSERT(ptr != NULL)
+
+        switch(ptr->type){
+        case BLINK_SCHEMA_ENUM:
+            desc->type = BLINK_TYPE_ENUM;
+            desc->ref = ptr;
+            break;
+        case BLINK_SCHEMA_GROUP:
+            desc->type = (dynamic || type->isDynamic) ? BLINK_TYPE_DYNAMIC_GROUP : BLINK_TYPE_STATIC_GROUP;
+            desc->ref = ptr;
+            break;
+        default:
+            /* typedef of a primitive type */
+            sequence = sequence || type->isSequence;
+            type = &castTypeDef(ptr)->type;
+            break;
+        }
+    }
+
+    if(type->tag != BLINK_ITYPE_REF){
+
+        BLINK_ASSERT((size_t)type->tag < (sizeof(translate)/sizeof(*translate)))
+        desc->type = translate[type->tag];
+
+        switch(desc->type){
+        case BLINK_TYPE_BINARY:
+        case BLINK_TYPE_STRING:
+        case BLINK_TYPE_FIXED:
+            desc->size = type->attr.size;
+            break;
+        default:
+            break;
+        }
+    }
+
+    desc->isSequence = sequence || castField(field)->type.isSequence || type->isSequence;
+}
+
+static bool indexList(const struct blink_allocator *alloc, struct blink_schema_table *table, struct blink_schema *head)
+{
+    bool retval;
+    size_t numberOfElements = 0U;
+    struct blink_schema *ptr = head;
+
+    while(ptr != NULL){
+
+        numberOfElements++;
+        ptr = ptr->next;
+    }
+
+    retval = initTable(alloc, table, numberOfElements);
+
+    if(retval){
+
+        ptr = head;
+
+        while(ptr != NULL){
+
+            insertTable(table, ptr);
+            ptr = ptr->next;
+        }
+    }
+
+    return retval;
+}
+
+static bool initTable(const struct blink_allocator *alloc, struct blink_schema_table *table, size_t numberOfElements)
+{
+    bool retval = true;
+
+    table->slot = NULL;
+    table->size = 0U;
+
+    if(numberOfElements > 0U){
+
+        /* table is kept at most half full so that probe sequences stay short */
+        table->size = 1U;
+
+        while(table->size < (numberOfElements * 2U)){
+
+            table->size <<= 1;
+        }
+
+        table->slot = BLINK_Allocator_calloc(alloc, table->size, sizeof(*table->slot));
+
+        if(table->slot == NULL){
+
+            BLINK_ERROR("calloc()")
+            table->size = 0U;
+            retval = false;
+        }
+    }
+
+    return retval;
+}
+
+static void insertTable(struct blink_schema_table *table, struct blink_schema *element)
+{
+    BLINK_ASSERT(table->size > 0U)
+    BLINK_ASSERT(element->name != NULL)
+
+    size_t i;
+
+    element->hash = hashName(element->name, strlen(element->name));
+    i = (size_t)element->hash & (table->size - 1U);
+
+    while(table->slot[i] != NULL){
+
+        i = (i + 1U) & (table->size - 1U);
+    }
+
+    table->slot[i] = element;
+}
+
+static struct blink_schema *searchTable(const struct blink_schema_table *table, const char *name, size_t nameLen, uint32_t hash)
+{
+    struct blink_schema *retval = NULL;
+    size_t i;
+
+    if(table->size > 0U){
+
+        i = (size_t)hash & (table->size - 1U);
+
+        while(table->slot[i] != NULL){
+
+            if((table->slot[i]->hash == hash) && nameEquals(table->slot[i]->name, name, nameLen)){
+
+                retval = table->slot[i];
+                break;
+            }
+
+            i = (i + 1U) & (table->size - 1U);
+        }
+    }
+
+    return retval;
+}
+
+static uint32_t hashName(const char *name, size_t nameLen)
+{
+    /* FNV-1a */
+    uint32_t retval = 2166136261U;
+    size_t i;
+
+    for(i=0U; i < nameLen; i++){
+
+        retval ^= (uint32_t)((const uint8_t *)name)[i];
+        retval *= 16777619U;
+    }
+
+    return retval;
+}
+
+static bool nameEquals(const char *name, const char *other, size_t otherLen)
+{
+    return ((otherLen == 0U) || (strncmp(name, other, otherLen) == 0)) && (name[otherLen] == '\0');
+}
+
+static size_t hashID(uint64_t id, size_t mask)
+{
+    /* fibonacci hashing spreads sequential IDs across the table */
+    return (size_t)((id * 0x9e3779b97f4a7c15U) >> 32) & mask;
 }
 
 static bool testConstraints(struct blink_schema_base *self)
@@ -1948,31 +2476,26 @@ static bool testReferenceConstraint(struct blink_schema_base *self, struct blink
 
         while(true){
 
-            if(fast != NULL){
-            
-                if(fast->type.attr.resolved->type == BLINK_SCHEMA_TYPE_DEF){
+            /* fast pointer moves two steps for every step of the slow pointer */
+            if((fast != NULL) && isTypeDefRef(fast)){
 
-                    fast = castTypeDef(slow->type.attr.resolved);            
-                }
-                else{
-
-                    fast = NULL;
-                }
+                fast = castTypeDef(fast->type.attr.resolved);
             }
+            else{
 
-            if(fast != NULL){
+                fast = NULL;
+            }
 
-                if(fast->type.attr.resolved->type == BLINK_SCHEMA_TYPE_DEF){
+            if((fast != NULL) && isTypeDefRef(fast)){
 
-                    fast = castTypeDef(slow->type.attr.resolved);            
-                }
-                else{
+                fast = castTypeDef(fast->type.attr.resolved);
+            }
+            else{
 
-                    fast = NULL;
-                }
+                fast = NULL;
             }
 
-            if(slow->type.attr.resolved->type == BLINK_SCHEMA_TYPE_DEF){
+            if(isTypeDefRef(slow)){
 
                 if(slow->type.isDynamic){
 
@@ -2005,7 +2528,7 @@ static bool testReferenceConstraint(struct blink_schema_base *self, struct blink
             /* slow pointer resolved */
             else{
 
-                if(!errors && dynamic && (slow->super.type != BLINK_SCHEMA_GROUP)){
+                if(!errors && dynamic && ((slow->type.tag != BLINK_ITYPE_REF) || (slow->type.attr.resolved->type != BLINK_SCHEMA_GROUP))){
 
                     BLINK_ERROR("a dynamic reference must resolve to a group")
                     errors = true;
@@ -2138,7 +2661,7 @@ static struct blink_schema *newListElement(const struct blink_allocator *alloc,
 
         BLINK_ASSERT(type < sizeof(sizes)/sizeof(*sizes))
 
-        retval = (struct blink_schema *)alloc->calloc(1, sizes[type]);
+        retval = (struct blink_schema *)BLINK_Allocator_calloc(alloc, 1, sizes[type]);
         
         if(retval == NULL){
 
@@ -2178,7 +2701,7 @@ static struct blink_schema *searchListByName(struct blink_schema *head, const ch
 
         if(ptr->name != NULL){
 
-            if(strncmp(ptr->name, name, nameLen) == 0){
+            if(nameEquals(ptr->name, name, nameLen)){
 
                 retval = ptr;
                 break;
@@ -2254,6 +2777,12 @@ static struct blink_schema *getTerminal(struct blink_schema *element, bool *dyna
     return ptr;
 }
 
+/* true if type definition refers to another type definition */
+static bool isTypeDefRef(const struct blink_schema_type_def *self)
+{
+    return (self->type.tag == BLINK_ITYPE_REF) && (self->type.attr.resolved->type == BLINK_SCHEMA_TYPE_DEF);
+}
+
 static struct blink_group_iterator initDefinitionIterator(struct blink_schema *ns)
 {
     struct blink_group_iterator iter;
@@ -2370,9 +2899,10 @@ static struct blink_schema_base *castSchema(struct blink_schema *self)
 
 static const char *newString(const struct blink_allocator *alloc, const char *ptr, size_t len)
 {
-    char *retval = (char *)alloc->calloc((len+1U), 1);
+    char *retval = (char *)BLINK_Allocator_calloc(alloc, (len+1U), 1);
 
-    if(retval != NULL){
+    /* ptr may be NULL when len is zero */
+    if((retval != NULL) && (len > 0U)){
 
         (void)memcpy(retval, ptr, len);
     }
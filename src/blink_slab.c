@@ -0,0 +1,267 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+/* includes ***********************************************************/
+
+#include "blink_slab.h"
+#include "blink_debug.h"
+
+#include <string.h>
+
+/* defines ************************************************************/
+
+/* class recorded in the header of allocations passed through to the
+ * backing allocator */
+#define LARGE UINT32_MAX
+
+/* types **************************************************************/
+
+/* precedes every allocation
+ *
+ * The header is as large and as aligned as the most strictly aligned
+ * scalar type so that the memory following it is suitably aligned for
+ * anything (C99 has no max_align_t). */
+union chunk_header {
+    uint32_t sizeClass;     /**< index into chunkSize (or #LARGE) */
+    void *next;             /**< next free chunk (while on a free list) */
+    uint64_t align;
+    long double alignLong;
+    void (*alignFn)(void);
+};
+
+/* precedes every slab */
+union slab_header {
+    void *next;             /**< next slab */
+    union chunk_header align;
+};
+
+/* static variables ***************************************************/
+
+/* chunk sizes including the chunk header
+ *
+ * Every size is a multiple of 16 so that chunks carved from a slab
+ * keep the alignment of the chunk header. Classes are 16 bytes apart
+ * up to 256 bytes, which covers a group model and the field arrays of
+ * small groups. The larger classes in between the powers of two fit
+ * sequence element arrays at each doubling of capacity from 16 to 128
+ * elements. */
+static const uint32_t chunkSize[] = {
+    16U, 32U, 48U, 64U, 80U, 96U, 112U, 128U,
+    144U, 160U, 176U, 192U, 208U, 224U, 240U, 256U,
+    400U, 512U, 784U, 1024U, 1552U, 2048U, 3088U, 4096U
+};
+
+/* static function prototypes *****************************************/
+
+static uint32_t getClass(size_t size);
+static bool refill(blink_slab_t self, uint32_t sizeClass);
+static void *slabCalloc(void *ctx, size_t nelem, size_t elsize);
+static void slabFree(void *ctx, void *ptr);
+
+/* functions **********************************************************/
+
+blink_slab_t BLINK_Slab_init(struct blink_slab *self, const struct blink_allocator *backing)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(backing != NULL)
+    BLINK_ASSERT((sizeof(chunkSize)/sizeof(*chunkSize)) == BLINK_SLAB_NUM_CLASSES)
+
+    (void)memset(self, 0, sizeof(*self));
+
+    self->backing = *backing;
+
+    return self;
+}
+
+void *BLINK_Slab_calloc(blink_slab_t self, size_t nelem, size_t elsize)
+{
+    BLINK_ASSERT(self != NULL)
+
+    union chunk_header *chunk = NULL;
+    void *retval = NULL;
+
+    if((nelem > 0U) && (elsize > 0U)){
+
+        if(nelem > ((SIZE_MAX - sizeof(union chunk_header)) / elsize)){
+
+            BLINK_ERROR("allocation too large")
+        }
+        else{
+
+            size_t size = nelem * elsize;
+            uint32_t sizeClass = getClass(size + sizeof(union chunk_header));
+
+            if(sizeClass == LARGE){
+
+                chunk = BLINK_Allocator_calloc(&self->backing, 1U, size + sizeof(union chunk_header));
+            }
+            else if((self->freeList[sizeClass] != NULL) || refill(self, sizeClass)){
+
+                chunk = (union chunk_header *)self->freeList[sizeClass];
+                self->freeList[sizeClass] = chunk->next;
+
+                (void)memset(chunk, 0, chunkSize[sizeClass]);
+            }
+
+            if(chunk != NULL){
+
+                chunk->sizeClass = sizeClass;
+                retval = &chunk[1];
+            }
+            else{
+
+                BLINK_ERROR("calloc()")
+            }
+        }
+    }
+
+    return retval;
+}
+
+void BLINK_Slab_free(blink_slab_t self, void *ptr)
+{
+    BLINK_ASSERT(self != NULL)
+
+    if(ptr != NULL){
+
+        union chunk_header *chunk = &((union chunk_header *)ptr)[-1];
+
+        if(chunk->sizeClass == LARGE){
+
+            BLINK_Allocator_free(&self->backing, chunk);
+        }
+        else{
+
+            BLINK_ASSERT(chunk->sizeClass < BLINK_SLAB_NUM_CLASSES)
+
+            uint32_t sizeClass = chunk->sizeClass;
+
+            chunk->next = self->freeList[sizeClass];
+            self->freeList[sizeClass] = chunk;
+        }
+    }
+}
+
+void BLINK_Slab_destroy(blink_slab_t self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    union slab_header *slab = (union slab_header *)self->slabs;
+
+    while(slab != NULL){
+
+        union slab_header *next = (union slab_header *)slab->next;
+
+        BLINK_Allocator_free(&self->backing, slab);
+        slab = next;
+    }
+
+    self->slabs = NULL;
+    (void)memset(self->freeList, 0, sizeof(self->freeList));
+}
+
+struct blink_allocator BLINK_Slab_getAllocator(blink_slab_t self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    struct blink_allocator retval = {
+        .ctxCalloc = slabCalloc,
+        .ctxFree = slabFree,
+        .ctx = self
+    };
+
+    return retval;
+}
+
+/* static functions ***************************************************/
+
+static uint32_t getClass(size_t size)
+{
+    uint32_t retval = LARGE;
+    uint32_t i;
+
+    if(size <= 256U){
+
+        retval = (uint32_t)((size + 15U) / 16U) - 1U;
+    }
+    else{
+
+        for(i=16U; i < BLINK_SLAB_NUM_CLASSES; i++){
+
+            if(size <= chunkSize[i]){
+
+                retval = i;
+                break;
+            }
+        }
+    }
+
+    return retval;
+}
+
+/* carve a new slab into chunks of one size class */
+static bool refill(blink_slab_t self, uint32_t sizeClass)
+{
+    bool retval = false;
+    union slab_header *slab = NULL;
+    size_t n = (BLINK_SLAB_SIZE > sizeof(union slab_header)) ? ((BLINK_SLAB_SIZE - sizeof(union slab_header)) / chunkSize[sizeClass]) : 0U;
+
+    /* BLINK_SLAB_SIZE may be overridden smaller than the largest chunk */
+    if(n == 0U){
+
+        BLINK_ERROR("BLINK_SLAB_SIZE is too small for this size class")
+    }
+    else{
+
+        slab = BLINK_Allocator_calloc(&self->backing, 1U, BLINK_SLAB_SIZE);
+    }
+
+    if(slab != NULL){
+
+        uint8_t *base = (uint8_t *)&slab[1];
+
+        slab->next = self->slabs;
+        self->slabs = slab;
+
+        /* push in reverse so that chunks are handed out in address order */
+        while(n > 0U){
+
+            n--;
+            ((union chunk_header *)&base[n * chunkSize[sizeClass]])->next = self->freeList[sizeClass];
+            self->freeList[sizeClass] = &base[n * chunkSize[sizeClass]];
+        }
+
+        retval = true;
+    }
+
+    return retval;
+}
+
+static void *slabCalloc(void *ctx, size_t nelem, size_t elsize)
+{
+    return BLINK_Slab_calloc((blink_slab_t)ctx, nelem, elsize);
+}
+
+static void slabFree(void *ctx, void *ptr)
+{
+    BLINK_Slab_free((blink_slab_t)ctx, ptr);
+}
@@ -29,7 +29,7 @@
 
 /* static function prototypes *****************************************/
 
-static bool adjustOffset(int32_t *pos, int32_t max, int32_t offset);
+static bool adjustOffset(uint64_t *pos, uint64_t max, int64_t offset);
 
 /* functions **********************************************************/
 
@@ -40,41 +40,90 @@ bool BLINK_Stream_write(blink_stream_t self, const void *buf, size_t nbyte)
 
     bool retval = false;
 
-    if(nbyte <= (size_t)INT32_MAX){
+    switch(self->type){
+    case BLINK_STREAM_BUFFER:
+    
+        if(self->value.buffer.out != NULL){
+            if((self->value.buffer.max - self->value.buffer.pos) >= (uint64_t)nbyte){
+                
+                /* buf may be NULL when nbyte is zero */
+                if(nbyte > 0U){
 
-        switch(self->type){
-        case BLINK_STREAM_BUFFER:
-        
-            if(self->value.buffer.out != NULL){
-                if((self->value.buffer.max - self->value.buffer.pos) >= (uint32_t)nbyte){
-                    
                     (void)memcpy(&self->value.buffer.out[self->value.buffer.pos], buf, nbyte);
-                    self->value.buffer.pos += (uint32_t)nbyte;
-                    retval = true;
                 }
+
+                self->value.buffer.pos += (uint64_t)nbyte;
+                retval = true;
             }
-            break;
-            
-        case BLINK_STREAM_USER:
+        }
+        break;
+        
+    case BLINK_STREAM_USER:
+
+        if(self->value.user.fn.write != NULL){
 
-            if(self->value.user.fn.write != NULL){
+            retval = self->value.user.fn.write(self->value.user.state, buf, nbyte);
+        }
+        break;
+
+    case BLINK_STREAM_BOUNDED:
+
+        if((self->value.bounded.max - self->value.bounded.pos) >= (uint64_t)nbyte){
+
+            retval = BLINK_Stream_write(self->value.bounded.stream, buf, nbyte);
 
-                retval = self->value.user.fn.write(self->value.user.state, buf, nbyte);
+            if(retval){
+
+                self->value.bounded.pos += (uint64_t)nbyte;
             }
-            break;
+        }
+        break;
+    
+    default:
+        /* no action */
+        break;
+    }
+
+    return retval;
+}
+
+bool BLINK_Stream_writeRef(blink_stream_t self, const void *buf, size_t nbyte)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT((nbyte == 0U) || (buf != NULL))
+
+    bool retval = false;
+
+    switch(self->type){
+    case BLINK_STREAM_USER:
+
+        if(self->value.user.fn.writeRef != NULL){
+
+            retval = self->value.user.fn.writeRef(self->value.user.state, buf, nbyte);
+        }
+        else{
+
+            retval = BLINK_Stream_write(self, buf, nbyte);
+        }
+        break;
+
+    case BLINK_STREAM_BOUNDED:
+
+        if((self->value.bounded.max - self->value.bounded.pos) >= (uint64_t)nbyte){
 
-        case BLINK_STREAM_BOUNDED:
+            retval = BLINK_Stream_writeRef(self->value.bounded.stream, buf, nbyte);
 
-            if((self->value.bounded.max - self->value.bounded.pos) >= (uint32_t)nbyte){
+            if(retval){
 
-                retval = BLINK_Stream_write(self->value.bounded.stream, buf, nbyte);
+                self->value.bounded.pos += (uint64_t)nbyte;
             }
-            break;
-        
-        default:
-            /* no action */
-            break;
         }
+        break;
+
+    default:
+
+        retval = BLINK_Stream_write(self, buf, nbyte);
+        break;
     }
 
     return retval;
@@ -87,50 +136,52 @@ bool BLINK_Stream_read(blink_stream_t self, void *buf, size_t nbyte)
 
     bool retval = false;
 
-    if(nbyte <= (size_t)INT32_MAX){
+    switch(self->type){
+    case BLINK_STREAM_BUFFER:
+    
+        if(self->value.buffer.in != NULL){
+            if((self->value.buffer.max - self->value.buffer.pos) >= (uint64_t)nbyte){
+                
+                /* buf may be NULL when nbyte is zero */
+                if(nbyte > 0U){
 
-        switch(self->type){
-        case BLINK_STREAM_BUFFER:
-        
-            if(self->value.buffer.in != NULL){
-                if((self->value.buffer.max - self->value.buffer.pos) >= (uint32_t)nbyte){
-                    
                     (void)memcpy(buf, &self->value.buffer.in[self->value.buffer.pos], nbyte);
-                    self->value.buffer.pos += (uint32_t)nbyte;
-                    retval = true;
                 }
-                else{
 
-                    self->value.buffer.eof = true;
-                }         
+                self->value.buffer.pos += (uint64_t)nbyte;
+                retval = true;
             }
-            break;
+            else{
 
-        case BLINK_STREAM_USER:
+                self->value.buffer.eof = true;
+            }         
+        }
+        break;
 
-            if(self->value.user.fn.read != NULL){
+    case BLINK_STREAM_USER:
 
-                retval = self->value.user.fn.read(self->value.user.state, buf, nbyte);
-            }
-            break;
+        if(self->value.user.fn.read != NULL){
 
-        case BLINK_STREAM_BOUNDED:
+            retval = self->value.user.fn.read(self->value.user.state, buf, nbyte);
+        }
+        break;
 
-            if((self->value.bounded.max - self->value.bounded.pos) >= (uint32_t)nbyte){
+    case BLINK_STREAM_BOUNDED:
 
-                self->value.bounded.pos += (uint32_t)nbyte;
-                retval = BLINK_Stream_read(self->value.bounded.stream, buf, nbyte);
-            }
-            else{
+        if((self->value.bounded.max - self->value.bounded.pos) >= (uint64_t)nbyte){
 
-                self->value.bounded.eof = true;
-            }
-            break;
-    
-        default:
-            /* no action */
-            break;
+            self->value.bounded.pos += (uint64_t)nbyte;
+            retval = BLINK_Stream_read(self->value.bounded.stream, buf, nbyte);
         }
+        else{
+
+            self->value.bounded.eof = true;
+        }
+        break;
+
+    default:
+        /* no action */
+        break;
     }
 
     return retval;
@@ -173,45 +224,159 @@ bool BLINK_Stream_peek(blink_stream_t self, void *buf)
     return retval;
 }
 
-blink_stream_t BLINK_Stream_initBufferReadOnly(struct blink_stream *self, const void *buf, uint32_t max)
+const uint8_t *BLINK_Stream_borrow(blink_stream_t self, size_t nbyte)
 {
     BLINK_ASSERT(self != NULL)
-    BLINK_ASSERT((max == 0) || (buf != NULL))
 
-    blink_stream_t retval = NULL;
+    const uint8_t *retval = NULL;
+
+    switch(self->type){
+    case BLINK_STREAM_BUFFER:
+
+        if(self->value.buffer.in != NULL){
+            if((self->value.buffer.max - self->value.buffer.pos) >= (uint64_t)nbyte){
+
+                retval = &self->value.buffer.in[self->value.buffer.pos];
+                self->value.buffer.pos += (uint64_t)nbyte;
+            }
+            else{
+
+                self->value.buffer.eof = true;
+            }
+        }
+        break;
+
+    case BLINK_STREAM_BOUNDED:
+
+        if((self->value.bounded.max - self->value.bounded.pos) >= (uint64_t)nbyte){
+
+            retval = BLINK_Stream_borrow(self->value.bounded.stream, nbyte);
 
-    if(max <= (size_t)INT32_MAX){
+            if(retval != NULL){
 
-        (void)memset(self, 0, sizeof(*self));
-        self->type = BLINK_STREAM_BUFFER;
-        self->value.buffer.in = (const uint8_t *)buf;        
-        self->value.buffer.max = max;
-        retval = (blink_stream_t)self;
+                self->value.bounded.pos += (uint64_t)nbyte;
+            }
+        }
+        else{
+
+            self->value.bounded.eof = true;
+        }
+        break;
+
+    default:
+        /* no action */
+        break;
     }
 
     return retval;
 }
 
-blink_stream_t BLINK_Stream_initBuffer(struct blink_stream *self, void *buf, uint32_t max)
+bool BLINK_Stream_canBorrow(blink_stream_t self)
 {
     BLINK_ASSERT(self != NULL)
-    BLINK_ASSERT((max == 0) || (buf != NULL))
 
-    blink_stream_t retval = NULL;
+    bool retval = false;
+
+    switch(self->type){
+    case BLINK_STREAM_BUFFER:
+        retval = (self->value.buffer.in != NULL);
+        break;
+    case BLINK_STREAM_BOUNDED:
+        retval = (self->value.bounded.stream != NULL) && BLINK_Stream_canBorrow(self->value.bounded.stream);
+        break;
+    default:
+        /* no action */
+        break;
+    }
+
+    return retval;
+}
+
+uint8_t *BLINK_Stream_reserve(blink_stream_t self, size_t nbyte)
+{
+    BLINK_ASSERT(self != NULL)
+
+    uint8_t *retval = NULL;
+
+    switch(self->type){
+    case BLINK_STREAM_BUFFER:
+
+        if(self->value.buffer.out != NULL){
+            if((self->value.buffer.max - self->value.buffer.pos) >= (uint64_t)nbyte){
+
+                retval = &self->value.buffer.out[self->value.buffer.pos];
+                self->value.buffer.pos += (uint64_t)nbyte;
+            }
+        }
+        break;
+
+    case BLINK_STREAM_BOUNDED:
+
+        if((self->value.bounded.max - self->value.bounded.pos) >= (uint64_t)nbyte){
 
-    if(max <= (uint32_t)INT32_MAX){
+            retval = BLINK_Stream_reserve(self->value.bounded.stream, nbyte);
+
+            if(retval != NULL){
+
+                self->value.bounded.pos += (uint64_t)nbyte;
+            }
+        }
+        break;
 
-        (void)memset(self, 0, sizeof(*self));
-        self->type = BLINK_STREAM_BUFFER;
-        self->value.buffer.out = buf;
-        self->value.buffer.in = (uint8_t *)buf;
-        self->value.buffer.max = max;
-        retval = (blink_stream_t)self;
+    default:
+        /* no action */
+        break;
     }
 
     return retval;
 }
 
+bool BLINK_Stream_canReserve(blink_stream_t self)
+{
+    BLINK_ASSERT(self != NULL)
+
+    bool retval = false;
+
+    switch(self->type){
+    case BLINK_STREAM_BUFFER:
+        retval = (self->value.buffer.out != NULL);
+        break;
+    case BLINK_STREAM_BOUNDED:
+        retval = (self->value.bounded.stream != NULL) && BLINK_Stream_canReserve(self->value.bounded.stream);
+        break;
+    default:
+        /* no action */
+        break;
+    }
+
+    return retval;
+}
+
+blink_stream_t BLINK_Stream_initBufferReadOnly(struct blink_stream *self, const void *buf, uint64_t max)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT((max == 0) || (buf != NULL))
+
+    (void)memset(self, 0, sizeof(*self));
+    self->type = BLINK_STREAM_BUFFER;
+    self->value.buffer.in = (const uint8_t *)buf;        
+    self->value.buffer.max = max;
+    return (blink_stream_t)self;
+}
+
+blink_stream_t BLINK_Stream_initBuffer(struct blink_stream *self, void *buf, uint64_t max)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT((max == 0) || (buf != NULL))
+
+    (void)memset(self, 0, sizeof(*self));
+    self->type = BLINK_STREAM_BUFFER;
+    self->value.buffer.out = buf;
+    self->value.buffer.in = (uint8_t *)buf;
+    self->value.buffer.max = max;
+    return (blink_stream_t)self;
+}
+
 blink_stream_t BLINK_Stream_initUser(struct blink_stream *self, void *state,  struct blink_stream_user fn)
 {
     BLINK_ASSERT(self != NULL)
@@ -223,7 +388,7 @@ blink_stream_t BLINK_Stream_initUser(struct blink_stream *self, void *state,  st
     return (blink_stream_t)self;
 }
 
-blink_stream_t BLINK_Stream_initBounded(struct blink_stream *self, blink_stream_t stream, uint32_t max)
+blink_stream_t BLINK_Stream_initBounded(struct blink_stream *self, blink_stream_t stream, uint64_t max)
 {
     BLINK_ASSERT(self != NULL)
 
@@ -234,16 +399,16 @@ blink_stream_t BLINK_Stream_initBounded(struct blink_stream *self, blink_stream_
     return (blink_stream_t)self;
 }
 
-uint32_t BLINK_Stream_tell(blink_stream_t self)
+uint64_t BLINK_Stream_tell(blink_stream_t self)
 {
     BLINK_ASSERT(self != NULL)
 
-    uint32_t retval = 0U;
+    uint64_t retval = 0U;
 
     switch(self->type){
     case BLINK_STREAM_BUFFER:
     
-        retval = (uint32_t)self->value.buffer.pos;
+        retval = self->value.buffer.pos;
         break;
 
     case BLINK_STREAM_USER:
@@ -256,7 +421,7 @@ uint32_t BLINK_Stream_tell(blink_stream_t self)
 
     case BLINK_STREAM_BOUNDED:
 
-        retval = (uint32_t)self->value.bounded.pos;
+        retval = self->value.bounded.pos;
         break;
         
     default:
@@ -267,39 +432,36 @@ uint32_t BLINK_Stream_tell(blink_stream_t self)
     return retval;
 }
 
-bool BLINK_Stream_seekSet(blink_stream_t self, uint32_t offset)
+bool BLINK_Stream_seekSet(blink_stream_t self, uint64_t offset)
 {
     BLINK_ASSERT(self != NULL)
 
     bool retval = false;
 
-    if(offset < (uint32_t)INT32_MAX){
-
-        switch(self->type){
-        case BLINK_STREAM_BUFFER:
-            if(self->value.buffer.max >= offset){
+    switch(self->type){
+    case BLINK_STREAM_BUFFER:
+        if(self->value.buffer.max >= offset){
 
-                self->value.buffer.pos = offset;
-                retval = true;
-            }    
-            break;
-        case BLINK_STREAM_USER:
-            if(self->value.user.fn.seekSet != NULL){
+            self->value.buffer.pos = offset;
+            retval = true;
+        }    
+        break;
+    case BLINK_STREAM_USER:
+        if(self->value.user.fn.seekSet != NULL){
 
-                retval = self->value.user.fn.seekSet(self->value.user.state, offset);
-            }
-            break;
-        default:
-            /* no action */
-            BLINK_ERROR("this stream cannot seek")
-            break;
+            retval = self->value.user.fn.seekSet(self->value.user.state, offset);
         }
+        break;
+    default:
+        /* no action */
+        BLINK_ERROR("this stream cannot seek")
+        break;
     }
 
     return retval;
 }
 
-bool BLINK_Stream_seekCur(blink_stream_t self, int32_t offset)
+bool BLINK_Stream_seekCur(blink_stream_t self, int64_t offset)
 {
     BLINK_ASSERT(self != NULL)
     
@@ -307,7 +469,7 @@ bool BLINK_Stream_seekCur(blink_stream_t self, int32_t offset)
     
     switch(self->type){
     case BLINK_STREAM_BUFFER:
-        retval = adjustOffset((int32_t *)&self->value.buffer.pos, (int32_t)self->value.buffer.max, offset);
+        retval = adjustOffset(&self->value.buffer.pos, self->value.buffer.max, offset);
         break;
     case BLINK_STREAM_USER:
         if(self->value.user.fn.seekCur != NULL){
@@ -351,7 +513,7 @@ bool BLINK_Stream_eof(blink_stream_t self)
     return retval;
 }
 
-bool BLINK_Stream_setMax(blink_stream_t self, uint32_t offset)
+bool BLINK_Stream_setMax(blink_stream_t self, uint64_t offset)
 {
     BLINK_ASSERT(self != NULL)
     
@@ -373,11 +535,11 @@ bool BLINK_Stream_setMax(blink_stream_t self, uint32_t offset)
     return retval;
 }
 
-uint32_t BLINK_Stream_max(blink_stream_t self)
+uint64_t BLINK_Stream_max(blink_stream_t self)
 {
     BLINK_ASSERT(self != NULL)
     
-    uint32_t retval = 0U;
+    uint64_t retval = 0U;
     
     switch(self->type){
     case BLINK_STREAM_BOUNDED:
@@ -396,23 +558,26 @@ uint32_t BLINK_Stream_max(blink_stream_t self)
 
 /* static functions ***************************************************/
 
-static bool adjustOffset(int32_t *pos, int32_t max, int32_t offset)
+static bool adjustOffset(uint64_t *pos, uint64_t max, int64_t offset)
 {
     bool retval = false;
 
     if(offset > 0){
 
-        if(((*pos + offset) > *pos) && ((*pos + offset) <= max)){
+        if((max - *pos) >= (uint64_t)offset){
 
-            *pos += offset;
+            *pos += (uint64_t)offset;
             retval = true;
         }
     }
-    else if(offset > 0){
+    else if(offset < 0){
+
+        /* negate without overflowing INT64_MIN */
+        uint64_t back = (uint64_t)(-(offset + 1)) + 1U;
     
-        if((*pos - offset) < *pos){
+        if(*pos >= back){
 
-            *pos -= offset;
+            *pos -= back;
             retval = true;
         }
     }
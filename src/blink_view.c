@@ -0,0 +1,333 @@
+/* Copyright (c) 2016 Cameron Harper
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 
+ * */
+
+/* includes ***********************************************************/
+
+#include "blink_view.h"
+#include "blink_compact.h"
+#include "blink_debug.h"
+
+#include <string.h>
+
+/* static function prototypes *****************************************/
+
+static const struct blink_field_desc *locate(struct blink_view *self, blink_schema_t field, struct blink_stream *value);
+
+/* functions **********************************************************/
+
+bool BLINK_View_init(struct blink_view *self, blink_schema_t schema, const void *in, size_t len)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(schema != NULL)
+    BLINK_ASSERT((len == 0U) || (in != NULL))
+
+    bool retval = false;
+    struct blink_stream stream;
+    uint32_t size;
+    uint64_t id;
+    bool isNull;
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, in, len);
+
+    if(BLINK_Compact_decodeU32(&stream, &size, &isNull) && !isNull){
+
+        if((len - (size_t)BLINK_Stream_tell(&stream)) >= (size_t)size){
+
+            /* the view never reads beyond this message */
+            (void)BLINK_Stream_initBufferReadOnly(&self->stream, in, BLINK_Stream_tell(&stream) + size);
+            (void)BLINK_Stream_seekSet(&self->stream, BLINK_Stream_tell(&stream));
+
+            if(BLINK_Compact_decodeU64(&self->stream, &id, &isNull) && !isNull){
+
+                self->group = BLINK_Schema_getGroupByID(schema, id);
+
+                if(self->group != NULL){
+
+                    if(BLINK_Group_numberOfFields(self->group) <= BLINK_VIEW_MAX_FIELDS){
+
+                        self->desc = BLINK_Group_getFieldDescs(self->group);
+                        self->in = (const uint8_t *)in;
+                        self->numberOfFields = (uint32_t)BLINK_Group_numberOfFields(self->group);
+                        self->located = 0U;
+                        self->offset[0] = (uint32_t)BLINK_Stream_tell(&self->stream);
+
+                        retval = true;
+                    }
+                    else{
+
+                        BLINK_ERROR("group has more than BLINK_VIEW_MAX_FIELDS fields")
+                    }
+                }
+                else{
+
+                    BLINK_ERROR("W1: unknown group ID")
+                }
+            }
+        }
+        else{
+
+            BLINK_ERROR("S1: group ended prematurely")
+        }
+    }
+
+    return retval;
+}
+
+bool BLINK_View_fieldIsNullByField(struct blink_view *self, blink_schema_t field, bool *isNull)
+{
+    BLINK_ASSERT(isNull != NULL)
+
+    struct blink_stream value;
+    const struct blink_field_desc *desc = locate(self, field, &value);
+    uint8_t first;
+
+    if(desc != NULL){
+
+        /* every optional form starts with 0xc0 when null */
+        *isNull = desc->isOptional && BLINK_Stream_peek(&value, &first) && (first == 0xc0U);
+    }
+
+    return (desc != NULL);
+}
+
+bool BLINK_View_getUintByField(struct blink_view *self, blink_schema_t field, uint64_t *value, bool *isNull)
+{
+    BLINK_ASSERT(value != NULL)
+
+    bool retval = false;
+    struct blink_stream in;
+    const struct blink_field_desc *desc = locate(self, field, &in);
+    uint8_t u8;
+    uint16_t u16;
+    uint32_t u32;
+
+    if((desc != NULL) && !desc->isSequence){
+
+        switch(desc->type){
+        case BLINK_TYPE_U8:
+            retval = BLINK_Compact_decodeU8(&in, &u8, isNull);
+            if(retval && !*isNull){
+
+                *value = u8;
+            }
+            break;
+        case BLINK_TYPE_U16:
+            retval = BLINK_Compact_decodeU16(&in, &u16, isNull);
+            if(retval && !*isNull){
+
+                *value = u16;
+            }
+            break;
+        case BLINK_TYPE_U32:
+        case BLINK_TYPE_TIME_OF_DAY_MILLI:
+            retval = BLINK_Compact_decodeU32(&in, &u32, isNull);
+            if(retval && !*isNull){
+
+                *value = u32;
+            }
+            break;
+        case BLINK_TYPE_U64:
+        case BLINK_TYPE_TIME_OF_DAY_NANO:
+            retval = BLINK_Compact_decodeU64(&in, value, isNull);
+            break;
+        default:
+            /* no action */
+            break;
+        }
+    }
+
+    return retval;
+}
+
+bool BLINK_View_getIntByField(struct blink_view *self, blink_schema_t field, int64_t *value, bool *isNull)
+{
+    BLINK_ASSERT(value != NULL)
+
+    bool retval = false;
+    struct blink_stream in;
+    const struct blink_field_desc *desc = locate(self, field, &in);
+    int8_t i8;
+    int16_t i16;
+    int32_t i32;
+
+    if((desc != NULL) && !desc->isSequence){
+
+        switch(desc->type){
+        case BLINK_TYPE_I8:
+            retval = BLINK_Compact_decodeI8(&in, &i8, isNull);
+            if(retval && !*isNull){
+
+                *value = i8;
+            }
+            break;
+        case BLINK_TYPE_I16:
+            retval = BLINK_Compact_decodeI16(&in, &i16, isNull);
+            if(retval && !*isNull){
+
+                *value = i16;
+            }
+            break;
+        case BLINK_TYPE_I32:
+        case BLINK_TYPE_DATE:
+        case BLINK_TYPE_ENUM:
+            retval = BLINK_Compact_decodeI32(&in, &i32, isNull);
+            if(retval && !*isNull){
+
+                *value = i32;
+            }
+            break;
+        case BLINK_TYPE_I64:
+        case BLINK_TYPE_NANO_TIME:
+        case BLINK_TYPE_MILLI_TIME:
+            retval = BLINK_Compact_decodeI64(&in, value, isNull);
+            break;
+        default:
+            /* no action */
+            break;
+        }
+    }
+
+    return retval;
+}
+
+bool BLINK_View_getBoolByField(struct blink_view *self, blink_schema_t field, bool *value, bool *isNull)
+{
+    struct blink_stream in;
+    const struct blink_field_desc *desc = locate(self, field, &in);
+
+    return (desc != NULL) && !desc->isSequence && (desc->type == BLINK_TYPE_BOOL) && BLINK_Compact_decodeBool(&in, value, isNull);
+}
+
+bool BLINK_View_getF64ByField(struct blink_view *self, blink_schema_t field, double *value, bool *isNull)
+{
+    struct blink_stream in;
+    const struct blink_field_desc *desc = locate(self, field, &in);
+
+    return (desc != NULL) && !desc->isSequence && (desc->type == BLINK_TYPE_F64) && BLINK_Compact_decodeF64(&in, value, isNull);
+}
+
+bool BLINK_View_getDecimalByField(struct blink_view *self, blink_schema_t field, int64_t *mantissa, int8_t *exponent, bool *isNull)
+{
+    struct blink_stream in;
+    const struct blink_field_desc *desc = locate(self, field, &in);
+
+    return (desc != NULL) && !desc->isSequence && (desc->type == BLINK_TYPE_DECIMAL) && BLINK_Compact_decodeDecimal(&in, mantissa, exponent, isNull);
+}
+
+bool BLINK_View_getStringByField(struct blink_view *self, blink_schema_t field, const uint8_t **data, uint32_t *len, bool *isNull)
+{
+    BLINK_ASSERT(data != NULL)
+    BLINK_ASSERT(len != NULL)
+    BLINK_ASSERT(isNull != NULL)
+
+    bool retval = false;
+    struct blink_stream in;
+    const struct blink_field_desc *desc = locate(self, field, &in);
+    bool isPresent = true;
+
+    if((desc != NULL) && !desc->isSequence){
+
+        switch(desc->type){
+        case BLINK_TYPE_STRING:
+        case BLINK_TYPE_BINARY:
+            retval = BLINK_Compact_decodeU32(&in, len, isNull);
+            break;
+        case BLINK_TYPE_FIXED:
+            retval = !desc->isOptional || BLINK_Compact_decodePresent(&in, &isPresent);
+            *isNull = !isPresent;
+            *len = desc->size;
+            break;
+        default:
+            /* no action */
+            break;
+        }
+
+        if(retval && !*isNull){
+
+            *data = BLINK_Stream_borrow(&in, *len);
+            retval = (*data != NULL);
+        }
+    }
+
+    return retval;
+}
+
+bool BLINK_View_getEncodedByField(struct blink_view *self, blink_schema_t field, const uint8_t **data, size_t *len)
+{
+    BLINK_ASSERT(data != NULL)
+    BLINK_ASSERT(len != NULL)
+
+    struct blink_stream in;
+    const struct blink_field_desc *desc = locate(self, field, &in);
+
+    if(desc != NULL){
+
+        *len = (size_t)BLINK_Stream_max(&in);
+        *data = BLINK_Stream_borrow(&in, *len);
+    }
+
+    return (desc != NULL);
+}
+
+/* static functions ***************************************************/
+
+/* locate field and init `value` as a stream over its encoded form */
+static const struct blink_field_desc *locate(struct blink_view *self, blink_schema_t field, struct blink_stream *value)
+{
+    BLINK_ASSERT(self != NULL)
+    BLINK_ASSERT(field != NULL)
+
+    const struct blink_field_desc *retval = NULL;
+    uint32_t index = BLINK_Field_getIndex(field);
+    bool ok = true;
+
+    if((index < self->numberOfFields) && (self->desc[index].field == field)){
+
+        /* skip fields up to and including this one, recording where each ends */
+        while(ok && (self->located <= index)){
+
+            ok = BLINK_Compact_skipField(&self->stream, &self->desc[self->located]);
+
+            if(ok){
+
+                self->located++;
+                self->offset[self->located] = (uint32_t)BLINK_Stream_tell(&self->stream);
+            }
+            else{
+
+                (void)BLINK_Stream_seekSet(&self->stream, self->offset[self->located]);
+            }
+        }
+
+        if(ok){
+
+            (void)BLINK_Stream_initBufferReadOnly(value, &self->in[self->offset[index]], self->offset[index + 1U] - self->offset[index]);
+            retval = &self->desc[index];
+        }
+    }
+    else{
+
+        BLINK_ERROR("field is not in this group")
+    }
+
+    return retval;
+}
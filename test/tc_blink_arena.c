@@ -0,0 +1,161 @@
+/**
+ * @example tc_blink_arena.c
+ *
+ * */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+#include "blink_arena.h"
+#include "blink_schema.h"
+#include "blink_stream.h"
+#include "blink_object.h"
+#include <string.h>
+
+#include <malloc.h>
+
+static struct blink_allocator backing = {
+    .calloc = calloc,
+    .free = free
+};
+
+static int setup_arena(void **user)
+{
+    static uint64_t heap[16U];
+    static struct blink_arena arena;
+    *user = (blink_arena_t)BLINK_Arena_init(&arena, (uint8_t *)heap, sizeof(heap), NULL);
+    return 0;
+}
+
+static int setup_chained(void **user)
+{
+    static struct blink_arena arena;
+    *user = (blink_arena_t)BLINK_Arena_init(&arena, NULL, 0U, &backing);
+    return 0;
+}
+
+static int teardown_arena(void **user)
+{
+    BLINK_Arena_destroy((blink_arena_t)(*user));
+    return 0;
+}
+
+static void test_BLINK_Arena_calloc_zeroSize(void **user)
+{
+    assert_true(BLINK_Arena_calloc((blink_arena_t)(*user), 0U, 1U) == NULL);
+    assert_true(BLINK_Arena_calloc((blink_arena_t)(*user), 1U, 0U) == NULL);
+}
+
+static void test_BLINK_Arena_calloc_all(void **user)
+{
+    uint8_t *first = (uint8_t *)BLINK_Arena_calloc((blink_arena_t)(*user), 16U, sizeof(uint64_t));
+    uint8_t *second = (uint8_t *)BLINK_Arena_calloc((blink_arena_t)(*user), 1U, 1U);
+
+    assert_true(first != NULL);
+    assert_true(second == NULL);
+    assert_int_equal(0U, BLINK_Arena_getFreeSpace((blink_arena_t)(*user)));
+}
+
+static void test_BLINK_Arena_calloc_multi(void **user)
+{
+    uint8_t *first = (uint8_t *)BLINK_Arena_calloc((blink_arena_t)(*user), 1U, 1U);
+    uint8_t *second = (uint8_t *)BLINK_Arena_calloc((blink_arena_t)(*user), 3U, 1U);
+
+    assert_true(first != NULL);
+    assert_true(second != NULL);
+    assert_true(((size_t)first % BLINK_ARENA_ALIGN) == 0U);
+    assert_true(((size_t)second % BLINK_ARENA_ALIGN) == 0U);
+    assert_ptr_not_equal(first, second);
+}
+
+static void test_BLINK_Arena_rewind(void **user)
+{
+    uint8_t *first = (uint8_t *)BLINK_Arena_calloc((blink_arena_t)(*user), 1U, 8U);
+    struct blink_arena_mark mark = BLINK_Arena_mark((blink_arena_t)(*user));
+    uint8_t *second = (uint8_t *)BLINK_Arena_calloc((blink_arena_t)(*user), 1U, 8U);
+
+    assert_true(first != NULL);
+    assert_true(second != NULL);
+
+    second[0] = 0xaaU;
+
+    BLINK_Arena_rewind((blink_arena_t)(*user), mark);
+
+    /* same memory is returned and is zeroed again */
+    assert_ptr_equal(second, BLINK_Arena_calloc((blink_arena_t)(*user), 1U, 8U));
+    assert_int_equal(0U, second[0]);
+
+    BLINK_Arena_reset((blink_arena_t)(*user));
+
+    assert_ptr_equal(first, BLINK_Arena_calloc((blink_arena_t)(*user), 1U, 8U));
+}
+
+static void test_BLINK_Arena_calloc_chained(void **user)
+{
+    uint8_t *first = (uint8_t *)BLINK_Arena_calloc((blink_arena_t)(*user), 1U, BLINK_ARENA_BLOCK_SIZE);
+    uint8_t *second = (uint8_t *)BLINK_Arena_calloc((blink_arena_t)(*user), 1U, 8U);
+    uint8_t *large = (uint8_t *)BLINK_Arena_calloc((blink_arena_t)(*user), 4U, BLINK_ARENA_BLOCK_SIZE);
+
+    assert_true(first != NULL);
+    assert_true(second != NULL);
+    assert_true(large != NULL);
+
+    /* chained blocks are reused after a reset */
+    BLINK_Arena_reset((blink_arena_t)(*user));
+
+    assert_ptr_equal(first, BLINK_Arena_calloc((blink_arena_t)(*user), 1U, BLINK_ARENA_BLOCK_SIZE));
+    assert_ptr_equal(second, BLINK_Arena_calloc((blink_arena_t)(*user), 1U, 8U));
+}
+
+static void test_BLINK_Arena_getAllocator(void **user)
+{
+    static const char syntax[] =
+        "InsertOrder/1 ->\n"
+        "   string Symbol,\n"
+        "   u32 [] Prices\n";
+    static const uint8_t input[] = {0x09, 0x01, 0x03, 'I', 'B', 'M', 0x03, 0x01, 0x02, 0x03};
+
+    struct blink_allocator alloc = BLINK_Arena_getAllocator((blink_arena_t)(*user));
+    struct blink_stream stream;
+    blink_schema_t schema;
+    blink_object_t obj;
+    struct blink_arena messages;
+    struct blink_allocator messageAlloc;
+    int i;
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)syntax, sizeof(syntax));
+    schema = BLINK_Schema_new(&alloc, &stream);
+    assert_true(schema != NULL);
+
+    (void)BLINK_Arena_init(&messages, NULL, 0U, &backing);
+    messageAlloc = BLINK_Arena_getAllocator(&messages);
+
+    for(i=0; i < 3; i++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, input, sizeof(input));
+        obj = BLINK_Object_decodeCompact(&stream, schema, &messageAlloc);
+
+        assert_true(obj != NULL);
+        assert_int_equal(3U, BLINK_Object_getSequenceSizeByField(obj, BLINK_Group_getFieldByName(BLINK_Schema_getGroupByName(schema, "InsertOrder"), "Prices")));
+
+        /* discard message */
+        BLINK_Arena_reset(&messages);
+    }
+
+    BLINK_Arena_destroy(&messages);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_BLINK_Arena_calloc_zeroSize, setup_arena),
+        cmocka_unit_test_setup(test_BLINK_Arena_calloc_all, setup_arena),
+        cmocka_unit_test_setup(test_BLINK_Arena_calloc_multi, setup_arena),
+        cmocka_unit_test_setup(test_BLINK_Arena_rewind, setup_arena),
+        cmocka_unit_test_setup_teardown(test_BLINK_Arena_calloc_chained, setup_chained, teardown_arena),
+        cmocka_unit_test_setup_teardown(test_BLINK_Arena_getAllocator, setup_chained, teardown_arena),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -360,6 +360,105 @@ static void test_BLINK_Compact_Decimal_nullMantissa(void **user)
     assert_int_equal(0, BLINK_Compact_decodeDecimal(s, &mantissa, &exponent, &isNull));        
 }
 
+static void test_BLINK_Compact_decodeU32_bounded(void **user)
+{
+    static const uint8_t in[] = {0xC2, 0xE8, 0x03, 0x7D};
+    struct blink_stream stream;
+    struct blink_stream bounded;
+    uint32_t out;
+    bool isNull = true;
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, in, sizeof(in));
+    (void)BLINK_Stream_initBounded(&bounded, &stream, 3U);
+
+    assert_true(BLINK_Compact_decodeU32(&bounded, &out, &isNull));
+    assert_int_equal(1000U, out);
+    assert_false(isNull);
+    assert_int_equal(3U, BLINK_Stream_tell(&bounded));
+    assert_int_equal(3U, BLINK_Stream_tell(&stream));
+
+    /* next VLC is outside the bound */
+    assert_false(BLINK_Compact_decodeU32(&bounded, &out, &isNull));
+    assert_true(BLINK_Stream_eof(&bounded));
+}
+
+static void test_BLINK_Compact_decodeU32_truncated(void **user)
+{
+    static const uint8_t in[] = {0xC2, 0xE8};
+    struct blink_stream stream;
+    uint32_t out;
+    bool isNull;
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, in, sizeof(in));
+
+    assert_false(BLINK_Compact_decodeU32(&stream, &out, &isNull));
+    assert_true(BLINK_Stream_eof(&stream));
+}
+
+static void test_BLINK_Compact_decodeI64_wide(void **user)
+{
+    /* values of every encoded size followed by padding so they are read with a wide load */
+    static const int64_t values[] = {-1, 100, -8000, 32000, -8000000, 2000000000, -500000000000, 100000000000000, -30000000000000000, INT64_MIN};
+    uint8_t buffer[sizeof(values) * 9U + 9U];
+    struct blink_stream stream;
+    int64_t out;
+    bool isNull;
+    size_t i;
+
+    (void)BLINK_Stream_initBuffer(&stream, buffer, sizeof(buffer));
+
+    for(i=0U; i < (sizeof(values)/sizeof(*values)); i++){
+
+        assert_true(BLINK_Compact_encodeI64(values[i], &stream));
+    }
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, buffer, sizeof(buffer));
+
+    for(i=0U; i < (sizeof(values)/sizeof(*values)); i++){
+
+        assert_true(BLINK_Compact_decodeI64(&stream, &out, &isNull));
+        assert_false(isNull);
+        assert_true(out == values[i]);
+    }
+}
+
+static void test_BLINK_Compact_skip(void **user)
+{
+    /* u64, null string, binary, present fixed(2), decimal, dynamic group, then a marker */
+    static const uint8_t in[] = "\xC3\x01\x02\x03""\xC0""\x02""ab""\x01""XY""\x7e\x05""\x02\x01\x00""\x2a";
+    struct blink_stream stream;
+    blink_stream_t s = BLINK_Stream_initBufferReadOnly(&stream, in, sizeof(in)-1U);
+    uint8_t marker;
+    bool isNull;
+
+    assert_true(BLINK_Compact_skipVLC(s));
+    assert_true(BLINK_Compact_skipString(s));
+    assert_true(BLINK_Compact_skipString(s));
+    assert_true(BLINK_Compact_skipFixed(s, 2U, true));
+    assert_true(BLINK_Compact_skipDecimal(s));
+    assert_true(BLINK_Compact_skipDynamicGroup(s));
+    assert_true(BLINK_Compact_decodeU8(s, &marker, &isNull));
+    assert_int_equal(0x2a, marker);
+}
+
+static void test_BLINK_Compact_skipDynamicGroup_zeroSize(void **user)
+{
+    static const uint8_t in[] = {0x00U, 0x2aU};
+    struct blink_stream stream;
+    blink_stream_t s = BLINK_Stream_initBufferReadOnly(&stream, in, sizeof(in));
+
+    assert_false(BLINK_Compact_skipDynamicGroup(s));
+}
+
+static void test_BLINK_Compact_skipString_truncated(void **user)
+{
+    static const uint8_t in[] = {0x03U, 'a', 'b'};
+    struct blink_stream stream;
+    blink_stream_t s = BLINK_Stream_initBufferReadOnly(&stream, in, sizeof(in));
+
+    assert_false(BLINK_Compact_skipString(s));
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -388,7 +487,13 @@ int main(void)
         cmocka_unit_test(test_BLINK_Compact_Decimal),
         cmocka_unit_test(test_BLINK_Compact_Decimal_nullMantissa),
         cmocka_unit_test_setup(test_BLINK_Compact_decodeBool_true, setupSingleByteOne),
-        cmocka_unit_test_setup(test_BLINK_Compact_decodeBool_null, setupSingleByteNull)
+        cmocka_unit_test_setup(test_BLINK_Compact_decodeBool_null, setupSingleByteNull),
+        cmocka_unit_test(test_BLINK_Compact_decodeU32_bounded),
+        cmocka_unit_test(test_BLINK_Compact_decodeU32_truncated),
+        cmocka_unit_test(test_BLINK_Compact_decodeI64_wide),
+        cmocka_unit_test(test_BLINK_Compact_skip),
+        cmocka_unit_test(test_BLINK_Compact_skipString_truncated),
+        cmocka_unit_test(test_BLINK_Compact_skipDynamicGroup_zeroSize)
     };
     
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,196 @@
+/**
+ * @example tc_blink_fd.c
+ *
+ * */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+
+#include "cmocka.h"
+#include "blink_fd.h"
+#include "blink_stream.h"
+#include "blink_compact.h"
+
+static int fds[2];
+
+static int setup_pipe(void **user)
+{
+    return pipe(fds);
+}
+
+static int teardown_pipe(void **user)
+{
+    (void)close(fds[0]);
+    (void)close(fds[1]);
+    return 0;
+}
+
+static int pending(void)
+{
+    int n = -1;
+
+    (void)ioctl(fds[0], FIONREAD, &n);
+
+    return n;
+}
+
+static void test_BLINK_Fd_coalesce(void **user)
+{
+    uint8_t readAhead[4U];
+    uint8_t coalesce[8U];
+    struct blink_fd in;
+    struct blink_fd out;
+    struct blink_stream input;
+    struct blink_stream output;
+    uint32_t value;
+    bool isNull;
+    uint32_t i;
+
+    (void)BLINK_Fd_initStream(&out, &output, fds[1], NULL, 0U, coalesce, sizeof(coalesce));
+
+    /* 1 + 2 + 4 bytes */
+    assert_true(BLINK_Compact_encodeU32(1U, &output));
+    assert_true(BLINK_Compact_encodeU32(1000U, &output));
+    assert_true(BLINK_Compact_encodeU32(100000U, &output));
+
+    /* nothing written until flushed */
+    assert_int_equal(0, pending());
+    assert_true(BLINK_Fd_flush(&out));
+    assert_int_equal(7, pending());
+
+    /* a full buffer is written in one go */
+    for(i=0U; i < 10U; i++){
+
+        assert_true(BLINK_Compact_encodeU32(i, &output));
+    }
+
+    assert_int_equal(7 + 8, pending());
+    assert_true(BLINK_Stream_tell(&output) == 17U);
+    assert_true(BLINK_Fd_flush(&out));
+
+    (void)BLINK_Fd_initStream(&in, &input, fds[0], readAhead, sizeof(readAhead), NULL, 0U);
+
+    assert_true(BLINK_Compact_decodeU32(&input, &value, &isNull));
+    assert_int_equal(1U, value);
+    assert_true(BLINK_Compact_decodeU32(&input, &value, &isNull));
+    assert_int_equal(1000U, value);
+    assert_true(BLINK_Compact_decodeU32(&input, &value, &isNull));
+    assert_int_equal(100000U, value);
+
+    for(i=0U; i < 10U; i++){
+
+        assert_true(BLINK_Compact_decodeU32(&input, &value, &isNull));
+        assert_int_equal(i, value);
+    }
+
+    assert_true(BLINK_Stream_tell(&input) == 17U);
+}
+
+static void test_BLINK_Fd_large(void **user)
+{
+    uint8_t readAhead[4U];
+    uint8_t coalesce[8U];
+    uint8_t data[100U];
+    uint8_t result[sizeof(data)];
+    uint8_t c;
+    struct blink_fd in;
+    struct blink_fd out;
+    struct blink_stream input;
+    struct blink_stream output;
+    size_t i;
+
+    for(i=0U; i < sizeof(data); i++){
+
+        data[i] = (uint8_t)i;
+    }
+
+    (void)BLINK_Fd_initStream(&out, &output, fds[1], NULL, 0U, coalesce, sizeof(coalesce));
+
+    /* buffered bytes are written before the large write */
+    assert_true(BLINK_Stream_write(&output, "\xFF", 1U));
+    assert_true(BLINK_Stream_write(&output, data, sizeof(data)));
+    assert_int_equal(1 + sizeof(data), pending());
+
+    (void)BLINK_Fd_initStream(&in, &input, fds[0], readAhead, sizeof(readAhead), NULL, 0U);
+
+    assert_true(BLINK_Stream_peek(&input, &c));
+    assert_int_equal(0xFF, c);
+    assert_true(BLINK_Stream_read(&input, &c, 1U));
+    assert_true(BLINK_Stream_read(&input, result, sizeof(result)));
+    assert_memory_equal(data, result, sizeof(data));
+}
+
+static void test_BLINK_Fd_eof(void **user)
+{
+    uint8_t readAhead[4U];
+    uint8_t buf[2U];
+    struct blink_fd in;
+    struct blink_stream input;
+
+    assert_int_equal(1, write(fds[1], "x", 1U));
+    (void)close(fds[1]);
+    fds[1] = -1;
+
+    (void)BLINK_Fd_initStream(&in, &input, fds[0], readAhead, sizeof(readAhead), NULL, 0U);
+
+    assert_false(BLINK_Stream_read(&input, buf, sizeof(buf)));
+    assert_true(BLINK_Stream_eof(&input));
+}
+
+static void test_BLINK_Fd_flush_again(void **user)
+{
+    uint8_t coalesce[8U];
+    uint8_t junk[4096U];
+    uint8_t result[5U];
+    struct blink_fd out;
+    struct blink_stream output;
+    ssize_t n;
+
+    (void)memset(junk, 0, sizeof(junk));
+
+    /* fill the pipe so that the next write fails with EAGAIN */
+    assert_int_equal(0, fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK));
+
+    do{
+
+        n = write(fds[1], junk, sizeof(junk));
+    }
+    while(n > 0);
+
+    (void)BLINK_Fd_initStream(&out, &output, fds[1], NULL, 0U, coalesce, sizeof(coalesce));
+
+    assert_true(BLINK_Stream_write(&output, "hello", 5U));
+
+    /* a failed flush keeps the buffered bytes */
+    assert_false(BLINK_Fd_flush(&out));
+    assert_int_equal(5U, out.outLen);
+
+    while(pending() > 0){
+
+        n = read(fds[0], junk, sizeof(junk));
+        assert_true(n > 0);
+    }
+
+    assert_true(BLINK_Fd_flush(&out));
+    assert_int_equal(0U, out.outLen);
+
+    assert_int_equal(sizeof(result), read(fds[0], result, sizeof(result)));
+    assert_memory_equal("hello", result, sizeof(result));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_BLINK_Fd_coalesce, setup_pipe, teardown_pipe),
+        cmocka_unit_test_setup_teardown(test_BLINK_Fd_large, setup_pipe, teardown_pipe),
+        cmocka_unit_test_setup_teardown(test_BLINK_Fd_eof, setup_pipe, teardown_pipe),
+        cmocka_unit_test_setup_teardown(test_BLINK_Fd_flush_again, setup_pipe, teardown_pipe),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
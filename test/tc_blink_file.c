@@ -0,0 +1,123 @@
+/**
+ * @example tc_blink_file.c
+ *
+ * */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cmocka.h"
+#include "blink_file.h"
+#include "blink_stream.h"
+#include "blink_compact.h"
+
+static char path[] = "build/tc_blink_file_XXXXXX";
+
+/* three compact form u32 values: 1, 1000, NULL */
+static const uint8_t content[] = "\x01\xA8\x0F\xC0";
+
+static int setup_file(void **user)
+{
+    int fd = mkstemp(path);
+
+    if(fd >= 0){
+
+        (void)write(fd, content, sizeof(content)-1U);
+        (void)close(fd);
+    }
+
+    return (fd >= 0) ? 0 : -1;
+}
+
+static int teardown_file(void **user)
+{
+    (void)unlink(path);
+    (void)strcpy(&path[strlen(path)-6U], "XXXXXX");
+    return 0;
+}
+
+static void test_BLINK_File_map(void **user)
+{
+    struct blink_file file;
+    struct blink_stream stream;
+    uint32_t value;
+    bool isNull;
+
+    assert_true(BLINK_File_map(&file, path));
+    assert_int_equal(sizeof(content)-1U, file.size);
+
+    assert_true(BLINK_File_initStream(&file, &stream, 0U) != NULL);
+    assert_true(BLINK_Compact_decodeU32(&stream, &value, &isNull));
+    assert_int_equal(1U, value);
+
+    /* borrowed data points into the mapping */
+    assert_ptr_equal(&file.data[1], BLINK_Stream_borrow(&stream, 0U));
+
+    assert_true(BLINK_Compact_decodeU32(&stream, &value, &isNull));
+    assert_int_equal(1000U, value);
+    assert_true(BLINK_Compact_decodeU32(&stream, &value, &isNull));
+    assert_true(isNull);
+    assert_false(BLINK_Compact_decodeU32(&stream, &value, &isNull));
+
+    BLINK_File_unmap(&file);
+    assert_true(file.data == NULL);
+}
+
+static void test_BLINK_File_initStream_offset(void **user)
+{
+    struct blink_file file;
+    struct blink_stream stream;
+    uint32_t value;
+    bool isNull;
+
+    assert_true(BLINK_File_map(&file, path));
+
+    assert_true(BLINK_File_initStream(&file, &stream, 1U) != NULL);
+    assert_int_equal(3U, BLINK_Stream_max(&stream));
+    assert_true(BLINK_Compact_decodeU32(&stream, &value, &isNull));
+    assert_int_equal(1000U, value);
+
+    assert_true(BLINK_File_initStream(&file, &stream, file.size) == NULL);
+    assert_true(BLINK_File_initStream(&file, &stream, UINT64_MAX) == NULL);
+
+    BLINK_File_unmap(&file);
+}
+
+static void test_BLINK_File_map_empty(void **user)
+{
+    struct blink_file file;
+    struct blink_stream stream;
+
+    assert_int_equal(0, truncate(path, 0));
+
+    assert_true(BLINK_File_map(&file, path));
+    assert_int_equal(0U, file.size);
+    assert_true(BLINK_File_initStream(&file, &stream, 0U) == NULL);
+
+    BLINK_File_unmap(&file);
+}
+
+static void test_BLINK_File_map_missing(void **user)
+{
+    struct blink_file file;
+
+    assert_false(BLINK_File_map(&file, "build/does_not_exist"));
+    assert_false(BLINK_File_map(&file, "build"));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_BLINK_File_map, setup_file, teardown_file),
+        cmocka_unit_test_setup_teardown(test_BLINK_File_initStream_offset, setup_file, teardown_file),
+        cmocka_unit_test_setup_teardown(test_BLINK_File_map_empty, setup_file, teardown_file),
+        cmocka_unit_test(test_BLINK_File_map_missing),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
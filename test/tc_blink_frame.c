@@ -0,0 +1,260 @@
+/**
+ * @example tc_blink_frame.c
+ *
+ * */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+
+#include "cmocka.h"
+#include "blink_frame.h"
+#include "blink_stream.h"
+#include "blink_schema.h"
+#include "blink_object.h"
+
+#include <malloc.h>
+
+static struct blink_allocator alloc = {
+    .calloc = calloc,
+    .free = free
+};
+
+/* InsertOrder, unknown group 9, CancelOrder */
+static const uint8_t input[] = 
+    "\x0F\x01\x03""IBM""\x06""ABC123""\x7D\xA8\x0F"
+    "\x03\x09\x01""z"
+    "\x05\x02\x03""abc";
+
+static int setup(void **user)
+{
+    static const char syntax[] =
+        "InsertOrder/1 ->\n"
+        "   string Symbol,\n"
+        "   string OrderId,\n"
+        "   u32 Price,\n"
+        "   u32 Quantity\n"
+        ""
+        "CancelOrder/2 ->\n"
+        "   string OrderId\n";
+    
+    static struct blink_stream stream;
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)syntax, sizeof(syntax));
+    *user = (void *)BLINK_Schema_new(&alloc, &stream);
+    return 0;
+}
+
+static void test_BLINK_Frame_next(void **user)
+{
+    uint8_t buffer[64U];
+    struct blink_frame_reader reader;
+    struct blink_frame frame;
+    struct blink_stream in;
+
+    BLINK_Frame_init(&reader, buffer, sizeof(buffer), NULL);
+
+    assert_true(BLINK_Frame_fill(&reader, BLINK_Stream_initBufferReadOnly(&in, input, sizeof(input)-1U)));
+
+    /* stream is exhausted */
+    assert_false(BLINK_Frame_fill(&reader, &in));
+
+    assert_int_equal(BLINK_FRAME_OK, BLINK_Frame_next(&reader, &frame));
+    assert_int_equal(1U, frame.id);
+    assert_int_equal(15U, frame.size);
+    assert_int_equal(16U, frame.len);
+    assert_int_equal(14U, frame.bodyLen);
+    assert_memory_equal("\x03""IBM", frame.body, 4U);
+
+    assert_int_equal(BLINK_FRAME_OK, BLINK_Frame_next(&reader, &frame));
+    assert_int_equal(9U, frame.id);
+    assert_int_equal(2U, frame.bodyLen);
+
+    assert_int_equal(BLINK_FRAME_OK, BLINK_Frame_next(&reader, &frame));
+    assert_int_equal(2U, frame.id);
+    assert_memory_equal("\x03""abc", frame.body, frame.bodyLen);
+
+    assert_int_equal(BLINK_FRAME_PARTIAL, BLINK_Frame_next(&reader, &frame));
+}
+
+static void test_BLINK_Frame_next_partial(void **user)
+{
+    blink_schema_t schema = (blink_schema_t)(*user);
+    uint8_t buffer[20U];
+    struct blink_frame_reader reader;
+    struct blink_frame frame;
+    struct blink_stream body;
+    uint64_t ids[3U];
+    size_t frames = 0U;
+    size_t space;
+    size_t i;
+    uint8_t *ptr;
+
+    BLINK_Frame_init(&reader, buffer, sizeof(buffer), schema);
+
+    /* one byte at a time */
+    for(i=0U; i < (sizeof(input)-1U); i++){
+
+        ptr = BLINK_Frame_reserve(&reader, &space);
+
+        assert_true(space > 0U);
+
+        *ptr = input[i];
+        BLINK_Frame_commit(&reader, 1U);
+
+        while(BLINK_Frame_next(&reader, &frame) == BLINK_FRAME_OK){
+
+            assert_true(frames < 3U);
+            ids[frames] = frame.id;
+            frames++;
+
+            /* whole frame decodes */
+            blink_object_t group = BLINK_Object_decodeCompact(BLINK_Stream_initBufferReadOnly(&body, frame.data, frame.len), schema, &alloc);
+            assert_true(group != NULL);
+            BLINK_Object_destroyGroup(&group);
+        }
+    }
+
+    /* unknown group is skipped */
+    assert_int_equal(2U, frames);
+    assert_int_equal(1U, ids[0]);
+    assert_int_equal(2U, ids[1]);
+    assert_int_equal(1U, reader.skipped);
+}
+
+static void test_BLINK_Frame_next_skipLarge(void **user)
+{
+    /* unknown group 9 larger than the buffer followed by CancelOrder */
+    uint8_t large[200U];
+    uint8_t buffer[16U];
+    struct blink_frame_reader reader;
+    struct blink_frame frame;
+    struct blink_stream in;
+
+    (void)memset(large, 'x', sizeof(large));
+    large[0] = 0x80U | ((sizeof(large) - 8U) & 0x3fU);
+    large[1] = (sizeof(large) - 8U) >> 6;
+    large[2] = 0x09U;
+    (void)memcpy(&large[sizeof(large) - 6U], "\x05\x02\x03""abc", 6U);
+
+    BLINK_Frame_init(&reader, buffer, sizeof(buffer), (blink_schema_t)(*user));
+    (void)BLINK_Stream_initBufferReadOnly(&in, large, sizeof(large));
+
+    while(BLINK_Frame_next(&reader, &frame) == BLINK_FRAME_PARTIAL){
+
+        assert_true(BLINK_Frame_fill(&reader, &in));
+    }
+
+    assert_int_equal(2U, frame.id);
+    assert_int_equal(1U, reader.skipped);
+}
+
+static void test_BLINK_Frame_next_tooLarge(void **user)
+{
+    uint8_t buffer[8U];
+    struct blink_frame_reader reader;
+    struct blink_frame frame;
+    struct blink_stream in;
+
+    BLINK_Frame_init(&reader, buffer, sizeof(buffer), NULL);
+
+    assert_true(BLINK_Frame_fill(&reader, BLINK_Stream_initBufferReadOnly(&in, input, sizeof(input)-1U)));
+    assert_int_equal(BLINK_FRAME_ERROR, BLINK_Frame_next(&reader, &frame));
+}
+
+static void test_BLINK_Frame_next_null(void **user)
+{
+    uint8_t buffer[8U];
+    struct blink_frame_reader reader;
+    struct blink_frame frame;
+    struct blink_stream in;
+
+    BLINK_Frame_init(&reader, buffer, sizeof(buffer), NULL);
+
+    assert_true(BLINK_Frame_fill(&reader, BLINK_Stream_initBufferReadOnly(&in, "\xC0\x01", 2U)));
+    assert_int_equal(BLINK_FRAME_ERROR, BLINK_Frame_next(&reader, &frame));
+}
+
+static void test_BLINK_Frame_next_widePreamble(void **user)
+{
+    uint8_t buffer[8U];
+    struct blink_frame_reader reader;
+    struct blink_frame frame;
+    struct blink_stream in;
+
+    BLINK_Frame_init(&reader, buffer, sizeof(buffer), NULL);
+
+    /* rejected on the first byte rather than waiting for the rest */
+    assert_true(BLINK_Frame_fill(&reader, BLINK_Stream_initBufferReadOnly(&in, "\xFF", 1U)));
+    assert_int_equal(BLINK_FRAME_ERROR, BLINK_Frame_next(&reader, &frame));
+
+    /* a size preamble cannot be wider than a u32 */
+    BLINK_Frame_init(&reader, buffer, sizeof(buffer), NULL);
+
+    assert_true(BLINK_Frame_fill(&reader, BLINK_Stream_initBufferReadOnly(&in, "\xC5", 1U)));
+    assert_int_equal(BLINK_FRAME_ERROR, BLINK_Frame_next(&reader, &frame));
+
+    /* nor can a group ID be wider than a u64 */
+    BLINK_Frame_init(&reader, buffer, sizeof(buffer), NULL);
+
+    assert_true(BLINK_Frame_fill(&reader, BLINK_Stream_initBufferReadOnly(&in, "\x10\xFF", 2U)));
+    assert_int_equal(BLINK_FRAME_ERROR, BLINK_Frame_next(&reader, &frame));
+}
+
+struct user_input {
+    const uint8_t *data;
+    size_t len;
+    size_t pos;
+};
+
+static bool userRead(void *state, void *out, size_t bytesToRead)
+{
+    struct user_input *self = (struct user_input *)state;
+    bool retval = false;
+
+    if((self->len - self->pos) >= bytesToRead){
+
+        (void)memcpy(out, &self->data[self->pos], bytesToRead);
+        self->pos += bytesToRead;
+        retval = true;
+    }
+
+    return retval;
+}
+
+static void test_BLINK_Frame_fill_user(void **user)
+{
+    uint8_t buffer[64U];
+    struct blink_frame_reader reader;
+    struct blink_frame frame;
+    struct blink_stream in;
+    struct blink_stream_user fn = {.read = userRead};
+    struct user_input state = {.data = input, .len = sizeof(input)-1U};
+
+    BLINK_Frame_init(&reader, buffer, sizeof(buffer), NULL);
+    (void)BLINK_Stream_initUser(&in, &state, fn);
+
+    while(BLINK_Frame_next(&reader, &frame) == BLINK_FRAME_PARTIAL){
+
+        assert_true(BLINK_Frame_fill(&reader, &in));
+    }
+
+    /* stream without a maximum is not read past the frame */
+    assert_int_equal(1U, frame.id);
+    assert_int_equal(frame.len, state.pos);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_BLINK_Frame_next),
+        cmocka_unit_test_setup(test_BLINK_Frame_next_partial, setup),
+        cmocka_unit_test_setup(test_BLINK_Frame_next_skipLarge, setup),
+        cmocka_unit_test(test_BLINK_Frame_next_tooLarge),
+        cmocka_unit_test(test_BLINK_Frame_next_null),
+        cmocka_unit_test(test_BLINK_Frame_next_widePreamble),
+        cmocka_unit_test(test_BLINK_Frame_fill_user),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
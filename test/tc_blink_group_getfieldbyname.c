@@ -0,0 +1,108 @@
+/**
+ * @example tc_blink_group_getfieldbyname.c
+ *
+ * */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+#include "blink_schema.h"
+#include "blink_stream.h"
+#include "blink_alloc.h"
+#include <string.h>
+
+#include <malloc.h>
+
+static struct blink_allocator alloc = {
+    .calloc = calloc,
+    .free = free
+};
+
+static int setup(void **user)
+{
+    static const char input[] =
+        "Colour = Red | Green | Blue\n"
+        "\n"
+        "Base ->\n"
+        "   string OrderId\n"
+        "\n"
+        "InsertOrder/1 : Base ->\n"
+        "   string Symbol,\n"
+        "   u32 Price,\n"
+        "   Colour Colour\n";
+
+    static struct blink_stream stream;
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
+    *user = (void *)BLINK_Schema_new(&alloc, &stream);
+    return 0;
+}
+
+static void test_BLINK_Group_getFieldByName(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder");
+    assert_true(g != NULL);
+
+    blink_schema_t f = BLINK_Group_getFieldByName(g, "Price");
+    assert_true(f != NULL);
+    assert_string_equal("Price", BLINK_Field_getName(f));
+}
+
+static void test_BLINK_Group_getFieldByName_inherited(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder");
+    blink_schema_t base = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Base");
+    assert_true(g != NULL);
+    assert_true(base != NULL);
+
+    blink_schema_t f = BLINK_Group_getFieldByName(g, "OrderId");
+    assert_true(f != NULL);
+    assert_true(f == BLINK_Group_getFieldByName(base, "OrderId"));
+    assert_true(BLINK_Group_getFieldByName(base, "Price") == NULL);
+}
+
+static void test_BLINK_Group_getFieldByName_unknown(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder");
+    assert_true(g != NULL);
+
+    assert_true(BLINK_Group_getFieldByName(g, "Pric") == NULL);
+    assert_true(BLINK_Group_getFieldByName(g, "Prices") == NULL);
+}
+
+static void test_BLINK_Group_getFieldByKey(void **user)
+{
+    struct blink_name key = BLINK_Name_init("Symbol");
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder");
+    assert_true(g != NULL);
+
+    assert_true(BLINK_Group_getFieldByKey(g, &key) == BLINK_Group_getFieldByName(g, "Symbol"));
+}
+
+static void test_BLINK_Enum_getSymbolByKey(void **user)
+{
+    struct blink_name key = BLINK_Name_init("Green");
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder");
+    assert_true(g != NULL);
+
+    blink_schema_t e = BLINK_Field_getEnum(BLINK_Group_getFieldByName(g, "Colour"));
+    assert_true(e != NULL);
+
+    blink_schema_t s = BLINK_Enum_getSymbolByKey(e, &key);
+    assert_true(s != NULL);
+    assert_true(s == BLINK_Enum_getSymbolByName(e, "Green"));
+    assert_true(BLINK_Enum_getSymbolByName(e, "Gree") == NULL);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_BLINK_Group_getFieldByName, setup),
+        cmocka_unit_test_setup(test_BLINK_Group_getFieldByName_inherited, setup),
+        cmocka_unit_test_setup(test_BLINK_Group_getFieldByName_unknown, setup),
+        cmocka_unit_test_setup(test_BLINK_Group_getFieldByKey, setup),
+        cmocka_unit_test_setup(test_BLINK_Enum_getSymbolByKey, setup),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,148 @@
+/**
+ * @example tc_blink_group_getfielddescs.c
+ *
+ * */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+#include "blink_schema.h"
+#include "blink_stream.h"
+#include "blink_alloc.h"
+#include <string.h>
+
+#include <malloc.h>
+
+static struct blink_allocator alloc = {
+    .calloc = calloc,
+    .free = free
+};
+
+static int setup(void **user)
+{
+    static const char input[] =
+        "Side = Buy | Sell\n"
+        "Symbol = fixed (8)\n"
+        "Prices = u32 []\n"
+        "\n"
+        "Leg ->\n"
+        "   Side Side\n"
+        "\n"
+        "Order ->\n"
+        "   string OrderId\n"
+        "\n"
+        "InsertOrder/1 : Order ->\n"
+        "   Symbol Symbol,\n"
+        "   Prices Prices,\n"
+        "   Side Side?,\n"
+        "   Leg Leg,\n"
+        "   Leg* Other\n"
+        "\n"
+        "Legs ->\n"
+        "   Leg [] Legs?\n";
+
+    static struct blink_stream stream;
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
+    *user = (void *)BLINK_Schema_new(&alloc, &stream);
+    return 0;
+}
+
+static void test_BLINK_Group_getFieldDescs(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder");
+    assert_true(g != NULL);
+    assert_int_equal(6U, BLINK_Group_numberOfFields(g));
+
+    const struct blink_field_desc *desc = BLINK_Group_getFieldDescs(g);
+    assert_true(desc != NULL);
+
+    /* inherited field comes first */
+    assert_string_equal("OrderId", BLINK_Field_getName(desc[0].field));
+    assert_int_equal(BLINK_TYPE_STRING, desc[0].type);
+
+    /* typedef chains are resolved */
+    assert_string_equal("Symbol", BLINK_Field_getName(desc[1].field));
+    assert_int_equal(BLINK_TYPE_FIXED, desc[1].type);
+    assert_int_equal(8U, desc[1].size);
+
+    assert_int_equal(BLINK_TYPE_U32, desc[2].type);
+    assert_true(desc[2].isSequence);
+
+    assert_int_equal(BLINK_TYPE_ENUM, desc[3].type);
+    assert_true(desc[3].isOptional);
+    assert_true(desc[3].ref == BLINK_Field_getEnum(desc[3].field));
+
+    assert_int_equal(BLINK_TYPE_STATIC_GROUP, desc[4].type);
+    assert_true(desc[4].ref == BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Leg"));
+
+    assert_int_equal(BLINK_TYPE_DYNAMIC_GROUP, desc[5].type);
+    assert_true(desc[5].ref == BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Leg"));
+}
+
+static void test_BLINK_Field_getDesc(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder");
+    blink_schema_t order = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Order");
+    blink_schema_t f = BLINK_Group_getFieldByName(g, "Prices");
+
+    assert_true(f != NULL);
+    assert_true(BLINK_Field_getDesc(f)->field == f);
+    assert_true(BLINK_Field_isSequence(f));
+    assert_int_equal(BLINK_TYPE_U32, BLINK_Field_getType(f));
+
+    /* inherited fields share type information with the supergroup */
+    assert_int_equal(1U, BLINK_Group_numberOfFields(order));
+    assert_true(BLINK_Group_getFieldDescs(order)[0].field == BLINK_Group_getFieldDescs(g)[0].field);
+}
+
+static void test_BLINK_Group_getDecodeProgram(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder");
+    blink_schema_t leg = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Leg");
+    const struct blink_decode_op *op = BLINK_Group_getDecodeProgram(g);
+
+    assert_true(op != NULL);
+
+    assert_int_equal(BLINK_OP_STRING, op[0].code);
+    assert_int_equal(0U, op[0].field);
+
+    assert_int_equal(BLINK_OP_FIXED, op[1].code);
+    assert_int_equal(8U, op[1].size);
+
+    /* integer sequences are a single operation */
+    assert_int_equal(BLINK_OP_INTEGER_SEQUENCE, op[2].code);
+    assert_int_equal(BLINK_TYPE_U32, op[2].type);
+
+    assert_int_equal(BLINK_OP_ENUM, op[3].code);
+    assert_true(op[3].isOptional);
+
+    assert_int_equal(BLINK_OP_STATIC_GROUP, op[4].code);
+    assert_true(op[4].ref == leg);
+
+    assert_int_equal(BLINK_OP_DYNAMIC_GROUP, op[5].code);
+    assert_int_equal(5U, op[5].field);
+
+    assert_int_equal(BLINK_OP_END, op[6].code);
+
+    /* other sequences are followed by the element operation */
+    op = BLINK_Group_getDecodeProgram(BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Legs"));
+
+    assert_int_equal(BLINK_OP_SEQUENCE, op[0].code);
+    assert_true(op[0].isOptional);
+    assert_int_equal(BLINK_OP_STATIC_GROUP, op[1].code);
+    assert_false(op[1].isOptional);
+    assert_int_equal(0U, op[1].field);
+    assert_int_equal(BLINK_OP_END, op[2].code);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_BLINK_Group_getFieldDescs, setup),
+        cmocka_unit_test_setup(test_BLINK_Field_getDesc, setup),
+        cmocka_unit_test_setup(test_BLINK_Group_getDecodeProgram, setup),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,251 @@
+/**
+ * @example tc_blink_iovec.c
+ *
+ * */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+
+#include "cmocka.h"
+#include "blink_iovec.h"
+#include "blink_stream.h"
+#include "blink_object.h"
+#include "blink_schema.h"
+
+#include <malloc.h>
+
+static struct blink_allocator alloc = {
+    .calloc = calloc,
+    .free = free
+};
+
+static int fds[2];
+
+static int setup_pipe(void **user)
+{
+    return pipe(fds);
+}
+
+static int teardown_pipe(void **user)
+{
+    (void)close(fds[0]);
+    (void)close(fds[1]);
+    return 0;
+}
+
+static int pending(void)
+{
+    int n = -1;
+
+    (void)ioctl(fds[0], FIONREAD, &n);
+
+    return n;
+}
+
+static void test_BLINK_IOVec_gather(void **user)
+{
+    struct iovec iov[8U];
+    uint8_t coalesce[16U];
+    uint8_t payload[64U];
+    uint8_t result[72U];
+    struct blink_iovec gather;
+    struct blink_stream output;
+
+    (void)memset(payload, 'p', sizeof(payload));
+
+    (void)BLINK_IOVec_initStream(&gather, &output, fds[1], iov, 8U, coalesce, sizeof(coalesce), 32U);
+
+    assert_true(BLINK_Stream_write(&output, "ab", 2U));
+    assert_true(BLINK_Stream_write(&output, "cd", 2U));
+    assert_true(BLINK_Stream_writeRef(&output, payload, sizeof(payload)));
+    assert_true(BLINK_Stream_write(&output, "ef", 2U));
+
+    /* below threshold so copied */
+    assert_true(BLINK_Stream_writeRef(&output, "gh", 2U));
+
+    assert_int_equal(3U, gather.iovCount);
+    assert_int_equal(4U, iov[0].iov_len);
+    assert_ptr_equal(payload, iov[1].iov_base);
+    assert_int_equal(sizeof(payload), iov[1].iov_len);
+    assert_int_equal(4U, iov[2].iov_len);
+
+    assert_true(BLINK_Stream_tell(&output) == sizeof(result));
+    assert_int_equal(0, pending());
+
+    assert_true(BLINK_IOVec_flush(&gather));
+    assert_int_equal(0U, gather.iovCount);
+    assert_int_equal(sizeof(result), pending());
+
+    assert_int_equal(sizeof(result), read(fds[0], result, sizeof(result)));
+    assert_memory_equal("abcd", result, 4U);
+    assert_memory_equal(payload, &result[4], sizeof(payload));
+    assert_memory_equal("efgh", &result[68], 4U);
+}
+
+static void test_BLINK_IOVec_full(void **user)
+{
+    struct iovec iov[2U];
+    uint8_t coalesce[4U];
+    uint8_t payload[8U];
+    struct blink_iovec gather;
+    struct blink_stream output;
+
+    (void)memset(payload, 'p', sizeof(payload));
+
+    (void)BLINK_IOVec_initStream(&gather, &output, fds[1], iov, 2U, coalesce, sizeof(coalesce), 1U);
+
+    /* segments are flushed when the array is full */
+    assert_true(BLINK_Stream_writeRef(&output, payload, sizeof(payload)));
+    assert_true(BLINK_Stream_writeRef(&output, payload, sizeof(payload)));
+    assert_true(BLINK_Stream_writeRef(&output, payload, sizeof(payload)));
+    assert_int_equal(16, pending());
+    assert_int_equal(1U, gather.iovCount);
+
+    /* plain writes larger than the buffer are sent at once */
+    assert_true(BLINK_Stream_write(&output, payload, sizeof(payload)));
+    assert_int_equal(32, pending());
+    assert_int_equal(0U, gather.iovCount);
+}
+
+static void test_BLINK_IOVec_flush_again(void **user)
+{
+    struct iovec iov[4U];
+    uint8_t coalesce[16U];
+    static uint8_t payload[20000U];
+    static uint8_t junk[65536U];
+    static uint8_t result[sizeof(payload) + 3U];
+    struct blink_iovec gather;
+    struct blink_stream output;
+    size_t total = 0U;
+    size_t filled = 0U;
+    ssize_t n;
+
+    (void)memset(payload, 'p', sizeof(payload));
+    payload[sizeof(payload) - 1U] = 'z';
+
+    /* fill the pipe so that writev() fails with EAGAIN */
+    assert_int_equal(0, fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK));
+
+    do{
+
+        n = write(fds[1], junk, 4096U);
+        filled += (n > 0) ? (size_t)n : 0U;
+    }
+    while(n > 0);
+
+    (void)BLINK_IOVec_initStream(&gather, &output, fds[1], iov, 4U, coalesce, sizeof(coalesce), 32U);
+
+    assert_true(BLINK_Stream_write(&output, "abc", 3U));
+    assert_true(BLINK_Stream_writeRef(&output, payload, sizeof(payload)));
+
+    /* nothing is lost when nothing could be written */
+    assert_false(BLINK_IOVec_flush(&gather));
+    assert_int_equal(2U, gather.iovCount);
+    assert_true(gather.sent == 0U);
+
+    /* make room for part of the queue */
+    assert_int_equal(4096, read(fds[0], junk, 4096U));
+    filled -= 4096U;
+
+    (void)BLINK_IOVec_flush(&gather);
+
+    /* drain the junk then collect the rest as it is flushed */
+    while(filled > 0U){
+
+        n = read(fds[0], junk, (filled < sizeof(junk)) ? filled : sizeof(junk));
+        assert_true(n > 0);
+        filled -= (size_t)n;
+    }
+
+    while(total < sizeof(result)){
+
+        if(gather.iovCount > 0U){
+
+            (void)BLINK_IOVec_flush(&gather);
+        }
+
+        n = read(fds[0], &result[total], sizeof(result) - total);
+        assert_true(n > 0);
+        total += (size_t)n;
+    }
+
+    assert_true(BLINK_IOVec_flush(&gather));
+    assert_true(gather.sent == sizeof(result));
+    assert_memory_equal("abc", result, 3U);
+    assert_memory_equal(payload, &result[3], sizeof(payload));
+}
+
+static void test_BLINK_IOVec_encodeCompact(void **user)
+{
+    static const char syntax[] = "Blob/1 -> u32 Id, binary Data";
+    struct blink_stream stream;
+    struct iovec iov[8U];
+    uint8_t coalesce[16U];
+    uint8_t data[100U];
+    uint8_t result[200U];
+    struct blink_iovec gather;
+    struct blink_stream output;
+    const uint8_t *ref;
+    uint32_t len;
+    size_t i;
+    int size;
+    bool found = false;
+    blink_schema_t schema = BLINK_Schema_new(&alloc, BLINK_Stream_initBufferReadOnly(&stream, syntax, sizeof(syntax)));
+
+    assert_true(schema != NULL);
+
+    (void)memset(data, 'd', sizeof(data));
+
+    blink_object_t blob = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName(schema, "Blob"));
+
+    assert_true(BLINK_Object_setUint(blob, "Id", 42U));
+    assert_true(BLINK_Object_setBinary(blob, "Data", data, sizeof(data)));
+
+    BLINK_Object_getBinary(blob, "Data", &ref, &len);
+
+    (void)BLINK_IOVec_initStream(&gather, &output, fds[1], iov, 8U, coalesce, sizeof(coalesce), 32U);
+
+    assert_true(BLINK_Object_encodeCompact(blob, &output));
+
+    /* binary value is referenced rather than copied */
+    for(i=0U; i < gather.iovCount; i++){
+
+        found = found || (iov[i].iov_base == (void *)ref);
+    }
+
+    assert_true(found);
+
+    assert_true(BLINK_IOVec_flush(&gather));
+    size = pending();
+    assert_true(BLINK_Stream_tell(&output) == (uint64_t)size);
+    assert_int_equal(size, read(fds[0], result, sizeof(result)));
+
+    BLINK_Object_destroyGroup(&blob);
+
+    blink_object_t decoded = BLINK_Object_decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, result, BLINK_Stream_tell(&output)), schema, &alloc);
+
+    assert_true(decoded != NULL);
+    assert_int_equal(42U, BLINK_Object_getUint(decoded, "Id"));
+    BLINK_Object_getBinary(decoded, "Data", &ref, &len);
+    assert_int_equal(sizeof(data), len);
+    assert_memory_equal(data, ref, len);
+
+    BLINK_Object_destroyGroup(&decoded);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_BLINK_IOVec_gather, setup_pipe, teardown_pipe),
+        cmocka_unit_test_setup_teardown(test_BLINK_IOVec_full, setup_pipe, teardown_pipe),
+        cmocka_unit_test_setup_teardown(test_BLINK_IOVec_flush_again, setup_pipe, teardown_pipe),
+        cmocka_unit_test_setup_teardown(test_BLINK_IOVec_encodeCompact, setup_pipe, teardown_pipe),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,225 @@
+/* Copyright (c) 2016 Cameron Harper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+
+extern "C" {
+#include "cmocka.h"
+}
+
+#include "blink_message.hpp"
+
+enum class Side : int32_t {
+    Buy = 1,
+    Sell = 2
+};
+
+struct Symbol : blink::Field<blink::String> {};
+struct OrderId : blink::Field<blink::String> {};
+struct Price : blink::Field<blink::U32> {};
+struct Quantity : blink::Field<blink::U32> {};
+
+using InsertOrder = blink::Message<1U, Symbol, OrderId, Price, Quantity>;
+
+struct Qty : blink::Field<blink::U32> {};
+struct Venue : blink::Field<blink::Optional<blink::Fixed<3U>>> {};
+
+using Leg = blink::Group<Qty, Venue>;
+
+struct OrderSide : blink::Field<blink::Enum<Side>> {};
+struct Limit : blink::Field<blink::Optional<blink::U32>> {};
+struct Px : blink::Field<blink::Decimal> {};
+struct Flags : blink::Field<blink::Sequence<blink::Bool>> {};
+struct Legs : blink::Field<blink::Sequence<Leg>> {};
+struct Alt : blink::Field<blink::Optional<Leg>> {};
+struct Note : blink::Field<blink::Optional<blink::Binary>> {};
+struct Any : blink::Field<blink::Optional<blink::Dynamic<InsertOrder>>> {};
+struct Time : blink::Field<blink::NanoTime> {};
+
+using Order = blink::Message<2U, Symbol, OrderSide, Limit, Px, Flags, Legs, Alt, Note, Any, Time>;
+
+static const uint8_t insertOrder[] = "\x0F\x01\x03""IBM""\x06""ABC123""\x7D\xA8\x0F";
+
+static void test_encodeCompact(void **user)
+{
+    uint8_t buffer[100];
+    struct blink_stream output;
+    InsertOrder order;
+
+    order.set<Symbol>("IBM");
+    order.set<OrderId>("ABC123");
+    order.set<Price>(125U);
+    order.set<Quantity>(1000U);
+
+    assert_true(order.encodeCompact(BLINK_Stream_initBuffer(&output, buffer, sizeof(buffer))));
+
+    assert_int_equal(sizeof(insertOrder)-1U, BLINK_Stream_tell(&output));
+    assert_memory_equal(insertOrder, buffer, sizeof(insertOrder)-1U);
+}
+
+static void test_decodeCompact(void **user)
+{
+    struct blink_stream stream;
+    InsertOrder order;
+
+    assert_true(order.decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, insertOrder, sizeof(insertOrder)-1U)));
+
+    assert_string_equal("IBM", order.get<Symbol>().c_str());
+    assert_string_equal("ABC123", order.get<OrderId>().c_str());
+    assert_int_equal(125U, order.get<Price>());
+    assert_int_equal(1000U, order.get<Quantity>());
+}
+
+static void test_decodeCompact_wrongGroup(void **user)
+{
+    const uint8_t input[] = "\x05\x03\x01""A""\x01";
+    struct blink_stream stream;
+    InsertOrder order;
+
+    assert_false(order.decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, input, sizeof(input)-1U)));
+}
+
+static void test_decodeCompact_truncated(void **user)
+{
+    struct blink_stream stream;
+    InsertOrder order;
+
+    assert_false(order.decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, insertOrder, sizeof(insertOrder)-2U)));
+}
+
+static void test_decodeCompact_extension(void **user)
+{
+    const uint8_t input[] = "\x10\x01\x03""IBM""\x06""ABC123""\x7D\xA8\x0F\x00";
+    struct blink_stream stream;
+    InsertOrder order;
+
+    assert_false(order.decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, input, sizeof(input)-1U)));
+}
+
+static void test_roundTrip(void **user)
+{
+    uint8_t encoded[200U];
+    uint8_t reencoded[200U];
+    struct blink_stream stream;
+    Order order;
+    Order decoded;
+    uint32_t size;
+
+    order.set<Symbol>("IBM");
+    order.set<OrderSide>(Side::Sell);
+    order.set<Px>(blink::DecimalValue{-12345, -2});
+    order.set<Flags>(std::vector<bool>{true, false, true});
+    order.ref<Legs>().resize(2U);
+    order.ref<Legs>()[0].set<Qty>(1U);
+    order.ref<Legs>()[1].set<Qty>(2U);
+    order.ref<Legs>()[1].set<Venue>(std::array<uint8_t, 3U>{{'X', 'Y', 'Z'}});
+    order.ref<Any>().set<Symbol>("MSFT");
+    order.set<Time>(INT64_C(1234567890123));
+
+    assert_false(order.has<Limit>());
+    assert_false(order.has<Alt>());
+    assert_false(order.has<Note>());
+    assert_true(order.has<Any>());
+
+    assert_true(order.encodeCompact(BLINK_Stream_initBuffer(&stream, encoded, sizeof(encoded))));
+    size = BLINK_Stream_tell(&stream);
+
+    assert_int_equal(size, BLINK_Compact_sizeofUnsigned(order.sizeofBody() + 1U) + order.sizeofBody() + 1U);
+
+    assert_true(decoded.decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, encoded, size)));
+
+    assert_string_equal("IBM", decoded.get<Symbol>().c_str());
+    assert_true(decoded.get<OrderSide>() == Side::Sell);
+    assert_false(decoded.has<Limit>());
+    assert_int_equal(-12345, decoded.get<Px>().mantissa);
+    assert_int_equal(-2, decoded.get<Px>().exponent);
+    assert_true(decoded.get<Flags>() == (std::vector<bool>{true, false, true}));
+    assert_int_equal(2U, decoded.get<Legs>().size());
+    assert_false(decoded.get<Legs>()[0].has<Venue>());
+    assert_int_equal(2U, decoded.get<Legs>()[1].get<Qty>());
+    assert_true(decoded.get<Legs>()[1].has<Venue>());
+    assert_memory_equal("XYZ", decoded.get<Legs>()[1].get<Venue>().data(), 3U);
+    assert_false(decoded.has<Alt>());
+    assert_false(decoded.has<Note>());
+    assert_true(decoded.has<Any>());
+    assert_string_equal("MSFT", decoded.get<Any>().get<Symbol>().c_str());
+    assert_true(decoded.get<Time>() == INT64_C(1234567890123));
+
+    assert_true(decoded.encodeCompact(BLINK_Stream_initBuffer(&stream, reencoded, sizeof(reencoded))));
+    assert_int_equal(size, BLINK_Stream_tell(&stream));
+    assert_memory_equal(encoded, reencoded, size);
+
+    /* optional fields can be cleared */
+    decoded.clear<Any>();
+    decoded.set<Limit>(42U);
+
+    assert_true(decoded.encodeCompact(BLINK_Stream_initBuffer(&stream, reencoded, sizeof(reencoded))));
+    assert_true(order.decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, reencoded, BLINK_Stream_tell(&stream))));
+    assert_false(order.has<Any>());
+    assert_true(order.has<Limit>());
+    assert_int_equal(42U, order.get<Limit>());
+}
+
+static bool readUser(void *state, void *out, size_t bytesToRead)
+{
+    blink_stream_t in = (blink_stream_t)state;
+
+    return BLINK_Stream_read(in, out, bytesToRead);
+}
+
+static void test_decodeCompact_userStream(void **user)
+{
+    struct blink_stream buffer;
+    struct blink_stream stream;
+    struct blink_stream_user fn;
+    InsertOrder order;
+
+    (void)memset(&fn, 0, sizeof(fn));
+    fn.read = readUser;
+
+    (void)BLINK_Stream_initBufferReadOnly(&buffer, insertOrder, sizeof(insertOrder)-1U);
+
+    /* strings are copied when the stream cannot lend its buffer */
+    assert_true(order.decodeCompact(BLINK_Stream_initUser(&stream, &buffer, fn)));
+
+    assert_string_equal("IBM", order.get<Symbol>().c_str());
+    assert_string_equal("ABC123", order.get<OrderId>().c_str());
+    assert_int_equal(1000U, order.get<Quantity>());
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_encodeCompact),
+        cmocka_unit_test(test_decodeCompact),
+        cmocka_unit_test(test_decodeCompact_wrongGroup),
+        cmocka_unit_test(test_decodeCompact_truncated),
+        cmocka_unit_test(test_decodeCompact_extension),
+        cmocka_unit_test(test_roundTrip),
+        cmocka_unit_test(test_decodeCompact_userStream),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,232 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+#include "blink_object.h"
+#include "blink_stream.h"
+#include "blink_schema.h"
+
+#include <string.h>
+#include <malloc.h>
+
+static struct blink_allocator alloc = {
+    .calloc = calloc,
+    .free = free
+};
+
+static int setup(void **user)
+{
+    static const char input[] =
+        "Level ->\n"
+        "   u32 Price,\n"
+        "   u32 Qty\n"
+        "\n"
+        "Book/1 ->\n"
+        "   string Symbol,\n"
+        "   u32 [] Prices,\n"
+        "   string [] Names,\n"
+        "   Level [] Levels\n";
+
+    static struct blink_stream stream;
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
+    *user = (void *)BLINK_Schema_new(&alloc, &stream);
+    return 0;
+}
+
+static void test_BLINK_Object_appendUintByField(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Book");
+    blink_schema_t prices = BLINK_Group_getFieldByName(g, "Prices");
+    blink_object_t obj = BLINK_Object_newGroup(&alloc, g);
+    uint32_t i;
+
+    assert_true(obj != NULL);
+    assert_true(BLINK_Object_fieldIsNullByField(obj, prices));
+    assert_int_equal(0U, BLINK_Object_getSequenceSizeByField(obj, prices));
+
+    /* enough to grow the element array a few times */
+    for(i=0U; i < 100U; i++){
+
+        assert_true(BLINK_Object_appendUintByField(obj, prices, i * 10U));
+    }
+
+    assert_false(BLINK_Object_fieldIsNullByField(obj, prices));
+    assert_int_equal(100U, BLINK_Object_getSequenceSizeByField(obj, prices));
+
+    for(i=0U; i < 100U; i++){
+
+        assert_int_equal(i * 10U, BLINK_Object_getUintAtByField(obj, prices, i));
+    }
+
+    assert_true(BLINK_Object_setUintAtByField(obj, prices, 42U, 7U));
+    assert_int_equal(7U, BLINK_Object_getUintAtByField(obj, prices, 42U));
+
+    assert_false(BLINK_Object_setUintAtByField(obj, prices, 100U, 7U));
+    assert_int_equal(0U, BLINK_Object_getUintAtByField(obj, prices, 100U));
+
+    BLINK_Object_destroyGroup(&obj);
+}
+
+static void test_BLINK_Object_appendByField_notSequence(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Book");
+    blink_schema_t symbol = BLINK_Group_getFieldByName(g, "Symbol");
+    blink_schema_t prices = BLINK_Group_getFieldByName(g, "Prices");
+    blink_object_t obj = BLINK_Object_newGroup(&alloc, g);
+
+    assert_false(BLINK_Object_appendStringByField(obj, symbol, "IBM", 3U));
+    assert_false(BLINK_Object_setUintByField(obj, prices, 1U));
+
+    BLINK_Object_destroyGroup(&obj);
+}
+
+static void test_BLINK_Object_appendStringByField_reset(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Book");
+    blink_schema_t names = BLINK_Group_getFieldByName(g, "Names");
+    blink_object_t obj = BLINK_Object_newGroup(&alloc, g);
+    const char *str;
+    uint32_t len;
+
+    assert_true(BLINK_Object_appendStringByField(obj, names, "alpha", 5U));
+    assert_true(BLINK_Object_appendStringByField(obj, names, "beta", 4U));
+
+    BLINK_Object_reset(obj);
+
+    assert_true(BLINK_Object_fieldIsNullByField(obj, names));
+    assert_int_equal(0U, BLINK_Object_getSequenceSizeByField(obj, names));
+
+    assert_true(BLINK_Object_appendStringByField(obj, names, "gamma", 5U));
+    assert_int_equal(1U, BLINK_Object_getSequenceSizeByField(obj, names));
+
+    BLINK_Object_getStringAtByField(obj, names, 0U, &str, &len);
+    assert_int_equal(5U, len);
+    assert_memory_equal("gamma", str, len);
+
+    BLINK_Object_destroyGroup(&obj);
+}
+
+static void test_BLINK_Object_appendUintsByField(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Book");
+    blink_schema_t prices = BLINK_Group_getFieldByName(g, "Prices");
+    blink_schema_t names = BLINK_Group_getFieldByName(g, "Names");
+    blink_object_t obj = BLINK_Object_newGroup(&alloc, g);
+    const uint64_t values[] = {1U, 2U, 3U, 4U, 5U};
+    const int64_t signedValues[] = {-1};
+    uint32_t i;
+
+    assert_true(BLINK_Object_reserveByField(obj, prices, 1000U));
+    assert_true(BLINK_Object_fieldIsNullByField(obj, prices));
+
+    assert_true(BLINK_Object_appendUintsByField(obj, prices, values, 5U));
+    assert_true(BLINK_Object_appendUintByField(obj, prices, 6U));
+    assert_true(BLINK_Object_appendUintsByField(obj, prices, values, 5U));
+
+    assert_int_equal(11U, BLINK_Object_getSequenceSizeByField(obj, prices));
+
+    for(i=0U; i < 11U; i++){
+
+        assert_int_equal((i < 5U) ? (i + 1U) : ((i == 5U) ? 6U : (i - 5U)), BLINK_Object_getUintAtByField(obj, prices, i));
+    }
+
+    /* type must match */
+    assert_false(BLINK_Object_appendIntsByField(obj, prices, signedValues, 1U));
+    assert_false(BLINK_Object_appendUintsByField(obj, names, values, 1U));
+    assert_int_equal(11U, BLINK_Object_getSequenceSizeByField(obj, prices));
+
+    BLINK_Object_destroyGroup(&obj);
+}
+
+static void test_BLINK_Object_clearSequenceByField(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Book");
+    blink_schema_t prices = BLINK_Group_getFieldByName(g, "Prices");
+    blink_object_t obj = BLINK_Object_newGroup(&alloc, g);
+
+    assert_true(BLINK_Object_appendUintByField(obj, prices, 1U));
+    assert_true(BLINK_Object_appendUintByField(obj, prices, 2U));
+
+    /* empty but not NULL */
+    assert_true(BLINK_Object_clearSequenceByField(obj, prices));
+    assert_false(BLINK_Object_fieldIsNullByField(obj, prices));
+    assert_int_equal(0U, BLINK_Object_getSequenceSizeByField(obj, prices));
+
+    assert_true(BLINK_Object_appendUintByField(obj, prices, 3U));
+    assert_int_equal(1U, BLINK_Object_getSequenceSizeByField(obj, prices));
+    assert_int_equal(3U, BLINK_Object_getUintAtByField(obj, prices, 0U));
+
+    /* NULL */
+    assert_true(BLINK_Object_clearByField(obj, prices));
+    assert_true(BLINK_Object_fieldIsNullByField(obj, prices));
+    assert_int_equal(0U, BLINK_Object_getSequenceSizeByField(obj, prices));
+
+    assert_false(BLINK_Object_clearSequenceByField(obj, BLINK_Group_getFieldByName(g, "Symbol")));
+
+    BLINK_Object_destroyGroup(&obj);
+}
+
+static void test_BLINK_Object_appendGroupByField_roundtrip(void **user)
+{
+    blink_schema_t schema = (blink_schema_t)(*user);
+    blink_schema_t g = BLINK_Schema_getGroupByName(schema, "Book");
+    blink_schema_t l = BLINK_Schema_getGroupByName(schema, "Level");
+    blink_schema_t levels = BLINK_Group_getFieldByName(g, "Levels");
+    blink_schema_t qty = BLINK_Group_getFieldByName(l, "Qty");
+    blink_object_t obj = BLINK_Object_newGroup(&alloc, g);
+    blink_object_t decoded;
+    uint8_t buffer[100U];
+    struct blink_stream stream;
+    uint32_t i;
+
+    assert_true(BLINK_Object_setString(obj, "Symbol", "IBM", 3U));
+    assert_true(BLINK_Object_appendUintByField(obj, BLINK_Group_getFieldByName(g, "Prices"), 100U));
+
+    for(i=0U; i < 5U; i++){
+
+        blink_object_t level = BLINK_Object_newGroup(&alloc, l);
+
+        assert_true(BLINK_Object_setUint(level, "Price", 100U + i));
+        assert_true(BLINK_Object_setUintByField(level, qty, i));
+        assert_true(BLINK_Object_appendGroupByField(obj, levels, level));
+    }
+
+    /* Names is a mandatory sequence so must be initialised before encoding */
+    assert_false(BLINK_Object_encodeCompact(obj, BLINK_Stream_initBuffer(&stream, buffer, sizeof(buffer))));
+    assert_true(BLINK_Object_appendStringByField(obj, BLINK_Group_getFieldByName(g, "Names"), "x", 1U));
+
+    assert_true(BLINK_Object_encodeCompact(obj, BLINK_Stream_initBuffer(&stream, buffer, sizeof(buffer))));
+
+    decoded = BLINK_Object_decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, buffer, sizeof(buffer)), schema, &alloc);
+    assert_true(decoded != NULL);
+
+    assert_int_equal(1U, BLINK_Object_getSequenceSizeByField(decoded, BLINK_Group_getFieldByName(g, "Prices")));
+    assert_int_equal(5U, BLINK_Object_getSequenceSizeByField(decoded, levels));
+
+    for(i=0U; i < 5U; i++){
+
+        blink_object_t level = BLINK_Object_getGroupAtByField(decoded, levels, i);
+
+        assert_true(level != NULL);
+        assert_int_equal(100U + i, BLINK_Object_getUint(level, "Price"));
+        assert_int_equal(i, BLINK_Object_getUintByField(level, qty));
+    }
+
+    BLINK_Object_destroyGroup(&obj);
+    BLINK_Object_destroyGroup(&decoded);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_BLINK_Object_appendUintByField, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_appendByField_notSequence, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_appendStringByField_reset, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_appendUintsByField, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_clearSequenceByField, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_appendGroupByField_roundtrip, setup),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -31,7 +31,22 @@ static int setup(void **user)
         "   string OrderId\n"
         ""
         "OrderCanceled/4 ->\n"
-        "   string OrderId\n";
+        "   string OrderId\n"
+        ""
+        "Book/5 ->\n"
+        "   u32 [] Levels,\n"
+        "   i8 [] Deltas\n"
+        ""
+        "Leg ->\n"
+        "   u32 Qty,\n"
+        "   string Venue?\n"
+        ""
+        "Routed/6 ->\n"
+        "   string Symbol,\n"
+        "   Leg Leg,\n"
+        "   Leg [] Legs,\n"
+        "   CancelOrder* Cancel,\n"
+        "   u32 Qty\n";
     
     struct blink_stream stream;
     (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
@@ -74,10 +89,224 @@ static void test_BLINK_Object_decodeCompact(void **user)
     assert_int_equal(1000U, BLINK_Object_getUint(group, "Quantity"));
 }
 
+static void test_BLINK_Object_decodeCompact_zeroCopy(void **user)
+{
+    struct blink_stream input;
+    const uint8_t buffer[] = "\x0F\x01\x03""IBM""\x06""ABC123""\x7D\xA8\x0F";
+    const struct blink_decode_options options = {.zeroCopy = true};
+    const char *symbol;
+    uint32_t symbolLen;
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, buffer, sizeof(buffer));
+
+    blink_object_t group = BLINK_Object_decodeCompactWithOptions(&input, (blink_schema_t)(*user), &alloc, &options);
+
+    assert_true(group != NULL);
+
+    /* value refers to the input buffer */
+    BLINK_Object_getString(group, "Symbol", &symbol, &symbolLen);
+    assert_int_equal(3U, symbolLen);
+    assert_true((const uint8_t *)symbol == &buffer[3]);
+
+    assert_int_equal(125U, BLINK_Object_getUint(group, "Price"));
+
+    /* overwriting a borrowed value must not free the input buffer */
+    assert_true(BLINK_Object_setString2(group, "Symbol", "MSFT"));
+    BLINK_Object_getString(group, "Symbol", &symbol, &symbolLen);
+    assert_int_equal(4U, symbolLen);
+    assert_memory_equal("MSFT", symbol, symbolLen);
+
+    BLINK_Object_destroyGroup(&group);
+}
+
+static void test_BLINK_Object_decodeCompact_integerSequence(void **user)
+{
+    struct blink_stream input;
+    struct blink_stream output;
+    uint8_t buffer[100];
+    uint8_t encoded[100];
+    uint32_t size = 0U;
+    uint8_t i;
+
+    /* long enough run of single byte values for the batch decoder */
+    buffer[size++] = 0x2EU;
+    buffer[size++] = 0x05U;
+    buffer[size++] = 40U;
+    for(i=0U; i < 39U; i++){
+        buffer[size++] = i;
+    }
+    buffer[size++] = 0xA8U;     /* 1000 */
+    buffer[size++] = 0x0FU;
+    buffer[size++] = 2U;
+    buffer[size++] = 0x7FU;     /* -1 */
+    buffer[size++] = 0x05U;
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, buffer, size);
+
+    blink_object_t group = BLINK_Object_decodeCompact(&input, (blink_schema_t)(*user), &alloc);
+    assert_true(group != NULL);
+
+    /* re-encoding must reproduce the input */
+    (void)BLINK_Stream_initBuffer(&output, encoded, sizeof(encoded));
+    assert_true(BLINK_Object_encodeCompact(group, &output));
+    assert_int_equal(size, BLINK_Stream_tell(&output));
+    assert_memory_equal(buffer, encoded, size);
+
+    BLINK_Object_destroyGroup(&group);
+}
+
+static void test_BLINK_Object_decodeCompact_integerSequence_range(void **user)
+{
+    struct blink_stream input;
+    const uint8_t buffer[] = "\x06\x05\x00\x02\x01\x80\x02";    /* Deltas = [1, 128] */
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, buffer, sizeof(buffer) - 1U);
+
+    assert_true(BLINK_Object_decodeCompact(&input, (blink_schema_t)(*user), &alloc) == NULL);
+}
+
+/* encode a Routed message with every field present */
+static uint32_t encodeRouted(blink_schema_t schema, uint8_t *buffer, uint32_t size)
+{
+    struct blink_stream output;
+    blink_schema_t routed = BLINK_Schema_getGroupByName(schema, "Routed");
+    blink_schema_t leg = BLINK_Schema_getGroupByName(schema, "Leg");
+    blink_schema_t cancel = BLINK_Schema_getGroupByName(schema, "CancelOrder");
+    blink_object_t group = BLINK_Object_newGroup(&alloc, routed);
+    blink_object_t value;
+    uint32_t i;
+
+    assert_true(group != NULL);
+
+    assert_true(BLINK_Object_setString2(group, "Symbol", "IBM"));
+
+    value = BLINK_Object_newGroup(&alloc, leg);
+    assert_true(BLINK_Object_setUint(value, "Qty", 1U));
+    assert_true(BLINK_Object_setString2(value, "Venue", "XLON"));
+    assert_true(BLINK_Object_setGroup(group, "Leg", value));
+
+    for(i=0U; i < 3U; i++){
+
+        value = BLINK_Object_newGroup(&alloc, leg);
+        assert_true(BLINK_Object_setUint(value, "Qty", i));
+        assert_true(BLINK_Object_appendGroupByField(group, BLINK_Group_getFieldByName(routed, "Legs"), value));
+    }
+
+    value = BLINK_Object_newGroup(&alloc, cancel);
+    assert_true(BLINK_Object_setString2(value, "OrderId", "ABC123"));
+    assert_true(BLINK_Object_setGroup(group, "Cancel", value));
+
+    assert_true(BLINK_Object_setUint(group, "Qty", 1000U));
+
+    (void)BLINK_Stream_initBuffer(&output, buffer, size);
+    assert_true(BLINK_Object_encodeCompact(group, &output));
+
+    BLINK_Object_destroyGroup(&group);
+
+    return (uint32_t)BLINK_Stream_tell(&output);
+}
+
+static void test_BLINK_Object_decodeCompact_mask(void **user)
+{
+    blink_schema_t schema = (blink_schema_t)(*user);
+    blink_schema_t routed = BLINK_Schema_getGroupByName(schema, "Routed");
+    struct blink_stream input;
+    struct blink_field_mask mask;
+    uint8_t buffer[100];
+    uint32_t size = encodeRouted(schema, buffer, sizeof(buffer));
+    const char *symbol;
+    uint32_t symbolLen;
+
+    assert_true(BLINK_Object_initMask(&mask, routed));
+    assert_true(BLINK_Object_maskSelect(&mask, "Symbol"));
+    assert_true(BLINK_Object_maskSelectByField(&mask, BLINK_Group_getFieldByName(routed, "Qty")));
+
+    /* fields of other groups cannot be selected */
+    assert_false(BLINK_Object_maskSelect(&mask, "OrderId"));
+    assert_false(BLINK_Object_maskSelectByField(&mask, BLINK_Group_getFieldByName(BLINK_Schema_getGroupByName(schema, "Leg"), "Qty")));
+
+    const struct blink_decode_options options = {.mask = &mask};
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, buffer, size);
+
+    blink_object_t group = BLINK_Object_decodeCompactWithOptions(&input, schema, &alloc, &options);
+    assert_true(group != NULL);
+    assert_int_equal(size, BLINK_Stream_tell(&input));
+
+    BLINK_Object_getString(group, "Symbol", &symbol, &symbolLen);
+    assert_int_equal(3U, symbolLen);
+    assert_memory_equal("IBM", symbol, symbolLen);
+    assert_int_equal(1000U, BLINK_Object_getUint(group, "Qty"));
+
+    /* skipped fields are left NULL */
+    assert_true(BLINK_Object_fieldIsNull(group, "Leg"));
+    assert_true(BLINK_Object_fieldIsNull(group, "Legs"));
+    assert_true(BLINK_Object_fieldIsNull(group, "Cancel"));
+
+    /* decoding into the same group applies the mask too */
+    (void)BLINK_Stream_initBufferReadOnly(&input, buffer, size);
+
+    assert_true(BLINK_Object_decodeCompactInto(&input, schema, group, &options));
+    assert_int_equal(1000U, BLINK_Object_getUint(group, "Qty"));
+    assert_true(BLINK_Object_fieldIsNull(group, "Legs"));
+
+    BLINK_Object_destroyGroup(&group);
+}
+
+static void test_BLINK_Object_decodeCompact_mask_zeroSizeGroup(void **user)
+{
+    blink_schema_t schema = (blink_schema_t)(*user);
+    struct blink_stream input;
+    struct blink_field_mask mask;
+    /* Routed with a zero size preamble for Cancel */
+    const uint8_t buffer[] = "\x08\x06\x01""A""\x01\xC0\x00\x00\x01";
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, buffer, sizeof(buffer)-1U);
+    assert_true(BLINK_Object_decodeCompact(&input, schema, &alloc) == NULL);
+
+    /* skipping the field must reject it too */
+    assert_true(BLINK_Object_initMask(&mask, BLINK_Schema_getGroupByName(schema, "Routed")));
+    assert_true(BLINK_Object_maskSelect(&mask, "Qty"));
+
+    const struct blink_decode_options options = {.mask = &mask};
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, buffer, sizeof(buffer)-1U);
+    assert_true(BLINK_Object_decodeCompactWithOptions(&input, schema, &alloc, &options) == NULL);
+}
+
+static void test_BLINK_Object_decodeCompact_mask_otherGroup(void **user)
+{
+    blink_schema_t schema = (blink_schema_t)(*user);
+    struct blink_stream input;
+    struct blink_field_mask mask;
+    const uint8_t buffer[] = "\x0F\x01\x03""IBM""\x06""ABC123""\x7D\xA8\x0F";
+
+    /* mask for a group that is not the one on the wire */
+    assert_true(BLINK_Object_initMask(&mask, BLINK_Schema_getGroupByName(schema, "Routed")));
+
+    const struct blink_decode_options options = {.mask = &mask};
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, buffer, sizeof(buffer));
+
+    blink_object_t group = BLINK_Object_decodeCompactWithOptions(&input, schema, &alloc, &options);
+    assert_true(group != NULL);
+
+    assert_int_equal(125U, BLINK_Object_getUint(group, "Price"));
+    assert_false(BLINK_Object_fieldIsNull(group, "OrderId"));
+
+    BLINK_Object_destroyGroup(&group);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_setup(test_BLINK_Object_decodeCompact, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_decodeCompact_zeroCopy, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_decodeCompact_integerSequence, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_decodeCompact_integerSequence_range, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_decodeCompact_mask, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_decodeCompact_mask_zeroSizeGroup, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_decodeCompact_mask_otherGroup, setup),
     };
     
     return cmocka_run_group_tests(tests, NULL, NULL);
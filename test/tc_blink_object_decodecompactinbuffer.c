@@ -0,0 +1,202 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+
+#include "cmocka.h"
+#include "blink_object.h"
+#include "blink_stream.h"
+#include "blink_schema.h"
+
+#include <malloc.h>
+
+static struct blink_allocator alloc = {
+    .calloc = calloc,
+    .free = free
+};
+
+static int setup(void **user)
+{
+    static const char input[] =
+        "Level ->\n"
+        "   u32 Price,\n"
+        "   u32 Qty\n"
+        "\n"
+        "Book/1 ->\n"
+        "   string Symbol,\n"
+        "   u32 [] Prices,\n"
+        "   Level [] Levels\n"
+        "\n"
+        "Quote/2 ->\n"
+        "   string (8) Symbol,\n"
+        "   u32 Bid,\n"
+        "   Level Best\n"
+        "\n"
+        "Wrap/3 ->\n"
+        "   Level* Any\n"
+        "\n"
+        "Optional/4 ->\n"
+        "   fixed (2) [] Codes?,\n"
+        "   Level [] Levels?,\n"
+        "   u8 X\n";
+
+    struct blink_stream stream;
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
+    *user = (void *)BLINK_Schema_new(&alloc, &stream);
+    return 0;
+}
+
+static void test_BLINK_Object_getDecodeBound(void **user)
+{
+    blink_schema_t schema = (blink_schema_t)(*user);
+    size_t size = 0U;
+
+    assert_true(BLINK_Object_getDecodeBound(BLINK_Schema_getGroupByName(schema, "Quote"), &size));
+    assert_true(size > 0U);
+
+    /* size depends on the message */
+    assert_false(BLINK_Object_getDecodeBound(BLINK_Schema_getGroupByName(schema, "Book"), &size));
+    assert_false(BLINK_Object_getDecodeBound(BLINK_Schema_getGroupByName(schema, "Wrap"), &size));
+}
+
+static void test_BLINK_Object_decodeCompactInBuffer_bound(void **user)
+{
+    blink_schema_t schema = (blink_schema_t)(*user);
+    blink_schema_t q = BLINK_Schema_getGroupByName(schema, "Quote");
+    blink_object_t obj = BLINK_Object_newGroup(&alloc, q);
+    blink_object_t level = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName(schema, "Level"));
+    blink_object_t decoded;
+    uint64_t buffer[128U];
+    uint8_t encoded[100U];
+    struct blink_stream stream;
+    size_t size;
+    const char *str;
+    uint32_t len;
+
+    assert_true(BLINK_Object_setString(obj, "Symbol", "ABCDEFGH", 8U));
+    assert_true(BLINK_Object_setUint(obj, "Bid", 42U));
+    assert_true(BLINK_Object_setUint(level, "Price", 1U));
+    assert_true(BLINK_Object_setUint(level, "Qty", 2U));
+    assert_true(BLINK_Object_setGroup(obj, "Best", level));
+    assert_true(BLINK_Object_encodeCompact(obj, BLINK_Stream_initBuffer(&stream, encoded, sizeof(encoded))));
+
+    assert_true(BLINK_Object_getDecodeBound(q, &size));
+    assert_true(size <= sizeof(buffer));
+
+    decoded = BLINK_Object_decodeCompactInBuffer(BLINK_Stream_initBufferReadOnly(&stream, encoded, sizeof(encoded)), schema, buffer, size, NULL);
+    assert_true(decoded != NULL);
+
+    BLINK_Object_getString(decoded, "Symbol", &str, &len);
+    assert_int_equal(8U, len);
+    assert_memory_equal("ABCDEFGH", str, len);
+    assert_int_equal(42U, BLINK_Object_getUint(decoded, "Bid"));
+    assert_int_equal(2U, BLINK_Object_getUint(BLINK_Object_getGroup(decoded, "Best"), "Qty"));
+
+    BLINK_Object_destroyGroup(&obj);
+}
+
+static void test_BLINK_Object_sizeofDecodeCompact(void **user)
+{
+    blink_schema_t schema = (blink_schema_t)(*user);
+    blink_schema_t g = BLINK_Schema_getGroupByName(schema, "Book");
+    blink_schema_t l = BLINK_Schema_getGroupByName(schema, "Level");
+    blink_schema_t prices = BLINK_Group_getFieldByName(g, "Prices");
+    blink_schema_t levels = BLINK_Group_getFieldByName(g, "Levels");
+    blink_object_t obj = BLINK_Object_newGroup(&alloc, g);
+    blink_object_t decoded;
+    struct blink_decode_options options = {.zeroCopy = true};
+    uint64_t buffer[1024U];
+    uint8_t encoded[1000U];
+    struct blink_stream stream;
+    size_t size;
+    size_t zeroCopySize;
+    uint32_t i;
+
+    assert_true(BLINK_Object_setString(obj, "Symbol", "IBM", 3U));
+
+    for(i=0U; i < 100U; i++){
+
+        assert_true(BLINK_Object_appendUintByField(obj, prices, i));
+    }
+
+    for(i=0U; i < 5U; i++){
+
+        blink_object_t level = BLINK_Object_newGroup(&alloc, l);
+
+        assert_true(BLINK_Object_setUint(level, "Price", 100U + i));
+        assert_true(BLINK_Object_setUint(level, "Qty", i));
+        assert_true(BLINK_Object_appendGroupByField(obj, levels, level));
+    }
+
+    assert_true(BLINK_Object_encodeCompact(obj, BLINK_Stream_initBuffer(&stream, encoded, sizeof(encoded))));
+
+    assert_true(BLINK_Object_sizeofDecodeCompact(encoded, sizeof(encoded), schema, NULL, &size));
+    assert_true(size <= sizeof(buffer));
+
+    /* size is exact */
+    decoded = BLINK_Object_decodeCompactInBuffer(BLINK_Stream_initBufferReadOnly(&stream, encoded, sizeof(encoded)), schema, buffer, size - 1U, NULL);
+    assert_true(decoded == NULL);
+
+    decoded = BLINK_Object_decodeCompactInBuffer(BLINK_Stream_initBufferReadOnly(&stream, encoded, sizeof(encoded)), schema, buffer, size, NULL);
+    assert_true(decoded != NULL);
+
+    assert_int_equal(100U, BLINK_Object_getSequenceSizeByField(decoded, prices));
+    assert_int_equal(99U, BLINK_Object_getUintAtByField(decoded, prices, 99U));
+    assert_int_equal(5U, BLINK_Object_getSequenceSizeByField(decoded, levels));
+    assert_int_equal(104U, BLINK_Object_getUint(BLINK_Object_getGroupAtByField(decoded, levels, 4U), "Price"));
+
+    /* borrowed strings are not copied into the buffer */
+    assert_true(BLINK_Object_sizeofDecodeCompact(encoded, sizeof(encoded), schema, &options, &zeroCopySize));
+    assert_true(zeroCopySize < size);
+
+    decoded = BLINK_Object_decodeCompactInBuffer(BLINK_Stream_initBufferReadOnly(&stream, encoded, sizeof(encoded)), schema, buffer, zeroCopySize, &options);
+    assert_true(decoded != NULL);
+
+    BLINK_Object_destroyGroup(&obj);
+}
+
+static void test_BLINK_Object_sizeofDecodeCompact_truncated(void **user)
+{
+    const uint8_t input[] = {0x09, 0x01, 0x03, 'I', 'B', 'M', 0x03, 0x01, 0x02};
+    size_t size;
+
+    assert_false(BLINK_Object_sizeofDecodeCompact(input, sizeof(input), (blink_schema_t)(*user), NULL, &size));
+}
+
+static void test_BLINK_Object_sizeofDecodeCompact_optionalSequence(void **user)
+{
+    blink_schema_t schema = (blink_schema_t)(*user);
+    blink_schema_t g = BLINK_Schema_getGroupByName(schema, "Optional");
+    /* elements of optional sequences do not have a presence flag */
+    const uint8_t input[] = {0x0A, 0x04, 0x02, 'A', 'B', 'C', 'D', 0x01, 0x01, 0x02, 0x01};
+    uint64_t buffer[256U];
+    struct blink_stream stream;
+    blink_object_t decoded;
+    size_t size;
+
+    assert_true(BLINK_Object_sizeofDecodeCompact(input, sizeof(input), schema, NULL, &size));
+    assert_true(size <= sizeof(buffer));
+
+    decoded = BLINK_Object_decodeCompactInBuffer(BLINK_Stream_initBufferReadOnly(&stream, input, sizeof(input)), schema, buffer, size - 1U, NULL);
+    assert_true(decoded == NULL);
+
+    decoded = BLINK_Object_decodeCompactInBuffer(BLINK_Stream_initBufferReadOnly(&stream, input, sizeof(input)), schema, buffer, size, NULL);
+    assert_true(decoded != NULL);
+
+    assert_int_equal(2U, BLINK_Object_getSequenceSizeByField(decoded, BLINK_Group_getFieldByName(g, "Codes")));
+    assert_int_equal(1U, BLINK_Object_getSequenceSizeByField(decoded, BLINK_Group_getFieldByName(g, "Levels")));
+    assert_int_equal(1U, BLINK_Object_getUint(decoded, "X"));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_BLINK_Object_getDecodeBound, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_decodeCompactInBuffer_bound, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_sizeofDecodeCompact, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_sizeofDecodeCompact_truncated, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_sizeofDecodeCompact_optionalSequence, setup),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
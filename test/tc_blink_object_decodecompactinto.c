@@ -0,0 +1,129 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+
+#include "cmocka.h"
+#include "blink_object.h"
+#include "blink_stream.h"
+#include "blink_schema.h"
+
+#include <malloc.h>
+
+static struct blink_allocator alloc = {
+    .calloc = calloc,
+    .free = free
+};
+
+static int setup(void **user)
+{
+    static const char input[] =
+        "Leg ->\n"
+        "   u32 Qty\n"
+        "\n"
+        "InsertOrder/1 ->\n"
+        "   string Symbol,\n"
+        "   u32 Price,\n"
+        "   Leg Leg,\n"
+        "   u32 [] Fills\n"
+        "\n"
+        "Report/2 ->\n"
+        "   Fill* Last\n"
+        "\n"
+        "Fill/3 ->\n"
+        "   u32 Qty\n";
+
+    struct blink_stream stream;
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
+    *user = (void *)BLINK_Schema_new(&alloc, &stream);
+    return 0;
+}
+
+static void test_BLINK_Object_decodeCompactInto(void **user)
+{
+    struct blink_stream input;
+    const uint8_t first[] = "\x0A\x01\x03""IBM""\x7D\x0A\x02\x01\x02";
+    const uint8_t second[] = "\x08\x01\x02""GE""\x7D\x0B\x01\x05";
+    blink_schema_t schema = (blink_schema_t)(*user);
+    blink_object_t group = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName(schema, "InsertOrder"));
+    const char *str;
+    const char *prev;
+    uint32_t len;
+
+    assert_true(group != NULL);
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, first, sizeof(first));
+    assert_true(BLINK_Object_decodeCompactInto(&input, schema, group, NULL));
+
+    BLINK_Object_getString(group, "Symbol", &prev, &len);
+    assert_int_equal(3U, len);
+    assert_memory_equal("IBM", prev, len);
+    assert_int_equal(10U, BLINK_Object_getUint(BLINK_Object_getGroup(group, "Leg"), "Qty"));
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, second, sizeof(second));
+    assert_true(BLINK_Object_decodeCompactInto(&input, schema, group, NULL));
+
+    /* shorter string is decoded into the existing buffer */
+    BLINK_Object_getString(group, "Symbol", &str, &len);
+    assert_int_equal(2U, len);
+    assert_memory_equal("GE", str, len);
+    assert_true(str == prev);
+
+    assert_int_equal(125U, BLINK_Object_getUint(group, "Price"));
+    assert_int_equal(11U, BLINK_Object_getUint(BLINK_Object_getGroup(group, "Leg"), "Qty"));
+
+    BLINK_Object_destroyGroup(&group);
+}
+
+static void test_BLINK_Object_decodeCompactInto_dynamicGroup(void **user)
+{
+    struct blink_stream input;
+    const uint8_t first[] = "\x04\x02\x02\x03\x0A";
+    const uint8_t second[] = "\x04\x02\x02\x03\x0B";
+    blink_schema_t schema = (blink_schema_t)(*user);
+    blink_object_t group = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName(schema, "Report"));
+    blink_object_t last;
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, first, sizeof(first));
+    assert_true(BLINK_Object_decodeCompactInto(&input, schema, group, NULL));
+
+    last = BLINK_Object_getGroup(group, "Last");
+    assert_true(last != NULL);
+    assert_int_equal(10U, BLINK_Object_getUint(last, "Qty"));
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, second, sizeof(second));
+    assert_true(BLINK_Object_decodeCompactInto(&input, schema, group, NULL));
+
+    /* nested group of the same type is reused */
+    assert_true(last == BLINK_Object_getGroup(group, "Last"));
+    assert_int_equal(11U, BLINK_Object_getUint(last, "Qty"));
+
+    BLINK_Object_destroyGroup(&group);
+}
+
+static void test_BLINK_Object_decodeCompactInto_wrongGroup(void **user)
+{
+    struct blink_stream input;
+    const uint8_t buffer[] = "\x04\x02\x02\x03\x0A";
+    blink_schema_t schema = (blink_schema_t)(*user);
+    blink_object_t group = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName(schema, "InsertOrder"));
+
+    assert_true(BLINK_Object_setUint(group, "Price", 125U));
+
+    (void)BLINK_Stream_initBufferReadOnly(&input, buffer, sizeof(buffer));
+    assert_false(BLINK_Object_decodeCompactInto(&input, schema, group, NULL));
+    assert_true(BLINK_Object_fieldIsNull(group, "Price"));
+
+    BLINK_Object_destroyGroup(&group);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_BLINK_Object_decodeCompactInto, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_decodeCompactInto_dynamicGroup, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_decodeCompactInto_wrongGroup, setup),
+    };
+    
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -31,7 +31,11 @@ static int setup(void **user)
         "   string OrderId\n"
         ""
         "OrderCanceled/4 ->\n"
-        "   string OrderId\n";
+        "   string OrderId\n"
+        ""
+        "Batch/5 ->\n"
+        "   string Note,\n"
+        "   InsertOrder* Order?\n";
     
     static struct blink_stream stream;
     (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
@@ -54,16 +58,104 @@ static void test_BLINK_Object_encodeCompact(void **user)
     BLINK_Object_setUint(group, "Price", 125U);
     BLINK_Object_setUint(group, "Quantity", 1000U);
 
-    BLINK_Object_encodeCompact(group, &output);
+    assert_true(BLINK_Object_encodeCompact(group, &output));
 
     assert_int_equal(sizeof(expected)-1U, BLINK_Stream_tell(&output));
     assert_memory_equal(expected, buffer, sizeof(expected)-1U);
 }
 
+struct user_buffer {
+    uint8_t data[400];
+    size_t pos;
+};
+
+static bool userWrite(void *state, const void *in, size_t bytesToWrite)
+{
+    struct user_buffer *self = (struct user_buffer *)state;
+    bool retval = false;
+
+    if((sizeof(self->data) - self->pos) >= bytesToWrite){
+
+        (void)memcpy(&self->data[self->pos], in, bytesToWrite);
+        self->pos += bytesToWrite;
+        retval = true;
+    }
+
+    return retval;
+}
+
+static void test_BLINK_Object_encodeCompact_nested(void **user)
+{
+    uint8_t buffer[400];
+    char note[200];
+    struct blink_stream output;
+    struct blink_stream userOutput;
+    struct blink_stream_user fn = {.write = userWrite};
+    static struct user_buffer userBuffer;
+    blink_schema_t schema = (blink_schema_t)(*user);
+
+    blink_object_t order = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName(schema, "InsertOrder"));
+    blink_object_t batch = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName(schema, "Batch"));
+
+    (void)memset(note, 'x', sizeof(note));
+
+    assert_true(BLINK_Object_setString2(order, "Symbol", "IBM"));
+    assert_true(BLINK_Object_setString(order, "OrderId", note, 150U));
+    assert_true(BLINK_Object_setUint(order, "Price", 125U));
+    assert_true(BLINK_Object_setUint(order, "Quantity", 1000U));
+    assert_true(BLINK_Object_setString(batch, "Note", note, 100U));
+    assert_true(BLINK_Object_setGroup(batch, "Order", order));
+
+    /* size preambles are wider than the single byte initially reserved */
+    (void)BLINK_Stream_initBuffer(&output, buffer, sizeof(buffer));
+    assert_true(BLINK_Object_encodeCompact(batch, &output));
+
+    /* must match output of the two pass encoder */
+    (void)BLINK_Stream_initUser(&userOutput, &userBuffer, fn);
+    assert_true(BLINK_Object_encodeCompact(batch, &userOutput));
+
+    assert_int_equal(userBuffer.pos, BLINK_Stream_tell(&output));
+    assert_memory_equal(userBuffer.data, buffer, userBuffer.pos);
+
+    /* size preamble of outer group */
+    assert_int_equal(0x80U | ((BLINK_Stream_tell(&output) - 2U) & 0x3fU), buffer[0]);
+    assert_int_equal((BLINK_Stream_tell(&output) - 2U) >> 6, buffer[1]);
+
+    /* round trip */
+    struct blink_stream input;
+    (void)BLINK_Stream_initBufferReadOnly(&input, buffer, BLINK_Stream_tell(&output));
+    blink_object_t decoded = BLINK_Object_decodeCompact(&input, schema, &alloc);
+
+    assert_true(decoded != NULL);
+    assert_int_equal(1000U, BLINK_Object_getUint(BLINK_Object_getGroup(decoded, "Order"), "Quantity"));
+
+    BLINK_Object_destroyGroup(&decoded);
+
+    BLINK_Object_destroyGroup(&batch);
+}
+
+static void test_BLINK_Object_encodeCompact_uninitialised(void **user)
+{
+    uint8_t buffer[100];
+    struct blink_stream output;
+
+    (void)BLINK_Stream_initBuffer(&output, buffer, sizeof(buffer));
+
+    blink_object_t group = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder"));
+
+    BLINK_Object_setString2(group, "Symbol", "IBM");
+
+    assert_false(BLINK_Object_encodeCompact(group, &output));
+
+    BLINK_Object_destroyGroup(&group);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_setup(test_BLINK_Object_encodeCompact, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_encodeCompact_nested, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_encodeCompact_uninitialised, setup),
     };
     
     return cmocka_run_group_tests(tests, NULL, NULL);
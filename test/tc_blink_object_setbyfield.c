@@ -0,0 +1,145 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+#include "blink_object.h"
+#include "blink_stream.h"
+#include "blink_schema.h"
+
+#include <string.h>
+#include <malloc.h>
+
+static struct blink_allocator alloc = {
+    .calloc = calloc,
+    .free = free
+};
+
+static int setup(void **user)
+{
+    static const char input[] =
+        "Side = Buy | Sell\n"
+        "\n"
+        "Venue = Lit | Dark\n"
+        "\n"
+        "Order ->\n"
+        "   string OrderId\n"
+        "\n"
+        "InsertOrder/1 : Order ->\n"
+        "   string Symbol,\n"
+        "   u32 Price,\n"
+        "   Side Side\n"
+        "\n"
+        "CancelOrder/2 : Order ->\n"
+        "   bool Force,\n"
+        "   Venue Venue\n";
+
+    static struct blink_stream stream;
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
+    *user = (void *)BLINK_Schema_new(&alloc, &stream);
+    return 0;
+}
+
+static void test_BLINK_Object_setUintByField(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder");
+    blink_schema_t price = BLINK_Group_getFieldByName(g, "Price");
+    blink_object_t obj = BLINK_Object_newGroup(&alloc, g);
+
+    assert_true(obj != NULL);
+    assert_true(BLINK_Object_fieldIsNullByField(obj, price));
+    assert_true(BLINK_Object_setUintByField(obj, price, 125U));
+    assert_false(BLINK_Object_fieldIsNullByField(obj, price));
+    assert_int_equal(125U, BLINK_Object_getUintByField(obj, price));
+    assert_int_equal(125U, BLINK_Object_getUint(obj, "Price"));
+
+    BLINK_Object_destroyGroup(&obj);
+}
+
+static void test_BLINK_Object_setStringByField_overwrite(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder");
+    blink_schema_t symbol = BLINK_Group_getFieldByName(g, "Symbol");
+    blink_object_t obj = BLINK_Object_newGroup(&alloc, g);
+    const char *str;
+    uint32_t len;
+
+    assert_true(BLINK_Object_setStringByField(obj, symbol, "IBM", 3U));
+    assert_true(BLINK_Object_setStringByField(obj, symbol, "MSFT", 4U));
+
+    BLINK_Object_getStringByField(obj, symbol, &str, &len);
+    assert_int_equal(4U, len);
+    assert_memory_equal("MSFT", str, len);
+
+    BLINK_Object_destroyGroup(&obj);
+}
+
+static void test_BLINK_Object_setStringByField_inherited(void **user)
+{
+    blink_schema_t base = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "Order");
+    blink_schema_t orderId = BLINK_Group_getFieldByName(base, "OrderId");
+    blink_object_t insert = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder"));
+    blink_object_t cancel = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName((blink_schema_t)(*user), "CancelOrder"));
+    const char *str;
+    uint32_t len;
+
+    /* handle from supergroup is valid for every subgroup */
+    assert_true(BLINK_Object_setStringByField(insert, orderId, "ABC123", 6U));
+    assert_true(BLINK_Object_setStringByField(cancel, orderId, "ABC123", 6U));
+
+    BLINK_Object_getString(cancel, "OrderId", &str, &len);
+    assert_int_equal(6U, len);
+    assert_memory_equal("ABC123", str, len);
+
+    BLINK_Object_destroyGroup(&insert);
+    BLINK_Object_destroyGroup(&cancel);
+}
+
+static void test_BLINK_Object_setUintByField_wrongGroup(void **user)
+{
+    blink_schema_t price = BLINK_Group_getFieldByName(BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder"), "Price");
+    blink_object_t cancel = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName((blink_schema_t)(*user), "CancelOrder"));
+
+    assert_false(BLINK_Object_setUintByField(cancel, price, 125U));
+
+    BLINK_Object_destroyGroup(&cancel);
+}
+
+static void test_BLINK_Object_setEnumByField(void **user)
+{
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), "InsertOrder");
+    blink_schema_t side = BLINK_Group_getFieldByName(g, "Side");
+    blink_schema_t sell = BLINK_Enum_getSymbolByName(BLINK_Field_getEnum(side), "Sell");
+    blink_object_t obj = BLINK_Object_newGroup(&alloc, g);
+
+    assert_true(sell != NULL);
+    assert_true(BLINK_Object_setEnumByField(obj, side, sell));
+    assert_string_equal("Sell", BLINK_Object_getEnumByField(obj, side));
+
+    assert_true(BLINK_Object_setEnum(obj, "Side", "Buy"));
+    assert_string_equal("Buy", BLINK_Object_getEnum(obj, "Side"));
+
+    assert_false(BLINK_Object_setEnum(obj, "Side", "Hold"));
+
+    /* symbols of another enum are rejected even when the value matches */
+    blink_schema_t dark = BLINK_Enum_getSymbolByName(BLINK_Field_getEnum(BLINK_Group_getFieldByName(BLINK_Schema_getGroupByName((blink_schema_t)(*user), "CancelOrder"), "Venue")), "Dark");
+    assert_true(dark != NULL);
+    assert_int_equal(BLINK_Symbol_getValue(sell), BLINK_Symbol_getValue(dark));
+    assert_false(BLINK_Object_setEnumByField(obj, side, dark));
+    assert_string_equal("Buy", BLINK_Object_getEnumByField(obj, side));
+
+    BLINK_Object_destroyGroup(&obj);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_BLINK_Object_setUintByField, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_setStringByField_overwrite, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_setStringByField_inherited, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_setUintByField_wrongGroup, setup),
+        cmocka_unit_test_setup(test_BLINK_Object_setEnumByField, setup),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
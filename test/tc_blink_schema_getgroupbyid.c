@@ -77,6 +77,23 @@ static void test_BLINK_Schema_getGroupByID_orderCanceled(void **user)
     assert_true(g == BLINK_Schema_getGroupByName((blink_schema_t)(*user), name));
 }
 
+static void test_BLINK_Schema_getGroupByID_unknown(void **user)
+{
+    assert_true(BLINK_Schema_getGroupByID((blink_schema_t)(*user), 5) == NULL);
+    assert_true(BLINK_Schema_getGroupByID((blink_schema_t)(*user), 0) == NULL);
+}
+
+static void test_BLINK_Schema_getGroupByID_noGroupsWithID(void **user)
+{
+    static const char input[] = "empty";
+    struct blink_stream stream;
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
+    blink_schema_t schema = BLINK_Schema_new(&alloc, &stream);
+
+    assert_true(schema != NULL);
+    assert_true(BLINK_Schema_getGroupByID(schema, 0) == NULL);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -84,6 +101,8 @@ int main(void)
         cmocka_unit_test_setup(test_BLINK_Schema_getGroupByID_cancelOrder, setup),
         cmocka_unit_test_setup(test_BLINK_Schema_getGroupByID_orderInserted, setup),
         cmocka_unit_test_setup(test_BLINK_Schema_getGroupByID_orderCanceled, setup),
+        cmocka_unit_test_setup(test_BLINK_Schema_getGroupByID_unknown, setup),
+        cmocka_unit_test(test_BLINK_Schema_getGroupByID_noGroupsWithID),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
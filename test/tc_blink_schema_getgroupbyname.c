@@ -72,6 +72,28 @@ static void test_BLINK_Schema_getGroupByName_orderCanceled(void **user)
     assert_true(g != NULL);
 }
 
+static void test_BLINK_Schema_getGroupByName_prefix(void **user)
+{
+    const char name[] = "Insert";
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), name);
+    assert_true(g == NULL);
+}
+
+static void test_BLINK_Schema_getGroupByName_unknown(void **user)
+{
+    const char name[] = "InsertOrders";
+    blink_schema_t g = BLINK_Schema_getGroupByName((blink_schema_t)(*user), name);
+    assert_true(g == NULL);
+}
+
+static void test_BLINK_Schema_getGroupByKey(void **user)
+{
+    struct blink_name key = BLINK_Name_init("CancelOrder");
+    blink_schema_t g = BLINK_Schema_getGroupByKey((blink_schema_t)(*user), &key);
+    assert_true(g != NULL);
+    assert_true(g == BLINK_Schema_getGroupByName((blink_schema_t)(*user), "CancelOrder"));
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -79,6 +101,9 @@ int main(void)
         cmocka_unit_test_setup(test_BLINK_Schema_getGroupByName_cancelOrder, setup),
         cmocka_unit_test_setup(test_BLINK_Schema_getGroupByName_orderInserted, setup),
         cmocka_unit_test_setup(test_BLINK_Schema_getGroupByName_orderCanceled, setup),
+        cmocka_unit_test_setup(test_BLINK_Schema_getGroupByName_prefix, setup),
+        cmocka_unit_test_setup(test_BLINK_Schema_getGroupByName_unknown, setup),
+        cmocka_unit_test_setup(test_BLINK_Schema_getGroupByKey, setup),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
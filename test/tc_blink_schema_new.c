@@ -114,6 +114,35 @@ static void test_BLINK_Schema_new_greeting(void **user)
     assert_true(schema != NULL);    
 }
 
+static void test_BLINK_Schema_new_typeSuffixes(void **user)
+{
+    struct blink_stream stream;
+    const char input[] = 
+        "Message/0 ->\n"
+        "   string (8) Symbol,\n"
+        "   fixed (4) Code,\n"
+        "   u32 [] Prices,\n"
+        "   binary (16) [] Blobs";
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
+    blink_schema_t schema = BLINK_Schema_new(&alloc, &stream);
+    
+    assert_true(schema != NULL);    
+}
+
+static void test_BLINK_Schema_new_typedefChain(void **user)
+{
+    struct blink_stream stream;
+    const char input[] = 
+        "Price = Amount\n"
+        "Amount = u64\n"
+        "Code = fixed (4)\n"
+        "Message/0 -> Price Price, Code Code";
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
+    blink_schema_t schema = BLINK_Schema_new(&alloc, &stream);
+    
+    assert_true(schema != NULL);    
+}
+
 static void test_BLINK_Schema_new_namespace_emptyGroup(void **user)
 {
     struct blink_stream stream;
@@ -182,6 +211,18 @@ static void test_BLINK_Schema_new_duplicate_group_definition(void **user)
     assert_true(schema == NULL);    
 }
 
+static void test_BLINK_Schema_new_duplicate_group_id(void **user)
+{
+    struct blink_stream stream;
+    const char input[] =
+        "first/1 -> u8 field\n"
+        "second/1 -> u16 field";
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, sizeof(input));
+    blink_schema_t schema = BLINK_Schema_new(&alloc, &stream);
+
+    assert_true(schema == NULL);    
+}
+
 static void test_BLINK_Schema_new_duplicate_enum_definition(void **user)
 {
     struct blink_stream stream;
@@ -300,6 +341,7 @@ int main(void)
         cmocka_unit_test(test_BLINK_Schema_new_duplicate_type_definition),
         cmocka_unit_test(test_BLINK_Schema_new_duplicate_type_group_definition),
         cmocka_unit_test(test_BLINK_Schema_new_duplicate_group_definition),
+        cmocka_unit_test(test_BLINK_Schema_new_duplicate_group_id),
         cmocka_unit_test(test_BLINK_Schema_new_duplicate_enum_definition),
         cmocka_unit_test(test_BLINK_Schema_new_duplicate_enum_field),
         cmocka_unit_test(test_BLINK_Schema_new_ambiguous_enum_value),
@@ -309,6 +351,8 @@ int main(void)
         cmocka_unit_test(test_BLINK_Schema_new_superGroupShadowField),
         cmocka_unit_test(test_BLINK_Schema_new_superSuperGroupShadowField),
         cmocka_unit_test(test_BLINK_Schema_new_comments),
+        cmocka_unit_test(test_BLINK_Schema_new_typeSuffixes),
+        cmocka_unit_test(test_BLINK_Schema_new_typedefChain),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
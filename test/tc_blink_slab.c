@@ -0,0 +1,137 @@
+/**
+ * @example tc_blink_slab.c
+ *
+ * */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "cmocka.h"
+#include "blink_slab.h"
+#include "blink_schema.h"
+#include "blink_stream.h"
+#include "blink_object.h"
+#include <string.h>
+
+#include <malloc.h>
+
+static unsigned backingCalls;
+
+static void *countingCalloc(size_t nelem, size_t elsize)
+{
+    backingCalls++;
+    return calloc(nelem, elsize);
+}
+
+static struct blink_allocator backing = {
+    .calloc = countingCalloc,
+    .free = free
+};
+
+static int setup_slab(void **user)
+{
+    static struct blink_slab slab;
+    backingCalls = 0U;
+    *user = (blink_slab_t)BLINK_Slab_init(&slab, &backing);
+    return 0;
+}
+
+static int teardown_slab(void **user)
+{
+    BLINK_Slab_destroy((blink_slab_t)(*user));
+    return 0;
+}
+
+static void test_BLINK_Slab_calloc_zeroSize(void **user)
+{
+    assert_true(BLINK_Slab_calloc((blink_slab_t)(*user), 0U, 1U) == NULL);
+    assert_int_equal(0U, backingCalls);
+}
+
+static void test_BLINK_Slab_free_reuse(void **user)
+{
+    uint8_t *first = BLINK_Slab_calloc((blink_slab_t)(*user), 1U, 24U);
+    uint8_t *second = BLINK_Slab_calloc((blink_slab_t)(*user), 3U, 8U);
+
+    assert_true(first != NULL);
+    assert_true(second != NULL);
+    assert_ptr_not_equal(first, second);
+    assert_true(((size_t)first % offsetof(struct {char c; long double d;}, d)) == 0U);
+    assert_true(((size_t)second % offsetof(struct {char c; long double d;}, d)) == 0U);
+
+    (void)memset(first, 0xaa, 24U);
+    BLINK_Slab_free((blink_slab_t)(*user), first);
+
+    /* same size class gets the freed chunk back, zeroed */
+    assert_ptr_equal(first, BLINK_Slab_calloc((blink_slab_t)(*user), 1U, 20U));
+    assert_int_equal(0U, first[0]);
+    assert_int_equal(0U, first[23]);
+
+    /* one slab serves both */
+    assert_int_equal(1U, backingCalls);
+}
+
+static void test_BLINK_Slab_calloc_large(void **user)
+{
+    uint8_t *large = BLINK_Slab_calloc((blink_slab_t)(*user), 1U, 100000U);
+
+    assert_true(large != NULL);
+    assert_int_equal(1U, backingCalls);
+    assert_int_equal(0U, large[99999U]);
+    assert_true(((size_t)large % offsetof(struct {char c; long double d;}, d)) == 0U);
+
+    BLINK_Slab_free((blink_slab_t)(*user), large);
+}
+
+static void test_BLINK_Slab_getAllocator(void **user)
+{
+    static const char syntax[] =
+        "InsertOrder/1 ->\n"
+        "   string Symbol,\n"
+        "   u32 [] Prices\n";
+    static const uint8_t input[] = {0x09, 0x01, 0x03, 'I', 'B', 'M', 0x03, 0x01, 0x02, 0x03};
+
+    struct blink_allocator heap = {.calloc = calloc, .free = free};
+    struct blink_allocator alloc = BLINK_Slab_getAllocator((blink_slab_t)(*user));
+    struct blink_stream stream;
+    blink_schema_t schema;
+    blink_object_t obj;
+    unsigned warm = 0U;
+    int i;
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)syntax, sizeof(syntax));
+    schema = BLINK_Schema_new(&heap, &stream);
+    assert_true(schema != NULL);
+
+    for(i=0; i < 100; i++){
+
+        (void)BLINK_Stream_initBufferReadOnly(&stream, input, sizeof(input));
+        obj = BLINK_Object_decodeCompact(&stream, schema, &alloc);
+
+        assert_true(obj != NULL);
+        assert_int_equal(3U, BLINK_Object_getSequenceSizeByField(obj, BLINK_Group_getFieldByName(BLINK_Schema_getGroupByName(schema, "InsertOrder"), "Prices")));
+
+        BLINK_Object_destroyGroup(&obj);
+
+        if(i == 0){
+
+            warm = backingCalls;
+        }
+    }
+
+    /* steady state does not call the backing allocator */
+    assert_true(warm > 0U);
+    assert_int_equal(warm, backingCalls);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_BLINK_Slab_calloc_zeroSize, setup_slab, teardown_slab),
+        cmocka_unit_test_setup_teardown(test_BLINK_Slab_free_reuse, setup_slab, teardown_slab),
+        cmocka_unit_test_setup_teardown(test_BLINK_Slab_calloc_large, setup_slab, teardown_slab),
+        cmocka_unit_test_setup_teardown(test_BLINK_Slab_getAllocator, setup_slab, teardown_slab),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
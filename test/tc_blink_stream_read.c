@@ -53,12 +53,83 @@ static void test_BLINK_Stream_read_eof(void **user)
     assert_false(BLINK_Stream_read((blink_stream_t)(*user), out, sizeof(out)));
 }
 
+static void test_BLINK_Stream_borrow(void **user)
+{
+    const uint8_t *first = BLINK_Stream_borrow((blink_stream_t)(*user), 5U);
+    const uint8_t *second = BLINK_Stream_borrow((blink_stream_t)(*user), 5U);
+
+    assert_true(BLINK_Stream_canBorrow((blink_stream_t)(*user)));
+    assert_true(first != NULL);
+    assert_true(second == &first[5]);
+    assert_memory_equal(first, "helloworld", 10U);
+    assert_int_equal(10U, BLINK_Stream_tell((blink_stream_t)(*user)));
+}
+
+static void test_BLINK_Stream_borrow_eof(void **user)
+{
+    assert_true(BLINK_Stream_borrow((blink_stream_t)(*user), sizeof("helloworld")+1U) == NULL);
+    assert_true(BLINK_Stream_eof((blink_stream_t)(*user)));
+}
+
+static void test_BLINK_Stream_borrow_bounded(void **user)
+{
+    struct blink_stream bounded;
+    (void)BLINK_Stream_initBounded(&bounded, (blink_stream_t)(*user), 5U);
+
+    assert_true(BLINK_Stream_canBorrow(&bounded));
+    assert_true(BLINK_Stream_borrow(&bounded, 6U) == NULL);
+    assert_true(BLINK_Stream_borrow(&bounded, 5U) != NULL);
+    assert_int_equal(5U, BLINK_Stream_tell(&bounded));
+}
+
+static void test_BLINK_Stream_seekCur(void **user)
+{
+    assert_true(BLINK_Stream_seekCur((blink_stream_t)(*user), 5));
+    assert_int_equal(5U, BLINK_Stream_tell((blink_stream_t)(*user)));
+    assert_true(BLINK_Stream_seekCur((blink_stream_t)(*user), -2));
+    assert_int_equal(3U, BLINK_Stream_tell((blink_stream_t)(*user)));
+    assert_false(BLINK_Stream_seekCur((blink_stream_t)(*user), -4));
+    assert_false(BLINK_Stream_seekCur((blink_stream_t)(*user), INT64_MIN));
+    assert_false(BLINK_Stream_seekCur((blink_stream_t)(*user), sizeof("helloworld")));
+    assert_int_equal(3U, BLINK_Stream_tell((blink_stream_t)(*user)));
+}
+
+/* positions beyond 4GiB (nothing is read so the buffer can be short) */
+static void test_BLINK_Stream_seek_64bit(void **user)
+{
+    static const uint8_t buffer[1];
+    const uint64_t size = UINT64_C(6) << 30;
+    struct blink_stream stream;
+    struct blink_stream bounded;
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, buffer, size);
+    assert_true(BLINK_Stream_max(&stream) == size);
+
+    assert_true(BLINK_Stream_seekSet(&stream, UINT64_C(5) << 30));
+    assert_true(BLINK_Stream_tell(&stream) == (UINT64_C(5) << 30));
+    assert_true(BLINK_Stream_seekCur(&stream, INT64_C(1) << 30));
+    assert_true(BLINK_Stream_tell(&stream) == size);
+    assert_false(BLINK_Stream_seekCur(&stream, 1));
+    assert_true(BLINK_Stream_seekCur(&stream, -(INT64_C(6) << 30)));
+    assert_true(BLINK_Stream_tell(&stream) == 0U);
+
+    (void)BLINK_Stream_initBounded(&bounded, &stream, size);
+    assert_true(BLINK_Stream_max(&bounded) == size);
+    assert_true(BLINK_Stream_setMax(&bounded, UINT64_C(5) << 32));
+    assert_true(BLINK_Stream_max(&bounded) == (UINT64_C(5) << 32));
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_setup(test_BLINK_Stream_read_all, setupBuffer),        
         cmocka_unit_test_setup(test_BLINK_Stream_read_allParts, setupBuffer),        
         cmocka_unit_test_setup(test_BLINK_Stream_read_eof, setupBuffer),        
+        cmocka_unit_test_setup(test_BLINK_Stream_borrow, setupBuffer),
+        cmocka_unit_test_setup(test_BLINK_Stream_borrow_eof, setupBuffer),
+        cmocka_unit_test_setup(test_BLINK_Stream_borrow_bounded, setupBuffer),
+        cmocka_unit_test_setup(test_BLINK_Stream_seekCur, setupBuffer),
+        cmocka_unit_test(test_BLINK_Stream_seek_64bit),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
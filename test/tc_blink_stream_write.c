@@ -33,11 +33,21 @@ static void test_BLINK_Stream_write_eof(void **user)
     assert_false(BLINK_Stream_write((blink_stream_t)(*user), (const uint8_t *)in, sizeof(in)));
 }
 
+static void test_BLINK_Stream_writeRef(void **user)
+{
+    const char in[] = "helloworld";
+    
+    /* buffer streams copy */
+    assert_true(BLINK_Stream_writeRef((blink_stream_t)(*user), (const uint8_t *)in, sizeof(in)));
+    assert_false(BLINK_Stream_writeRef((blink_stream_t)(*user), (const uint8_t *)in, 1U));
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_setup(test_BLINK_Stream_write_all, setupBuffer),        
         cmocka_unit_test_setup(test_BLINK_Stream_write_eof, setupBuffer),        
+        cmocka_unit_test_setup(test_BLINK_Stream_writeRef, setupBuffer),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
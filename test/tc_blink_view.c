@@ -0,0 +1,267 @@
+/**
+ * @example tc_blink_view.c
+ *
+ * */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+
+#include "cmocka.h"
+#include "blink_view.h"
+#include "blink_object.h"
+#include "blink_stream.h"
+#include "blink_schema.h"
+#include "blink_compact.h"
+
+#include <malloc.h>
+
+static struct blink_allocator alloc = {
+    .calloc = calloc,
+    .free = free
+};
+
+static blink_schema_t schema;
+static blink_schema_t wide;
+static uint8_t encoded[200U];
+static size_t encodedLen;
+
+static blink_schema_t field(const char *name)
+{
+    return BLINK_Group_getFieldByName(wide, name);
+}
+
+static int setup(void **user)
+{
+    static const char syntax[] =
+        "Leg -> u32 Qty, string Venue?\n"
+        "Fill/2 -> u32 Qty\n"
+        "Wide/1 ->\n"
+        "   string Symbol,\n"
+        "   i8 Side,\n"
+        "   u32 Price?,\n"
+        "   decimal Px,\n"
+        "   bool Flag,\n"
+        "   fixed(2) Code?,\n"
+        "   Leg Leg?,\n"
+        "   Leg [] Legs,\n"
+        "   u32 [] Levels,\n"
+        "   Fill* Last,\n"
+        "   f64 Rate,\n"
+        "   u64 Seq\n";
+
+    struct blink_stream stream;
+    uint64_t levels[] = {1U, 200U, 3U};
+
+    schema = BLINK_Schema_new(&alloc, BLINK_Stream_initBufferReadOnly(&stream, syntax, sizeof(syntax)));
+    wide = BLINK_Schema_getGroupByName(schema, "Wide");
+
+    blink_object_t group = BLINK_Object_newGroup(&alloc, wide);
+    blink_object_t leg = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName(schema, "Leg"));
+    blink_object_t last = BLINK_Object_newGroup(&alloc, BLINK_Schema_getGroupByName(schema, "Fill"));
+
+    (void)BLINK_Object_setUint(leg, "Qty", 5U);
+    (void)BLINK_Object_setString2(leg, "Venue", "XLON");
+    (void)BLINK_Object_setUint(last, "Qty", 9U);
+
+    (void)BLINK_Object_setString2(group, "Symbol", "IBM");
+    (void)BLINK_Object_setInt(group, "Side", -1);
+    (void)BLINK_Object_setDecimal(group, "Px", 12345, -2);
+    (void)BLINK_Object_setBool(group, "Flag", true);
+    (void)BLINK_Object_setFixed(group, "Code", (const uint8_t *)"AB", 2U);
+    (void)BLINK_Object_setGroup(group, "Leg", leg);
+    (void)BLINK_Object_appendGroupByField(group, field("Legs"), leg);
+    (void)BLINK_Object_appendGroupByField(group, field("Legs"), leg);
+    (void)BLINK_Object_appendUintsByField(group, field("Levels"), levels, 3U);
+    (void)BLINK_Object_setGroup(group, "Last", last);
+    (void)BLINK_Object_setF64(group, "Rate", 0.0);
+    (void)BLINK_Object_setUint(group, "Seq", UINT64_C(0x123456789));
+
+    if(!BLINK_Object_encodeCompact(group, BLINK_Stream_initBuffer(&stream, encoded, sizeof(encoded)))){
+
+        return -1;
+    }
+
+    encodedLen = (size_t)BLINK_Stream_tell(&stream);
+
+    return 0;
+}
+
+static void test_BLINK_View_getByField(void **user)
+{
+    struct blink_view view;
+    const uint8_t *data;
+    uint32_t len;
+    uint64_t u;
+    int64_t i;
+    int64_t mantissa;
+    int8_t exponent;
+    bool b;
+    double d;
+    bool isNull;
+
+    assert_true(BLINK_View_init(&view, schema, encoded, encodedLen));
+    assert_ptr_equal(wide, view.group);
+
+    /* last field first */
+    assert_true(BLINK_View_getUintByField(&view, field("Seq"), &u, &isNull));
+    assert_false(isNull);
+    assert_true(u == UINT64_C(0x123456789));
+    assert_int_equal(view.numberOfFields, view.located);
+
+    assert_true(BLINK_View_getStringByField(&view, field("Symbol"), &data, &len, &isNull));
+    assert_false(isNull);
+    assert_int_equal(3U, len);
+    assert_memory_equal("IBM", data, len);
+
+    /* strings are not copied */
+    assert_true((data > encoded) && (data < &encoded[encodedLen]));
+
+    assert_true(BLINK_View_getIntByField(&view, field("Side"), &i, &isNull));
+    assert_int_equal(-1, i);
+
+    assert_true(BLINK_View_getUintByField(&view, field("Price"), &u, &isNull));
+    assert_true(isNull);
+    assert_true(BLINK_View_fieldIsNullByField(&view, field("Price"), &isNull));
+    assert_true(isNull);
+
+    assert_true(BLINK_View_getDecimalByField(&view, field("Px"), &mantissa, &exponent, &isNull));
+    assert_int_equal(12345, mantissa);
+    assert_int_equal(-2, exponent);
+
+    assert_true(BLINK_View_getBoolByField(&view, field("Flag"), &b, &isNull));
+    assert_true(b);
+
+    assert_true(BLINK_View_getStringByField(&view, field("Code"), &data, &len, &isNull));
+    assert_false(isNull);
+    assert_int_equal(2U, len);
+    assert_memory_equal("AB", data, len);
+
+    assert_true(BLINK_View_getF64ByField(&view, field("Rate"), &d, &isNull));
+    assert_true(d == 0.0);
+
+    /* wrong type */
+    assert_false(BLINK_View_getIntByField(&view, field("Symbol"), &i, &isNull));
+    assert_false(BLINK_View_getUintByField(&view, field("Levels"), &u, &isNull));
+}
+
+static void test_BLINK_View_getEncodedByField(void **user)
+{
+    struct blink_view view;
+    struct blink_stream stream;
+    const uint8_t *data;
+    size_t len;
+    uint64_t values[3U];
+    uint32_t n;
+    bool isNull;
+
+    assert_true(BLINK_View_init(&view, schema, encoded, encodedLen));
+
+    assert_true(BLINK_View_getEncodedByField(&view, field("Levels"), &data, &len));
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, data, len);
+    assert_true(BLINK_Compact_decodeU32(&stream, &n, &isNull));
+    assert_int_equal(3U, n);
+    assert_true(BLINK_Compact_decodeU64Array(&stream, values, n));
+    assert_int_equal(200U, values[1]);
+    assert_true(BLINK_Stream_tell(&stream) == len);
+
+    /* fields before Levels were located on the way */
+    assert_int_equal(BLINK_Field_getIndex(field("Levels")) + 1U, view.located);
+
+    assert_true(BLINK_View_getEncodedByField(&view, field("Last"), &data, &len));
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, data, len);
+    blink_object_t last = BLINK_Object_decodeCompact(&stream, schema, &alloc);
+    assert_true(last != NULL);
+    assert_int_equal(9U, BLINK_Object_getUint(last, "Qty"));
+    BLINK_Object_destroyGroup(&last);
+}
+
+static void test_BLINK_View_init_invalid(void **user)
+{
+    struct blink_view view;
+    uint8_t copy[sizeof(encoded)];
+
+    /* truncated */
+    assert_false(BLINK_View_init(&view, schema, encoded, encodedLen - 1U));
+
+    /* unknown group */
+    (void)memcpy(copy, encoded, encodedLen);
+    assert_true(encoded[0] < 0x80U);
+    copy[1] = 0x7fU;
+    assert_false(BLINK_View_init(&view, schema, copy, encodedLen));
+}
+
+static void test_BLINK_View_truncatedField(void **user)
+{
+    /* Wide with Symbol length overrunning the message */
+    const uint8_t input[] = "\x03\x01\x09""A";
+    struct blink_view view;
+    const uint8_t *data;
+    uint32_t len;
+    bool isNull;
+
+    assert_true(BLINK_View_init(&view, schema, input, sizeof(input)-1U));
+    assert_false(BLINK_View_getStringByField(&view, field("Symbol"), &data, &len, &isNull));
+    assert_int_equal(0U, view.located);
+}
+
+static void test_BLINK_View_outOfRange(void **user)
+{
+    /* Wide with Side = 128 which does not fit an i8 */
+    const uint8_t input[] = "\x05\x01\x01""A""\x80\x02";
+    struct blink_view view;
+    int64_t value = 42;
+    bool isNull;
+
+    assert_true(BLINK_View_init(&view, schema, input, sizeof(input)-1U));
+    assert_false(BLINK_View_getIntByField(&view, field("Side"), &value, &isNull));
+
+    /* output is left untouched on failure */
+    assert_int_equal(42, value);
+}
+
+static void test_BLINK_View_zeroSizeGroup(void **user)
+{
+    /* Wide with a zero size preamble for Last */
+    const uint8_t input[] = "\x0F\x01\x01""A""\x00\xC0\x00\x00\x00\xC0\xC0\x00\x00\x00\x00\x00";
+    struct blink_view view;
+    uint64_t value;
+    bool isNull;
+
+    assert_true(BLINK_View_init(&view, schema, input, sizeof(input)-1U));
+    assert_true(BLINK_View_getUintByField(&view, field("Price"), &value, &isNull));
+    assert_true(isNull);
+
+    /* as rejected by BLINK_Object_decodeCompact() */
+    assert_false(BLINK_View_getUintByField(&view, field("Seq"), &value, &isNull));
+}
+
+static void test_BLINK_View_wrongGroup(void **user)
+{
+    const uint8_t input[] = "\x02\x02\x01";
+    struct blink_view view;
+    const uint8_t *data;
+    uint32_t len;
+    bool isNull;
+
+    assert_true(BLINK_View_init(&view, schema, input, sizeof(input)-1U));
+    assert_false(BLINK_View_getStringByField(&view, field("Symbol"), &data, &len, &isNull));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_BLINK_View_getByField),
+        cmocka_unit_test(test_BLINK_View_getEncodedByField),
+        cmocka_unit_test(test_BLINK_View_init_invalid),
+        cmocka_unit_test(test_BLINK_View_truncatedField),
+        cmocka_unit_test(test_BLINK_View_outOfRange),
+        cmocka_unit_test(test_BLINK_View_zeroSizeGroup),
+        cmocka_unit_test(test_BLINK_View_wrongGroup),
+    };
+
+    return cmocka_run_group_tests(tests, setup, NULL);
+}
@@ -0,0 +1,274 @@
+/* Copyright (c) 2016 Cameron Harper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *
+ * */
+
+/**
+ * @example tc_blinkc.c
+ *
+ * Code generated by blinkc from tc_blinkc.blink
+ *
+ * */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "cmocka.h"
+#include "blink_object.h"
+#include "blink_stream.h"
+#include "blink_schema.h"
+#include "blink_arena.h"
+#include "gen_blinkc.h"
+
+#include <malloc.h>
+
+static struct blink_allocator alloc = {
+    .calloc = calloc,
+    .free = free
+};
+
+static uint8_t heap[4096U];
+
+/* interpreter is used as a reference */
+static int setup(void **user)
+{
+    static char input[2048U];
+    static struct blink_stream stream;
+    FILE *f = fopen("tc_blinkc.blink", "rb");
+    size_t size = 0U;
+
+    if(f != NULL){
+
+        size = fread(input, 1U, sizeof(input), f);
+        (void)fclose(f);
+    }
+
+    (void)BLINK_Stream_initBufferReadOnly(&stream, (const uint8_t *)input, (uint32_t)size);
+    *user = (void *)BLINK_Schema_new(&alloc, &stream);
+
+    return (*user != NULL) ? 0 : -1;
+}
+
+static void test_encodeCompact(void **user)
+{
+    uint8_t buffer[100];
+    struct blink_stream output;
+    const uint8_t expected[] = "\x0F\x01\x03""IBM""\x06""ABC123""\x7D\xA8\x0F";
+    struct InsertOrder order = {
+        .Symbol = {.data = (const uint8_t *)"IBM", .len = 3U},
+        .OrderId = {.data = (const uint8_t *)"ABC123", .len = 6U},
+        .Price = 125U,
+        .Quantity = 1000U
+    };
+
+    assert_true(InsertOrder_encodeCompact(&order, BLINK_Stream_initBuffer(&output, buffer, sizeof(buffer))));
+
+    assert_int_equal(sizeof(expected)-1U, BLINK_Stream_tell(&output));
+    assert_memory_equal(expected, buffer, sizeof(expected)-1U);
+}
+
+static void test_encodeCompact_emptyString(void **user)
+{
+    uint8_t buffer[100];
+    struct blink_stream stream;
+    const uint8_t expected[] = "\x06\x01\x00\x00\x7D\xA8\x0F";
+    struct InsertOrder order = {
+        .Price = 125U,
+        .Quantity = 1000U
+    };
+    struct InsertOrder decoded;
+
+    /* unset strings have no data pointer */
+    assert_true(InsertOrder_encodeCompact(&order, BLINK_Stream_initBuffer(&stream, buffer, sizeof(buffer))));
+
+    assert_int_equal(sizeof(expected)-1U, BLINK_Stream_tell(&stream));
+    assert_memory_equal(expected, buffer, sizeof(expected)-1U);
+
+    assert_true(InsertOrder_decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, buffer, sizeof(expected)-1U), &decoded, NULL));
+    assert_int_equal(0U, decoded.Symbol.len);
+    assert_int_equal(0U, decoded.OrderId.len);
+    assert_int_equal(1000U, decoded.Quantity);
+}
+
+static void test_decodeCompact(void **user)
+{
+    const uint8_t input[] = "\x0F\x01\x03""IBM""\x06""ABC123""\x7D\xA8\x0F";
+    struct blink_stream stream;
+    struct InsertOrder order;
+
+    assert_true(InsertOrder_decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, input, sizeof(input)-1U), &order, NULL));
+
+    /* strings are borrowed from the input */
+    assert_ptr_equal(&input[3], order.Symbol.data);
+    assert_int_equal(3U, order.Symbol.len);
+    assert_memory_equal("ABC123", order.OrderId.data, order.OrderId.len);
+    assert_int_equal(125U, order.Price);
+    assert_int_equal(1000U, order.Quantity);
+}
+
+static void test_decodeCompact_wrongGroup(void **user)
+{
+    const uint8_t input[] = "\x05\x03\x01""A""\x01";
+    struct blink_stream stream;
+    struct InsertOrder order;
+
+    assert_false(InsertOrder_decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, input, sizeof(input)-1U), &order, NULL));
+}
+
+static void test_decodeCompact_truncated(void **user)
+{
+    const uint8_t input[] = "\x0F\x01\x03""IBM""\x06""ABC123""\x7D\xA8";
+    struct blink_stream stream;
+    struct InsertOrder order;
+
+    assert_false(InsertOrder_decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, input, sizeof(input)-1U), &order, NULL));
+}
+
+static void test_roundTrip(void **user)
+{
+    blink_schema_t schema = (blink_schema_t)(*user);
+    struct Leg legs[] = {{.Qty = 1U}, {.Qty = 2U, .Venue = {'X', 'Y', 'Z'}, .hasVenue = true}};
+    struct blink_gen_bytes tags[] = {{.data = (const uint8_t *)"a", .len = 1U}, {.data = (const uint8_t *)"bc", .len = 2U}};
+    struct Fill fills[] = {
+        {.Account = {.data = (const uint8_t *)"acc", .len = 3U}, .Qty = 10U},
+        {.Account = {.data = (const uint8_t *)"acc", .len = 3U}, .Qty = 20U}
+    };
+    struct blink_gen_dynamic history[] = {{.id = Fill_ID, .group = &fills[0]}, {.id = Fill_ID, .group = &fills[1]}};
+    struct InsertOrder inner = {
+        .Symbol = {.data = (const uint8_t *)"IBM", .len = 3U},
+        .OrderId = {.data = (const uint8_t *)"ABC123", .len = 6U},
+        .Price = 125U,
+        .Quantity = 1000U
+    };
+    struct Order order = {
+        .Symbol = {.data = (const uint8_t *)"IBM", .len = 3U},
+        .Side = Side_Sell,
+        .Price = 42U,
+        .hasPrice = true,
+        .Px = {.mantissa = -12345, .exponent = -2},
+        .Flag = true,
+        .Leg = {.Qty = 7U},
+        .Legs = {.data = legs, .size = 2U},
+        .Tags = {.data = tags, .size = 2U},
+        .Code = {'A', 'B'},
+        .Last = {.id = Fill_ID, .group = &fills[0]},
+        .hasLast = true,
+        .Any = {.id = InsertOrder_ID, .group = &inner},
+        .hasAny = true,
+        .History = {.data = history, .size = 2U},
+        .Day = -1,
+        .Time = INT64_C(1234567890123)
+    };
+    struct blink_gen_dynamic msg = {.id = Order_ID, .group = &order};
+    uint8_t encoded[200U];
+    uint8_t reencoded[200U];
+    struct blink_stream stream;
+    struct blink_arena arena;
+    struct blink_allocator arenaAlloc = BLINK_Arena_getAllocator(BLINK_Arena_init(&arena, heap, sizeof(heap), NULL));
+    struct blink_gen_dynamic decoded;
+    const struct Order *out;
+    blink_object_t obj;
+    uint32_t size;
+
+    assert_true(gen_blinkc_encodeCompact(&msg, BLINK_Stream_initBuffer(&stream, encoded, sizeof(encoded))));
+    size = BLINK_Stream_tell(&stream);
+
+    /* interpreter encodes the same message identically */
+    obj = BLINK_Object_decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, encoded, size), schema, &alloc);
+    assert_true(obj != NULL);
+    assert_true(BLINK_Object_encodeCompact(obj, BLINK_Stream_initBuffer(&stream, reencoded, sizeof(reencoded))));
+    assert_int_equal(size, BLINK_Stream_tell(&stream));
+    assert_memory_equal(encoded, reencoded, size);
+    BLINK_Object_destroyGroup(&obj);
+
+    assert_true(gen_blinkc_decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, encoded, size), &decoded, &arenaAlloc));
+    assert_int_equal(Order_ID, decoded.id);
+
+    out = (const struct Order *)decoded.group;
+
+    assert_memory_equal("IBM", out->Symbol.data, 3U);
+    assert_int_equal(Side_Sell, out->Side);
+    assert_true(out->hasPrice);
+    assert_int_equal(42U, out->Price);
+    assert_int_equal(-12345, out->Px.mantissa);
+    assert_int_equal(-2, out->Px.exponent);
+    assert_true(out->Flag);
+    assert_int_equal(7U, out->Leg.Qty);
+    assert_false(out->Leg.hasVenue);
+    assert_false(out->hasAlt);
+    assert_int_equal(2U, out->Legs.size);
+    assert_true(out->Legs.data[1].hasVenue);
+    assert_memory_equal("XYZ", out->Legs.data[1].Venue, 3U);
+    assert_false(out->hasFills);
+    assert_int_equal(2U, out->Tags.size);
+    assert_memory_equal("bc", out->Tags.data[1].data, out->Tags.data[1].len);
+    assert_false(out->hasNote);
+    assert_memory_equal("AB", out->Code, 2U);
+    assert_true(out->hasLast);
+    assert_int_equal(Fill_ID, out->Last.id);
+    assert_int_equal(10U, ((const struct Fill *)out->Last.group)->Qty);
+    assert_int_equal(InsertOrder_ID, out->Any.id);
+    assert_int_equal(1000U, ((const struct InsertOrder *)out->Any.group)->Quantity);
+    assert_int_equal(2U, out->History.size);
+    assert_int_equal(20U, ((const struct Fill *)out->History.data[1].group)->Qty);
+    assert_int_equal(-1, out->Day);
+    assert_true(out->Time == INT64_C(1234567890123));
+
+    /* and the generated encoder reproduces the input */
+    assert_true(gen_blinkc_encodeCompact(&decoded, BLINK_Stream_initBuffer(&stream, reencoded, sizeof(reencoded))));
+    assert_int_equal(size, BLINK_Stream_tell(&stream));
+    assert_memory_equal(encoded, reencoded, size);
+}
+
+static void test_decodeCompact_notKindOf(void **user)
+{
+    struct InsertOrder inner = {.Price = 1U, .Quantity = 1U};
+    struct Order order = {
+        .Last = {.id = InsertOrder_ID, .group = &inner},
+        .hasLast = true
+    };
+    uint8_t encoded[100U];
+    struct blink_stream stream;
+    struct blink_arena arena;
+    struct blink_allocator arenaAlloc = BLINK_Arena_getAllocator(BLINK_Arena_init(&arena, heap, sizeof(heap), NULL));
+    struct Order decoded;
+
+    /* the encoder does not check but the decoder does */
+    assert_true(Order_encodeCompact(&order, BLINK_Stream_initBuffer(&stream, encoded, sizeof(encoded))));
+    assert_false(Order_decodeCompact(BLINK_Stream_initBufferReadOnly(&stream, encoded, BLINK_Stream_tell(&stream)), &decoded, &arenaAlloc));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_encodeCompact),
+        cmocka_unit_test(test_encodeCompact_emptyString),
+        cmocka_unit_test(test_decodeCompact),
+        cmocka_unit_test(test_decodeCompact_wrongGroup),
+        cmocka_unit_test(test_decodeCompact_truncated),
+        cmocka_unit_test_setup(test_roundTrip, setup),
+        cmocka_unit_test(test_decodeCompact_notKindOf),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}